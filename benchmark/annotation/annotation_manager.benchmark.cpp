@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// 100,000 markers at random positions, like the points of interest an app loads at startup.
+constexpr uint8_t maxZoom = 20;
+
+std::vector<Annotation> markers() {
+    std::minstd_rand random(7);
+    std::uniform_real_distribution<double> longitude(-180, 180);
+    std::uniform_real_distribution<double> latitude(-80, 80);
+
+    std::vector<Annotation> annotations;
+    for (std::size_t i = 0; i < 100000; ++i) {
+        annotations.push_back(SymbolAnnotation { Point<double> { longitude(random), latitude(random) }, "marker" });
+    }
+    return annotations;
+}
+
+class AnnotationBenchmark {
+public:
+    AnnotationBenchmark() {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+    }
+
+    util::RunLoop loop;
+    DefaultFileSource fileSource { "benchmark/fixtures/api/cache.db", "." };
+    style::Style style { loop, fileSource, 1 };
+    const std::vector<Annotation> annotations = markers();
+};
+
+} // end namespace
+
+static void Annotations_addRemove_each(::benchmark::State& state) {
+    AnnotationBenchmark bench;
+
+    while (state.KeepRunning()) {
+        AnnotationManager manager { bench.style };
+        AnnotationIDs ids;
+        for (const auto& annotation : bench.annotations) {
+            ids.push_back(manager.addAnnotation(annotation, maxZoom));
+        }
+        for (const auto id : ids) {
+            manager.removeAnnotation(id);
+        }
+    }
+
+    state.counters["annotations"] = bench.annotations.size();
+}
+
+static void Annotations_addRemove_batch(::benchmark::State& state) {
+    AnnotationBenchmark bench;
+
+    while (state.KeepRunning()) {
+        AnnotationManager manager { bench.style };
+        manager.removeAnnotations(manager.addAnnotations(bench.annotations, maxZoom));
+    }
+
+    state.counters["annotations"] = bench.annotations.size();
+}
+
+BENCHMARK(Annotations_addRemove_each);
+BENCHMARK(Annotations_addRemove_batch);
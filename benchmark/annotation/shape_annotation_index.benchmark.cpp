@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/annotation/annotation_tile.hpp>
+#include <mbgl/annotation/fill_annotation_impl.hpp>
+#include <mbgl/annotation/shape_annotation_index.hpp>
+#include <mbgl/tile/tile_id.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// 10,000 small squares spread over a 100° × 100° area, like a large set of geofences.
+constexpr uint8_t maxZoom = 16;
+constexpr uint8_t zoom = 4;
+
+std::vector<std::unique_ptr<FillAnnotationImpl>> fillAnnotations() {
+    std::vector<std::unique_ptr<FillAnnotationImpl>> shapes;
+    for (int x = 0; x < 100; ++x) {
+        for (int y = 0; y < 100; ++y) {
+            const double west = -50 + x;
+            const double south = -50 + y;
+            Polygon<double> square { {{ { west, south }, { west + 0.5, south }, { west + 0.5, south + 0.5 },
+                                        { west, south + 0.5 }, { west, south } }} };
+            shapes.push_back(std::make_unique<FillAnnotationImpl>(
+                AnnotationID(shapes.size()), FillAnnotation { square }, maxZoom));
+        }
+    }
+    return shapes;
+}
+
+// Adds all annotations to a new index, and generates the data of every tile at a zoom level.
+void tileAll(::benchmark::State& state, std::size_t groupSize) {
+    const auto shapes = fillAnnotations();
+    const uint32_t tiles = 1 << zoom;
+
+    while (state.KeepRunning()) {
+        ShapeAnnotationIndex index(groupSize);
+        for (const auto& shape : shapes) {
+            index.add(*shape);
+        }
+        for (uint32_t x = 0; x < tiles; ++x) {
+            for (uint32_t y = 0; y < tiles; ++y) {
+                AnnotationTileData data;
+                index.updateTileData(CanonicalTileID(zoom, x, y), data);
+            }
+        }
+    }
+
+    state.counters["annotations"] = shapes.size();
+}
+
+} // end namespace
+
+static void ShapeAnnotations_tile_separate(::benchmark::State& state) {
+    // One index per annotation, which is how shape annotations used to be tiled.
+    tileAll(state, 1);
+}
+
+static void ShapeAnnotations_tile_shared(::benchmark::State& state) {
+    tileAll(state, ShapeAnnotationIndex::defaultGroupSize);
+}
+
+static void ShapeAnnotations_update_shared(::benchmark::State& state) {
+    const auto shapes = fillAnnotations();
+    ShapeAnnotationIndex index;
+    for (const auto& shape : shapes) {
+        index.add(*shape);
+    }
+
+    // Replacing an annotation rebuilds only the index of its group.
+    const CanonicalTileID tileID(zoom, 8, 8);
+    while (state.KeepRunning()) {
+        index.remove(*shapes.front());
+        index.add(*shapes.front());
+        AnnotationTileData data;
+        index.updateTileData(tileID, data);
+    }
+}
+
+BENCHMARK(ShapeAnnotations_tile_separate);
+BENCHMARK(ShapeAnnotations_tile_shared);
+BENCHMARK(ShapeAnnotations_update_shared);
@@ -6,6 +6,8 @@
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/image.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/storage/default_file_source.hpp>
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/util/image.hpp>
@@ -38,6 +40,52 @@ public:
     ScreenBox box{{ 0, 0 }, { 1000, 1000 }};
 };
 
+// A GeoJSON source with a point every degree between 60°S and 60°N, seen at a pitch that
+// covers around 200 of its tiles.
+class SourceQueryBenchmark {
+public:
+    SourceQueryBenchmark() {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+
+        mapbox::geometry::feature_collection<double> points;
+        for (int lat = -60; lat <= 60; ++lat) {
+            for (int lng = -180; lng < 180; ++lng) {
+                mapbox::geometry::feature<double> point { mapbox::geometry::point<double>(lng, lat) };
+                point.id = uint64_t(points.size());
+                points.push_back(std::move(point));
+            }
+        }
+
+        auto source = std::make_unique<style::GeoJSONSource>("points");
+        source->setGeoJSON(points);
+
+        map.getStyle().loadJSON(R"STYLE({ "version": 8, "sources": {}, "layers": [] })STYLE");
+        map.getStyle().addSource(std::move(source));
+        map.getStyle().addLayer(std::make_unique<style::CircleLayer>("points", "points"));
+        map.setLatLngZoom({ 0, 0 }, 5);
+        map.setPitch(60);
+
+        frontend.render(map);
+    }
+
+    util::RunLoop loop;
+    DefaultFileSource fileSource{ "benchmark/fixtures/api/cache.db", "." };
+    ThreadPool threadPool{ 4 };
+    HeadlessFrontend frontend { { 3072, 3072 }, 1, fileSource, threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, fileSource, threadPool, MapMode::Still };
+};
+
+// A grid of points covering the viewport, like the hit tests of one analytics frame.
+std::vector<ScreenCoordinate> gridPoints() {
+    std::vector<ScreenCoordinate> points;
+    for (double y = 10; y < 1000; y += 20) {
+        for (double x = 10; x < 1000; x += 20) {
+            points.push_back({ x, y });
+        }
+    }
+    return points;
+}
+
 } // end namespace
 
 static void API_queryRenderedFeaturesAll(::benchmark::State& state) {
@@ -48,6 +96,35 @@ static void API_queryRenderedFeaturesAll(::benchmark::State& state) {
     }
 }
 
+static void API_queryRenderedFeaturesAll_parallel(::benchmark::State& state) {
+    QueryBenchmark bench;
+    bench.frontend.getRenderer()->setParallelFeatureQueries(true);
+
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->queryRenderedFeatures(bench.box, {});
+    }
+}
+
+static void API_queryRenderedFeaturesAll_ids(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        for (const auto& feature : bench.frontend.getRenderer()->queryRenderedFeatures(bench.box, {})) {
+            benchmark::DoNotOptimize(feature.id);
+        }
+    }
+}
+
+static void API_queryRenderedFeatureHandlesAll_ids(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        for (const auto& feature : bench.frontend.getRenderer()->queryRenderedFeatureHandles(bench.box, {})) {
+            benchmark::DoNotOptimize(feature.getID());
+        }
+    }
+}
+
 static void API_queryRenderedFeaturesLayerFromLowDensity(::benchmark::State& state) {
     QueryBenchmark bench;
 
@@ -64,6 +141,70 @@ static void API_queryRenderedFeaturesLayerFromHighDensity(::benchmark::State& st
     }
 }
 
+static void API_queryRenderedFeaturesHover(::benchmark::State& state) {
+    QueryBenchmark bench;
+    const ScreenCoordinate point { 500, 500 };
+
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->queryRenderedFeatures(point, {});
+    }
+}
+
+static void API_queryRenderedFeaturesPoints(::benchmark::State& state) {
+    QueryBenchmark bench;
+    const std::vector<ScreenCoordinate> points = gridPoints();
+
+    while (state.KeepRunning()) {
+        for (const auto& point : points) {
+            bench.frontend.getRenderer()->queryRenderedFeatures(point, {});
+        }
+    }
+
+    state.counters["points"] = points.size();
+}
+
+static void API_queryRenderedFeaturesPoints_batch(::benchmark::State& state) {
+    QueryBenchmark bench;
+    const std::vector<ScreenCoordinate> points = gridPoints();
+
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->queryRenderedFeaturesBatch(points, {});
+    }
+
+    state.counters["points"] = points.size();
+}
+
+static void API_querySourceFeatures(::benchmark::State& state) {
+    SourceQueryBenchmark bench;
+
+    std::size_t features = 0;
+    while (state.KeepRunning()) {
+        features = bench.frontend.getRenderer()->querySourceFeatures("points").size();
+    }
+
+    state.counters["features"] = features;
+}
+
+static void API_querySourceFeatures_bounds(::benchmark::State& state) {
+    SourceQueryBenchmark bench;
+    const SourceQueryOptions options { {}, {}, LatLngBounds::hull({ -5, -5 }, { 5, 5 }) };
+
+    std::size_t features = 0;
+    while (state.KeepRunning()) {
+        features = bench.frontend.getRenderer()->querySourceFeatures("points", options).size();
+    }
+
+    state.counters["features"] = features;
+}
+
 BENCHMARK(API_queryRenderedFeaturesAll);
+BENCHMARK(API_queryRenderedFeaturesAll_parallel);
+BENCHMARK(API_queryRenderedFeaturesAll_ids);
+BENCHMARK(API_queryRenderedFeatureHandlesAll_ids);
 BENCHMARK(API_queryRenderedFeaturesLayerFromLowDensity);
 BENCHMARK(API_queryRenderedFeaturesLayerFromHighDensity);
+BENCHMARK(API_queryRenderedFeaturesHover);
+BENCHMARK(API_queryRenderedFeaturesPoints);
+BENCHMARK(API_queryRenderedFeaturesPoints_batch);
+BENCHMARK(API_querySourceFeatures);
+BENCHMARK(API_querySourceFeatures_bounds);
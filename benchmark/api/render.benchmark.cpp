@@ -73,6 +73,31 @@ static void API_renderStill_recreate_map(::benchmark::State& state) {
     }
 }
 
+static void renderPitched(::benchmark::State& state, bool parallelLineLabels) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Still };
+    prepare(map);
+    // Street labels follow lines, and have to be projected again for every frame.
+    map.setBearing(30);
+    map.setPitch(60);
+    frontend.getRenderer()->setParallelLineLabels(parallelLineLabels);
+
+    while (state.KeepRunning()) {
+        frontend.render(map);
+    }
+}
+
+static void API_renderStill_pitched_line_labels(::benchmark::State& state) {
+    renderPitched(state, false);
+}
+
+static void API_renderStill_pitched_line_labels_parallel(::benchmark::State& state) {
+    renderPitched(state, true);
+}
+
 BENCHMARK(API_renderStill_reuse_map);
 BENCHMARK(API_renderStill_reuse_map_switch_styles);
 BENCHMARK(API_renderStill_recreate_map);
+BENCHMARK(API_renderStill_pitched_line_labels);
+BENCHMARK(API_renderStill_pitched_line_labels_parallel);
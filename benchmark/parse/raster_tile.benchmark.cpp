@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/allocation_counter.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/shared_buffer.hpp>
+
+#include <memory>
+
+using namespace mbgl;
+
+// Decodes a raster tile from a response buffer and reports the heap allocations made for each
+// tile. The image decoders allocate their own state with malloc(), which is not counted, so the
+// difference in allocated bytes between the two benchmarks is the copy of the response data.
+template <class Decode>
+static void decodeRasterTile(::benchmark::State& state, Decode decode) {
+    const SharedBuffer data = std::make_shared<const std::string>(util::read_file("test/fixtures/resources/raster.tile"));
+
+    Allocations allocations;
+    while (state.KeepRunning()) {
+        AllocationCounter counter;
+        PremultipliedImage image = decode(data);
+        allocations += counter.get();
+        benchmark::DoNotOptimize(image.data.get());
+    }
+
+    state.counters["tileBytes"] = data.size();
+    state.counters["allocationsPerTile"] = double(allocations.count) / state.iterations();
+    state.counters["allocatedBytesPerTile"] = double(allocations.bytes) / state.iterations();
+}
+
+// Copies the response data into a string for the decoder, as RasterTileWorker used to.
+static void Parse_RasterTileCopy(::benchmark::State& state) {
+    decodeRasterTile(state, [] (const SharedBuffer& data) {
+        return decodeImage(data.string());
+    });
+}
+
+static void Parse_RasterTile(::benchmark::State& state) {
+    decodeRasterTile(state, [] (const SharedBuffer& data) {
+        return decodeImage(data.data(), data.size());
+    });
+}
+
+BENCHMARK(Parse_RasterTileCopy);
+BENCHMARK(Parse_RasterTile);
@@ -0,0 +1,43 @@
+#include <mbgl/benchmark/allocation_counter.hpp>
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local mbgl::Allocations* current = nullptr;
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (current) {
+        current->count++;
+        current->bytes += size;
+    }
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace mbgl {
+
+AllocationCounter::AllocationCounter() {
+    assert(!current);
+    current = &allocations;
+}
+
+AllocationCounter::~AllocationCounter() {
+    current = nullptr;
+}
+
+} // namespace mbgl
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstddef>
+
+namespace mbgl {
+
+struct Allocations {
+    std::size_t count = 0;
+    std::size_t bytes = 0;
+
+    Allocations& operator+=(const Allocations& other) {
+        count += other.count;
+        bytes += other.bytes;
+        return *this;
+    }
+};
+
+// Counts the heap allocations made with operator new on the current thread for as long as the
+// counter is alive. Memory that libraries allocate with malloc() isn't counted. Counters can't be
+// nested.
+class AllocationCounter : private util::noncopyable {
+public:
+    AllocationCounter();
+    ~AllocationCounter();
+
+    Allocations get() const { return allocations; }
+
+private:
+    Allocations allocations;
+};
+
+} // namespace mbgl
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/bidi_cache.hpp>
+#include <mbgl/util/utf.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Lays out the labels of a tile and of its 16 overzoomed children, like the shaping benchmark.
+constexpr std::size_t tileCount = 17;
+
+// Street and place names of a tile in a city with Arabic and Hebrew labels.
+std::vector<std::u16string> tileLabels() {
+    const std::vector<std::string> names {
+        "شارع الملك فيصل", "شارع الجمهورية", "ميدان التحرير", "شارع قصر النيل", "كورنيش النيل",
+        "جامعة القاهرة", "شارع الهرم", "مسجد الأزهر", "حديقة الأزبكية", "شارع طلعت حرب",
+        "רחוב הרצל", "שדרות רוטשילד", "רחוב דיזנגוף", "כיכר רבין", "רחוב אלנבי",
+        "נמל יפו", "שוק הכרמל", "רחוב בן יהודה", "Main St / רחוב הרצל", "King Faisal St شارع الملك فيصل"
+    };
+
+    std::vector<std::u16string> labels;
+    for (const auto& name : names) {
+        labels.push_back(util::utf8_to_utf16::convert(name));
+    }
+    return labels;
+}
+
+} // end namespace
+
+static void BiDi_Uncached(::benchmark::State& state) {
+    const std::vector<std::u16string> labels = tileLabels();
+    BiDi bidi;
+
+    while (state.KeepRunning()) {
+        for (std::size_t tile = 0; tile < tileCount; ++tile) {
+            for (const auto& label : labels) {
+                const std::u16string text = applyArabicShaping(label);
+                std::vector<std::u16string> lines = bidi.processText(text, { text.size() / 2 });
+                benchmark::DoNotOptimize(lines.data());
+            }
+        }
+    }
+
+    state.counters["labels"] = labels.size() * tileCount;
+}
+
+static void BiDi_Cached(::benchmark::State& state) {
+    const std::vector<std::u16string> labels = tileLabels();
+    BiDi bidi;
+
+    BiDiCache::Stats stats;
+    while (state.KeepRunning()) {
+        BiDiCache cache;
+        for (std::size_t tile = 0; tile < tileCount; ++tile) {
+            for (const auto& label : labels) {
+                const std::u16string text = cache.applyArabicShaping(label);
+                std::vector<std::u16string> lines = cache.processText(bidi, text, { text.size() / 2 });
+                benchmark::DoNotOptimize(lines.data());
+            }
+        }
+        stats = cache.getStats();
+    }
+
+    state.counters["labels"] = labels.size() * tileCount;
+    state.counters["hitRate"] = stats.hitRate();
+}
+
+BENCHMARK(BiDi_Uncached);
+BENCHMARK(BiDi_Cached);
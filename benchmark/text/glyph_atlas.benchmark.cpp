@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/text/glyph_pbf.hpp>
+#include <mbgl/text/shared_glyph_atlas.hpp>
+#include <mbgl/renderer/backend_scope.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// Simulates a viewport's worth of tiles, each of which uses a random selection of the printable
+// ASCII glyphs, much like the labels of a typical street map do.
+std::vector<GlyphMap> tileGlyphMaps() {
+    const FontStack fontStack { "Open Sans Regular" };
+    std::vector<Glyph> glyphs = parseGlyphPBF(
+        GlyphRange { 0, 255 }, util::read_file("test/fixtures/resources/glyphs.pbf"));
+
+    std::vector<Immutable<Glyph>> printable;
+    for (auto& glyph : glyphs) {
+        if (glyph.id >= 32 && glyph.id < 127) {
+            printable.push_back(makeMutable<Glyph>(std::move(glyph)));
+        }
+    }
+
+    std::minstd_rand random(42);
+    std::uniform_int_distribution<std::size_t> pick(0, printable.size() - 1);
+
+    std::vector<GlyphMap> tiles(32);
+    for (auto& tile : tiles) {
+        for (int i = 0; i < 60; ++i) {
+            const Immutable<Glyph>& glyph = printable[pick(random)];
+            tile[fontStack].emplace(glyph->id, glyph);
+        }
+    }
+    return tiles;
+}
+
+} // end namespace
+
+static void GlyphAtlas_PerTile(::benchmark::State& state) {
+    const std::vector<GlyphMap> tiles = tileGlyphMaps();
+
+    std::size_t bytes = 0;
+    while (state.KeepRunning()) {
+        bytes = 0;
+        for (const auto& tile : tiles) {
+            GlyphAtlas atlas = makeGlyphAtlas(tile);
+            bytes += atlas.image.bytes();
+            benchmark::DoNotOptimize(atlas.image.data.get());
+        }
+    }
+
+    // Every tile keeps and uploads an atlas of its own.
+    state.counters["memoryBytes"] = bytes;
+    state.counters["uploadedBytes"] = bytes;
+}
+
+static void GlyphAtlas_Shared(::benchmark::State& state) {
+    const std::vector<GlyphMap> tiles = tileGlyphMaps();
+
+    HeadlessBackend backend { { 256, 256 } };
+    BackendScope scope { backend };
+    gl::Context context;
+
+    SharedGlyphAtlas::Stats stats;
+    while (state.KeepRunning()) {
+        auto atlas = std::make_shared<SharedGlyphAtlas>();
+        std::vector<std::unique_ptr<SharedGlyphAtlas::Reference>> references;
+        for (const auto& tile : tiles) {
+            GlyphPositions positions;
+            references.push_back(atlas->addGlyphs(tile, positions));
+            // Tiles typically finish loading in different frames.
+            atlas->upload(context, 0);
+        }
+        stats = atlas->getStats();
+    }
+
+    state.counters["memoryBytes"] = stats.memoryBytes;
+    state.counters["uploadedBytes"] = stats.uploadedBytes;
+}
+
+BENCHMARK(GlyphAtlas_PerTile);
+BENCHMARK(GlyphAtlas_Shared);
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/storage/file_source.hpp>
+#include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/timer.hpp>
+
+using namespace mbgl;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Time for a request to go over the network and back.
+constexpr Duration roundTrip = 20ms;
+
+class DelayedResponse : public AsyncRequest {
+public:
+    DelayedResponse(Response response, FileSource::Callback callback) {
+        timer.start(roundTrip, Duration::zero(), [response, callback] {
+            callback(response);
+        });
+    }
+
+private:
+    util::Timer timer;
+};
+
+// Answers every request with the same glyph range, one round trip later.
+class LatencyFileSource : public FileSource {
+public:
+    LatencyFileSource() {
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+    }
+
+    std::unique_ptr<AsyncRequest> request(const Resource&, Callback callback) override {
+        return std::make_unique<DelayedResponse>(response, callback);
+    }
+
+    Response response;
+};
+
+class FirstLabel : public GlyphRequestor {
+public:
+    FirstLabel(util::RunLoop& loop_) : loop(loop_) {}
+
+    void onGlyphsAvailable(GlyphMap) override {
+        loop.stop();
+    }
+
+    util::RunLoop& loop;
+};
+
+// Measures the time from loading the style until the glyphs of the first label are available.
+// The first tile arrives one round trip after the style has been loaded, and only requests its
+// glyphs after that, unless they have been warmed up along with the tile request.
+void timeToFirstLabel(::benchmark::State& state, bool warmup) {
+    util::RunLoop loop;
+    LatencyFileSource fileSource;
+    ThreadPool threadPool { 1 };
+    const FontStack fontStack { "Open Sans Regular", "Arial Unicode MS Regular" };
+
+    while (state.KeepRunning()) {
+        GlyphManager glyphManager { fileSource, threadPool };
+        glyphManager.setURL("mapbox://fonts/{fontstack}/{range}.pbf");
+        FirstLabel label { loop };
+
+        if (warmup) {
+            glyphManager.prefetchGlyphs({ { fontStack, { { 0, 255 } } } });
+        }
+
+        util::Timer tile;
+        tile.start(roundTrip, Duration::zero(), [&] {
+            glyphManager.getGlyphs(label, { { fontStack, { u'a', u'å', u' ' } } });
+        });
+
+        loop.run();
+    }
+}
+
+} // end namespace
+
+static void GlyphWarmup_Disabled(::benchmark::State& state) {
+    timeToFirstLabel(state, false);
+}
+
+static void GlyphWarmup_Enabled(::benchmark::State& state) {
+    timeToFirstLabel(state, true);
+}
+
+BENCHMARK(GlyphWarmup_Disabled)->UseRealTime();
+BENCHMARK(GlyphWarmup_Enabled)->UseRealTime();
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Collision features for the labels of a dense street map tile: every named feature gets a
+// point label at the start of its geometry, sized like 16px text at zoom level 10.
+std::vector<CollisionFeature> tileFeatures() {
+    VectorTileData tile(std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+
+    const float tilePixelRatio = util::EXTENT / util::tileSize;
+    const float charWidth = 9 * tilePixelRatio;
+    const float lineHeight = 19 * tilePixelRatio;
+
+    std::vector<CollisionFeature> features;
+    for (const auto& layerName : tile.layerNames()) {
+        auto layer = tile.getLayer(layerName);
+        for (std::size_t i = 0; layer && i < layer->featureCount(); i++) {
+            auto feature = layer->getFeature(i);
+            auto name = feature->getValue("name");
+            const GeometryCollection geometries = feature->getGeometries();
+            if (!name || !name->is<std::string>() || geometries.empty() || geometries[0].empty()) {
+                continue;
+            }
+
+            const GeometryCoordinate point = geometries[0][0];
+            const float halfWidth = name->get<std::string>().size() * charWidth / 2;
+            features.emplace_back(GeometryCoordinates(), Anchor(point.x, point.y, 0, 0.5f),
+                                  -lineHeight / 2, lineHeight / 2, -halfWidth, halfWidth, 1, 0,
+                                  style::SymbolPlacementType::Point,
+                                  IndexedSubfeature { i, layerName, layerName, features.size() },
+                                  CollisionFeature::AlignmentType::Straight);
+        }
+    }
+    return features;
+}
+
+void place(::benchmark::State& state, CollisionIndexType type) {
+    std::vector<CollisionFeature> features = tileFeatures();
+
+    std::size_t placed = 0;
+    while (state.KeepRunning()) {
+        // Rotating the map places all labels again with a new collision tile.
+        CollisionTile collisionTile(PlacementConfig(0.3f, 0, 0, 0, false, type));
+        placed = 0;
+        for (auto& feature : features) {
+            const float scale = collisionTile.placeFeature(feature, false, false);
+            collisionTile.insertFeature(feature, scale, false);
+            if (scale < collisionTile.maxScale) {
+                placed++;
+            }
+        }
+    }
+
+    state.counters["labels"] = features.size();
+    state.counters["placed"] = placed;
+}
+
+} // end namespace
+
+static void Placement_RTree(::benchmark::State& state) {
+    place(state, CollisionIndexType::RTree);
+}
+
+static void Placement_Grid(::benchmark::State& state) {
+    place(state, CollisionIndexType::Grid);
+}
+
+BENCHMARK(Placement_RTree);
+BENCHMARK(Placement_Grid);
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/glyph_pbf.hpp>
+#include <mbgl/text/shaping.hpp>
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/utf.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Lays out the labels of a street map tile and of its 16 overzoomed children, the way
+// SymbolLayout::prepare does when zooming past the maximum zoom level of the source.
+constexpr std::size_t tileCount = 17;
+constexpr float oneEm = 24.0f;
+
+std::vector<std::u16string> tileLabels() {
+    VectorTileData tile(std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+
+    std::vector<std::u16string> labels;
+    for (const auto& name : tile.layerNames()) {
+        if (auto layer = tile.getLayer(name)) {
+            for (std::size_t i = 0; i < layer->featureCount(); i++) {
+                auto value = layer->getFeature(i)->getValue("name");
+                if (value && value->is<std::string>()) {
+                    labels.push_back(applyArabicShaping(
+                        util::utf8_to_utf16::convert(value->get<std::string>())));
+                }
+            }
+        }
+    }
+    return labels;
+}
+
+Glyphs tileGlyphs() {
+    Glyphs glyphs;
+    for (auto& glyph : parseGlyphPBF(GlyphRange { 0, 255 },
+                                     util::read_file("test/fixtures/resources/glyphs.pbf"))) {
+        const GlyphID id = glyph.id;
+        glyphs.emplace(id, Immutable<Glyph>(makeMutable<Glyph>(std::move(glyph))));
+    }
+    return glyphs;
+}
+
+ShapingCache::Key makeKey(const std::u16string& text) {
+    return ShapingCache::Key {
+        text,
+        { "Open Sans Regular" },
+        10 * oneEm,
+        1.2f * oneEm,
+        style::SymbolAnchorType::Center,
+        style::TextJustifyType::Center,
+        0.0f,
+        { 0.0f, 0.0f },
+        oneEm,
+        WritingModeType::Horizontal
+    };
+}
+
+} // end namespace
+
+static void Shaping_Uncached(::benchmark::State& state) {
+    const std::vector<std::u16string> labels = tileLabels();
+    const Glyphs glyphs = tileGlyphs();
+    BiDi bidi;
+
+    while (state.KeepRunning()) {
+        for (std::size_t tile = 0; tile < tileCount; ++tile) {
+            for (const auto& label : labels) {
+                const ShapingCache::Key key = makeKey(label);
+                Shaping shaping = getShaping(key.text, key.maxWidth, key.lineHeight, key.textAnchor,
+                                             key.textJustify, key.spacing, key.translate,
+                                             key.verticalHeight, key.writingMode, bidi, glyphs);
+                benchmark::DoNotOptimize(shaping.positionedGlyphs.data());
+            }
+        }
+    }
+
+    state.counters["labels"] = labels.size() * tileCount;
+}
+
+static void Shaping_Cached(::benchmark::State& state) {
+    const std::vector<std::u16string> labels = tileLabels();
+    const Glyphs glyphs = tileGlyphs();
+    BiDi bidi;
+
+    ShapingCache::Stats stats;
+    while (state.KeepRunning()) {
+        ShapingCache cache;
+        for (std::size_t tile = 0; tile < tileCount; ++tile) {
+            for (const auto& label : labels) {
+                Shaping shaping = cache.getShaping(makeKey(label), bidi, glyphs);
+                benchmark::DoNotOptimize(shaping.positionedGlyphs.data());
+            }
+        }
+        stats = cache.getStats();
+    }
+
+    state.counters["labels"] = labels.size() * tileCount;
+    state.counters["hitRate"] = stats.hitRate();
+}
+
+BENCHMARK(Shaping_Uncached);
+BENCHMARK(Shaping_Cached);
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/layout/symbol_projection.hpp>
+#include <mbgl/map/transform.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// The anchors of the line labels of a dense tile, seen at a pitch of 60°.
+constexpr std::size_t anchorCount = 4096;
+
+struct Anchors {
+    Anchors() {
+        std::minstd_rand random(7);
+        std::uniform_real_distribution<float> position(0, util::EXTENT);
+        for (std::size_t i = 0; i < anchorCount; ++i) {
+            x.push_back(position(random));
+            y.push_back(position(random));
+        }
+
+        Transform transform;
+        transform.resize({ 1000, 1000 });
+        transform.setLatLngZoom({ 40.726989, -73.992857 }, 15);
+        transform.setAngle(30 * util::DEG2RAD);
+        transform.setPitch(60 * util::DEG2RAD);
+        const TransformState& state = transform.getState();
+
+        mat4 projMatrix;
+        state.getProjMatrix(projMatrix);
+        state.matrixFor(matrix, UnwrappedTileID(15, 9649, 12315));
+        matrix::multiply(matrix, projMatrix, matrix);
+    }
+
+    std::vector<float> x;
+    std::vector<float> y;
+    mat4 matrix;
+};
+
+} // end namespace
+
+static void SymbolProjection_Scalar(::benchmark::State& state) {
+    const Anchors anchors;
+    std::vector<float> projectedX(anchorCount), projectedY(anchorCount), cameraDistance(anchorCount);
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < anchorCount; ++i) {
+            vec4 pos = {{ anchors.x[i], anchors.y[i], 0, 1 }};
+            matrix::transformMat4(pos, pos, anchors.matrix);
+            projectedX[i] = pos[0] / pos[3];
+            projectedY[i] = pos[1] / pos[3];
+            cameraDistance[i] = pos[3];
+        }
+        benchmark::DoNotOptimize(projectedX.data());
+        benchmark::DoNotOptimize(projectedY.data());
+        benchmark::DoNotOptimize(cameraDistance.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * anchorCount);
+}
+
+static void SymbolProjection_Batch(::benchmark::State& state) {
+    const Anchors anchors;
+    std::vector<float> projectedX(anchorCount), projectedY(anchorCount), cameraDistance(anchorCount);
+
+    while (state.KeepRunning()) {
+        projectPoints(anchors.matrix, anchorCount, anchors.x.data(), anchors.y.data(),
+                      projectedX.data(), projectedY.data(), cameraDistance.data());
+        benchmark::DoNotOptimize(projectedX.data());
+        benchmark::DoNotOptimize(projectedY.data());
+        benchmark::DoNotOptimize(cameraDistance.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * anchorCount);
+}
+
+BENCHMARK(SymbolProjection_Scalar);
+BENCHMARK(SymbolProjection_Batch);
@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/allocation_counter.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <memory>
+
+using namespace mbgl;
+
+static void Util_decompress(::benchmark::State& state) {
+    const std::string compressed =
+        util::compress(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+
+    while (state.KeepRunning()) {
+        const std::string data = util::decompress(compressed.data(), compressed.size());
+        benchmark::DoNotOptimize(data.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * compressed.size());
+}
+
+// Loads a compressed tile into a response buffer, the way the offline database and tile
+// archives do, and reports the heap allocations made for each tile. zlib allocates its own
+// state with malloc(), which is not counted.
+static void Util_decompressTileLoad(::benchmark::State& state) {
+    const std::string compressed =
+        util::compress(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+
+    std::size_t tileBytes = 0;
+    Allocations allocations;
+    while (state.KeepRunning()) {
+        AllocationCounter counter;
+        auto data = std::make_shared<const std::string>(util::decompress(compressed.data(), compressed.size()));
+        allocations += counter.get();
+        tileBytes = data->size();
+        benchmark::DoNotOptimize(data->data());
+    }
+
+    state.counters["tileBytes"] = tileBytes;
+    state.counters["allocationsPerTile"] = double(allocations.count) / state.iterations();
+    state.counters["allocatedBytesPerTile"] = double(allocations.bytes) / state.iterations();
+}
+
+BENCHMARK(Util_decompress);
+BENCHMARK(Util_decompressTileLoad);
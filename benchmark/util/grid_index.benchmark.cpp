@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/grid_index.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+using BBox = GridIndex<IndexedSubfeature>::BBox;
+
+// A tile's feature index, with the grid size that FeatureIndex uses, holding 5000 small features.
+GridIndex<IndexedSubfeature> makeGrid() {
+    GridIndex<IndexedSubfeature> grid(util::EXTENT, 16, 0);
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int16_t> position(0, util::EXTENT - 200);
+    std::uniform_int_distribution<int16_t> size(1, 200);
+    for (std::size_t i = 0; i < 5000; ++i) {
+        const int16_t x = position(generator);
+        const int16_t y = position(generator);
+        grid.insert(IndexedSubfeature { i, "layer", "bucket", i },
+                    { { x, y }, { int16_t(x + size(generator)), int16_t(y + size(generator)) } });
+    }
+    grid.finish();
+    return grid;
+}
+
+} // end namespace
+
+static void GridIndex_insert(::benchmark::State& state) {
+    while (state.KeepRunning()) {
+        GridIndex<IndexedSubfeature> grid = makeGrid();
+        benchmark::DoNotOptimize(grid.size());
+    }
+}
+
+// A query the size of a mouse cursor, as used for hover effects.
+static void GridIndex_queryHover(::benchmark::State& state) {
+    const GridIndex<IndexedSubfeature> grid = makeGrid();
+
+    std::size_t hits = 0;
+    int16_t offset = 0;
+    while (state.KeepRunning()) {
+        offset = (offset + 331) % (util::EXTENT - 64);
+        grid.query({ { offset, offset }, { int16_t(offset + 64), int16_t(offset + 64) } },
+                   [&] (const IndexedSubfeature&) {
+            ++hits;
+            return true;
+        });
+    }
+
+    benchmark::DoNotOptimize(hits);
+}
+
+BENCHMARK(GridIndex_insert);
+BENCHMARK(GridIndex_queryHover);
@@ -1,6 +1,10 @@
 # Do not edit. Regenerate this with ./scripts/generate-benchmark-files.sh
 
 set(MBGL_BENCHMARK_FILES
+    # annotation
+    benchmark/annotation/annotation_manager.benchmark.cpp
+    benchmark/annotation/shape_annotation_index.benchmark.cpp
+
     # api
     benchmark/api/query.benchmark.cpp
     benchmark/api/render.benchmark.cpp
@@ -15,6 +19,7 @@ set(MBGL_BENCHMARK_FILES
 
     # parse
     benchmark/parse/filter.benchmark.cpp
+    benchmark/parse/raster_tile.benchmark.cpp
     benchmark/parse/tile_mask.benchmark.cpp
     benchmark/parse/vector_tile.benchmark.cpp
 
@@ -22,9 +27,21 @@ set(MBGL_BENCHMARK_FILES
     benchmark/src/main.cpp
 
     # src/mbgl/benchmark
+    benchmark/src/mbgl/benchmark/allocation_counter.cpp
+    benchmark/src/mbgl/benchmark/allocation_counter.hpp
     benchmark/src/mbgl/benchmark/benchmark.cpp
     benchmark/src/mbgl/benchmark/stub_geometry_tile_feature.hpp
 
+    # text
+    benchmark/text/bidi.benchmark.cpp
+    benchmark/text/glyph_atlas.benchmark.cpp
+    benchmark/text/glyph_warmup.benchmark.cpp
+    benchmark/text/placement.benchmark.cpp
+    benchmark/text/shaping.benchmark.cpp
+    benchmark/text/symbol_projection.benchmark.cpp
+
     # util
+    benchmark/util/compression.benchmark.cpp
     benchmark/util/dtoa.benchmark.cpp
+    benchmark/util/grid_index.benchmark.cpp
 )
@@ -34,6 +34,8 @@ set(MBGL_CORE_FILES
     src/mbgl/annotation/render_annotation_source.hpp
     src/mbgl/annotation/shape_annotation_impl.cpp
     src/mbgl/annotation/shape_annotation_impl.hpp
+    src/mbgl/annotation/shape_annotation_index.cpp
+    src/mbgl/annotation/shape_annotation_index.hpp
     src/mbgl/annotation/symbol_annotation_impl.cpp
     src/mbgl/annotation/symbol_annotation_impl.hpp
 
@@ -157,6 +159,7 @@ set(MBGL_CORE_FILES
     # renderer
     include/mbgl/renderer/backend_scope.hpp
     include/mbgl/renderer/mode.hpp
+    include/mbgl/renderer/queried_feature.hpp
     include/mbgl/renderer/query.hpp
     include/mbgl/renderer/renderer.hpp
     include/mbgl/renderer/renderer_backend.hpp
@@ -183,6 +186,8 @@ set(MBGL_CORE_FILES
     src/mbgl/renderer/possibly_evaluated_property_value.hpp
     src/mbgl/renderer/property_evaluation_parameters.hpp
     src/mbgl/renderer/property_evaluator.hpp
+    src/mbgl/renderer/queried_feature.cpp
+    src/mbgl/renderer/query_batch.hpp
     src/mbgl/renderer/render_layer.cpp
     src/mbgl/renderer/render_layer.hpp
     src/mbgl/renderer/render_light.cpp
@@ -200,6 +205,10 @@ set(MBGL_CORE_FILES
     src/mbgl/renderer/renderer_impl.cpp
     src/mbgl/renderer/renderer_impl.hpp
     src/mbgl/renderer/renderer_observer.hpp
+    src/mbgl/renderer/shared_image_atlas.cpp
+    src/mbgl/renderer/shared_image_atlas.hpp
+    src/mbgl/renderer/shelf_atlas.cpp
+    src/mbgl/renderer/shelf_atlas.hpp
     src/mbgl/renderer/style_diff.cpp
     src/mbgl/renderer/style_diff.hpp
     src/mbgl/renderer/tile_mask.hpp
@@ -244,6 +253,8 @@ set(MBGL_CORE_FILES
     src/mbgl/renderer/layers/render_symbol_layer.hpp
 
     # renderer/sources
+    src/mbgl/renderer/sources/geojson_source_worker.cpp
+    src/mbgl/renderer/sources/geojson_source_worker.hpp
     src/mbgl/renderer/sources/render_geojson_source.cpp
     src/mbgl/renderer/sources/render_geojson_source.hpp
     src/mbgl/renderer/sources/render_image_source.cpp
@@ -303,12 +314,15 @@ set(MBGL_CORE_FILES
     # storage
     include/mbgl/storage/default_file_source.hpp
     include/mbgl/storage/file_source.hpp
+    include/mbgl/storage/http_connection_mode.hpp
     include/mbgl/storage/network_status.hpp
     include/mbgl/storage/offline.hpp
     include/mbgl/storage/online_file_source.hpp
     include/mbgl/storage/resource.hpp
     include/mbgl/storage/resource_transform.hpp
     include/mbgl/storage/response.hpp
+    src/mbgl/storage/adaptive_concurrency.cpp
+    src/mbgl/storage/adaptive_concurrency.hpp
     src/mbgl/storage/asset_file_source.hpp
     src/mbgl/storage/http_file_source.hpp
     src/mbgl/storage/local_file_source.hpp
@@ -474,10 +488,14 @@ set(MBGL_CORE_FILES
 
     # text
     src/mbgl/text/bidi.hpp
+    src/mbgl/text/bidi_cache.cpp
+    src/mbgl/text/bidi_cache.hpp
     src/mbgl/text/check_max_angle.cpp
     src/mbgl/text/check_max_angle.hpp
     src/mbgl/text/collision_feature.cpp
     src/mbgl/text/collision_feature.hpp
+    src/mbgl/text/collision_grid.cpp
+    src/mbgl/text/collision_grid.hpp
     src/mbgl/text/collision_tile.cpp
     src/mbgl/text/collision_tile.hpp
     src/mbgl/text/get_anchors.cpp
@@ -489,14 +507,23 @@ set(MBGL_CORE_FILES
     src/mbgl/text/glyph_manager.cpp
     src/mbgl/text/glyph_manager.hpp
     src/mbgl/text/glyph_manager_observer.hpp
+    src/mbgl/text/glyph_manager_worker.cpp
+    src/mbgl/text/glyph_manager_worker.hpp
     src/mbgl/text/glyph_pbf.cpp
     src/mbgl/text/glyph_pbf.hpp
     src/mbgl/text/glyph_range.hpp
+    src/mbgl/text/local_glyph_rasterizer.hpp
     src/mbgl/text/placement_config.hpp
     src/mbgl/text/quads.cpp
     src/mbgl/text/quads.hpp
     src/mbgl/text/shaping.cpp
     src/mbgl/text/shaping.hpp
+    src/mbgl/text/shaping_cache.cpp
+    src/mbgl/text/shaping_cache.hpp
+    src/mbgl/text/shared_glyph_atlas.cpp
+    src/mbgl/text/shared_glyph_atlas.hpp
+    src/mbgl/text/tiny_sdf.cpp
+    src/mbgl/text/tiny_sdf.hpp
 
     # tile
     include/mbgl/tile/tile_id.hpp
@@ -559,6 +586,7 @@ set(MBGL_CORE_FILES
     include/mbgl/util/projection.hpp
     include/mbgl/util/range.hpp
     include/mbgl/util/run_loop.hpp
+    include/mbgl/util/shared_buffer.hpp
     include/mbgl/util/size.hpp
     include/mbgl/util/string.hpp
     include/mbgl/util/thread.hpp
@@ -600,6 +628,7 @@ set(MBGL_CORE_FILES
     src/mbgl/util/io.hpp
     src/mbgl/util/logging.cpp
     src/mbgl/util/longest_common_subsequence.hpp
+    src/mbgl/util/lru_cache.hpp
     src/mbgl/util/mapbox.cpp
     src/mbgl/util/mapbox.hpp
     src/mbgl/util/mat2.cpp
@@ -611,6 +640,8 @@ set(MBGL_CORE_FILES
     src/mbgl/util/math.hpp
     src/mbgl/util/offscreen_texture.cpp
     src/mbgl/util/offscreen_texture.hpp
+    src/mbgl/util/parallel.cpp
+    src/mbgl/util/parallel.hpp
     src/mbgl/util/premultiply.cpp
     src/mbgl/util/rapidjson.hpp
     src/mbgl/util/rect.hpp
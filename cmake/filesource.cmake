@@ -11,6 +11,10 @@ add_library(mbgl-filesource STATIC
     platform/default/asset_file_source.cpp
     src/mbgl/storage/local_file_source.hpp
     platform/default/local_file_source.cpp
+    src/mbgl/storage/tile_archive_file_source.hpp
+    platform/default/tile_archive_file_source.cpp
+    platform/default/mbgl/storage/tile_archive.hpp
+    platform/default/mbgl/storage/tile_archive.cpp
 
     # Offline
     include/mbgl/storage/offline.hpp
@@ -20,6 +24,11 @@ add_library(mbgl-filesource STATIC
     platform/default/mbgl/storage/offline_download.hpp
     platform/default/mbgl/storage/offline_download.cpp
 
+    # Revalidation
+    include/mbgl/storage/revalidation_policy.hpp
+    platform/default/mbgl/storage/revalidation_scheduler.hpp
+    platform/default/mbgl/storage/revalidation_scheduler.cpp
+
     # Database
     platform/default/sqlite3.hpp
 )
@@ -28,6 +28,9 @@ set(MBGL_TEST_FILES
     # include/mbgl
     test/include/mbgl/test.hpp
 
+    # layout
+    test/layout/symbol_projection.test.cpp
+
     # map
     test/map/map.test.cpp
     test/map/prefetch.test.cpp
@@ -46,6 +49,7 @@ set(MBGL_TEST_FILES
     test/renderer/backend_scope.test.cpp
     test/renderer/group_by_layout.test.cpp
     test/renderer/image_manager.test.cpp
+    test/renderer/shared_image_atlas.test.cpp
 
     # sprite
     test/sprite/sprite_loader.test.cpp
@@ -69,6 +73,7 @@ set(MBGL_TEST_FILES
     test/src/mbgl/test/util.hpp
 
     # storage
+    test/storage/adaptive_concurrency.test.cpp
     test/storage/asset_file_source.test.cpp
     test/storage/default_file_source.test.cpp
     test/storage/headers.test.cpp
@@ -79,7 +84,9 @@ set(MBGL_TEST_FILES
     test/storage/offline_download.test.cpp
     test/storage/online_file_source.test.cpp
     test/storage/resource.test.cpp
+    test/storage/revalidation_scheduler.test.cpp
     test/storage/sqlite.test.cpp
+    test/storage/tile_archive_file_source.test.cpp
 
     # style/conversion
     test/style/conversion/function.test.cpp
@@ -107,9 +114,14 @@ set(MBGL_TEST_FILES
     test/style/style_parser.test.cpp
 
     # text
+    test/text/bidi_cache.test.cpp
+    test/text/collision_tile.test.cpp
     test/text/glyph_loader.test.cpp
     test/text/glyph_pbf.test.cpp
     test/text/quads.test.cpp
+    test/text/shaping_cache.test.cpp
+    test/text/shared_glyph_atlas.test.cpp
+    test/text/tiny_sdf.test.cpp
 
     # tile
     test/tile/annotation_tile.test.cpp
@@ -124,6 +136,7 @@ set(MBGL_TEST_FILES
     test/util/async_task.test.cpp
     test/util/dtoa.test.cpp
     test/util/geo.test.cpp
+    test/util/grid_index.test.cpp
     test/util/http_timeout.test.cpp
     test/util/image.test.cpp
     test/util/mapbox.test.cpp
@@ -131,9 +144,11 @@ set(MBGL_TEST_FILES
     test/util/merge_lines.test.cpp
     test/util/number_conversions.test.cpp
     test/util/offscreen_texture.test.cpp
+    test/util/parallel.test.cpp
     test/util/position.test.cpp
     test/util/projection.test.cpp
     test/util/run_loop.test.cpp
+    test/util/shared_buffer.test.cpp
     test/util/text_conversions.test.cpp
     test/util/thread.test.cpp
     test/util/thread_local.test.cpp
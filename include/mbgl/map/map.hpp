@@ -152,6 +152,11 @@ public:
     void updateAnnotation(AnnotationID, const Annotation&);
     void removeAnnotation(AnnotationID);
 
+    // Adds or removes many annotations at once, which is much faster than doing so one at a time.
+    // The returned IDs are in the same order as the annotations.
+    AnnotationIDs addAnnotations(const std::vector<Annotation>&);
+    void removeAnnotations(const AnnotationIDs&);
+
     // Tile prefetching
     //
     // When loading a map, if `PrefetchZoomDelta` is set to any number greater than 0, the map will
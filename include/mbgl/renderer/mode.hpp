@@ -15,4 +15,10 @@ enum class GLContextMode : EnumType {
     Shared,
 };
 
+// Spatial index that is used to find colliding labels during symbol placement.
+enum class CollisionIndexType : EnumType {
+    RTree,
+    Grid,
+};
+
 } // namespace mbgl
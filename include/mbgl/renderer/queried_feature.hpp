@@ -0,0 +1,45 @@
+#pragma once
+
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/geometry.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <memory>
+#include <string>
+
+namespace mbgl {
+
+class GeometryTileLayer;
+class GeometryTileFeature;
+
+/**
+ * A feature found by a rendered feature query. Unlike a `Feature`, it only refers to the tile
+ * data it was found in, and decodes its ID, properties and geometry when they are asked for.
+ * It keeps that data alive for as long as it exists, so it stays valid when the tile is
+ * reloaded or removed.
+ */
+class QueriedFeature {
+public:
+    QueriedFeature(std::shared_ptr<const GeometryTileLayer>, std::size_t index, const CanonicalTileID&);
+
+    optional<FeatureIdentifier> getID() const;
+    FeatureType getType() const;
+    optional<Value> getValue(const std::string& key) const;
+    PropertyMap getProperties() const;
+
+    /** Geometry in lat/lng */
+    Feature::geometry_type getGeometry() const;
+
+    /** The complete feature, as returned by `queryRenderedFeatures` */
+    Feature toFeature() const;
+
+private:
+    std::unique_ptr<GeometryTileFeature> decode() const;
+
+    std::shared_ptr<const GeometryTileLayer> layer;
+    std::size_t index;
+    CanonicalTileID tileID;
+};
+
+} // namespace mbgl
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <mbgl/util/optional.hpp>
+#include <mbgl/renderer/queried_feature.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/style/filter.hpp>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -25,19 +28,42 @@ public:
 };
 
 /**
- * Options for query source features
+ * Results of a batch of rendered feature queries. A feature that several queries hit in the
+ * same tile is only stored once: the features hit by query `i` are those at the indices
+ * `featureIndices[offsets[i]]` up to, but not including, `featureIndices[offsets[i + 1]]`,
+ * in the same order as the result of the equivalent single query.
+ */
+class RenderedQueryBatchResult {
+public:
+    std::vector<QueriedFeature> features;
+
+    /** One more than the number of queries */
+    std::vector<uint32_t> offsets;
+
+    /** Indices into `features` */
+    std::vector<uint32_t> featureIndices;
+};
+
+/**
+ * Options for query source features. Features with an ID that span several tiles are returned
+ * once.
  */
 class SourceQueryOptions {
 public:
     SourceQueryOptions(optional<std::vector<std::string>> sourceLayers_ = {},
-                       optional<style::Filter> filter_ = {})
+                       optional<style::Filter> filter_ = {},
+                       optional<LatLngBounds> bounds_ = {})
         : sourceLayers(std::move(sourceLayers_)),
-          filter(std::move(filter_)) {}
+          filter(std::move(filter_)),
+          bounds(std::move(bounds_)) {}
 
     // Required for VectorSource, ignored for GeoJSONSource
     optional<std::vector<std::string>> sourceLayers;
 
     optional<style::Filter> filter;
+
+    // Only features whose bounding box intersects these bounds are returned
+    optional<LatLngBounds> bounds;
 };
 
 } // namespace mbgl
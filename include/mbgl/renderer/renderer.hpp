@@ -38,9 +38,54 @@ public:
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> queryRenderedFeatures(const ScreenCoordinate& point, const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> queryRenderedFeatures(const ScreenBox& box, const RenderedQueryOptions& options = {}) const;
+
+    // Like queryRenderedFeatures, but returns features that only decode their ID, properties or
+    // geometry when asked for them, which is much faster for callers that only read a few.
+    std::vector<QueriedFeature> queryRenderedFeatureHandles(const ScreenCoordinate& point, const RenderedQueryOptions& options = {}) const;
+    std::vector<QueriedFeature> queryRenderedFeatureHandles(const ScreenBox& box, const RenderedQueryOptions& options = {}) const;
+
+    // Answers a query for each of the points or boxes in one pass over the tiles, which is much
+    // faster than querying them one at a time when there are many.
+    RenderedQueryBatchResult queryRenderedFeaturesBatch(const std::vector<ScreenCoordinate>& points, const RenderedQueryOptions& options = {}) const;
+    RenderedQueryBatchResult queryRenderedFeaturesBatch(const std::vector<ScreenBox>& boxes, const RenderedQueryOptions& options = {}) const;
+
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options = {}) const;
     AnnotationIDs queryPointAnnotations(const ScreenBox& box) const;
 
+    // When enabled, feature queries search the tiles of a source in parallel on the worker
+    // threads. Results are returned in the same order either way. Disabled by default.
+    void setParallelFeatureQueries(bool);
+
+    // Glyphs
+    // When enabled, tiles loaded afterwards pack their glyphs into a single atlas texture shared
+    // by all tiles, instead of building and uploading a glyph atlas per tile. Disabled by default.
+    void setSharedGlyphAtlas(bool);
+
+    // When set, CJK ideographs, kana and hangul in text loaded afterwards are drawn with a local
+    // font of this family instead of being downloaded with the style's glyphs. On platforms
+    // without a local font rasterizer, all glyphs are still downloaded. Unset by default.
+    void setLocalIdeographFontFamily(const optional<std::string>&);
+
+    // When enabled, the most common glyph ranges of every font stack used by the style are
+    // requested as soon as the style is loaded, along with the first tiles, instead of after the
+    // tiles have been laid out. Disabled by default.
+    void setGlyphWarmup(bool);
+
+    // Icons
+    // When enabled, tiles loaded afterwards copy their icons into a single atlas texture shared
+    // by all tiles, instead of building and uploading an icon atlas per tile. Disabled by default.
+    void setSharedIconAtlas(bool);
+
+    // Placement
+    // Selects the spatial index used to detect label collisions. Tiles are placed again with the
+    // new index. Defaults to the R-tree, or to the grid in builds with WITH_COLLISION_GRID.
+    void setCollisionIndex(CollisionIndexType);
+
+    // When enabled, the positions of icons and text that follow lines are computed for all tiles
+    // in parallel on the worker threads before the frame is drawn, instead of one tile at a time
+    // on the render thread. Disabled by default.
+    void setParallelLineLabels(bool);
+
     // Debug
     void dumpDebugLogs();
 
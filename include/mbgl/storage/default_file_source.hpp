@@ -2,7 +2,9 @@
 
 #include <mbgl/actor/actor_ref.hpp>
 #include <mbgl/storage/file_source.hpp>
+#include <mbgl/storage/http_connection_mode.hpp>
 #include <mbgl/storage/offline.hpp>
+#include <mbgl/storage/revalidation_policy.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/optional.hpp>
 
@@ -46,6 +48,17 @@ public:
 
     void setResourceTransform(optional<ActorRef<ResourceTransform>>&&);
 
+    /*
+     * Select how network requests share connections. See `HTTPConnectionMode`.
+     */
+    void setHTTPConnectionMode(HTTPConnectionMode);
+
+    /*
+     * Configure how expired resources in the cache are served and revalidated. See
+     * `RevalidationPolicy`. Applies to requests made afterwards.
+     */
+    void setRevalidationPolicy(RevalidationPolicy);
+
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
 
     /*
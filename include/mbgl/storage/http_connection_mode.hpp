@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace mbgl {
+
+enum class HTTPConnectionMode : uint8_t {
+    // Requests use the HTTP stack's default connection handling and a fixed concurrency limit.
+    Default,
+
+    // Requests to the same host share a single HTTP/2 connection, negotiated via TLS, and the
+    // number of concurrent requests adapts to the observed latency and throughput. Servers that
+    // don't support HTTP/2 are talked to over HTTP/1.1 as before.
+    Multiplexed,
+
+    // Like `Multiplexed`, but also speaks HTTP/2 to cleartext http:// servers without negotiating
+    // it first. Only use this with servers that are known to support HTTP/2.
+    MultiplexedPriorKnowledge,
+};
+
+} // namespace mbgl
@@ -2,6 +2,7 @@
 
 #include <mbgl/actor/actor_ref.hpp>
 #include <mbgl/storage/file_source.hpp>
+#include <mbgl/storage/http_connection_mode.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/optional.hpp>
 
@@ -22,6 +23,8 @@ public:
 
     void setResourceTransform(optional<ActorRef<ResourceTransform>>&&);
 
+    void setHTTPConnectionMode(HTTPConnectionMode);
+
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
 
     // For testing only.
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstdint>
+
+namespace mbgl {
+
+/*
+ * Controls how DefaultFileSource handles cached resources that have expired.
+ *
+ * By default, expired resources are returned from the cache unless the server marked them as
+ * must-revalidate, and are then revalidated together with all other network requests. With
+ * stale-while-revalidate enabled, resources that expired recently enough are always returned from
+ * the cache right away and are revalidated in the background, so that rendering from a warm cache
+ * doesn't wait for the network, e.g. after restarting the app.
+ */
+struct RevalidationPolicy {
+    // Expired resources are returned right away and revalidated in the background if they expired
+    // at most this long ago. This includes resources marked must-revalidate. Resources that expired
+    // longer ago are handled as usual. Zero disables stale-while-revalidate.
+    Seconds maximumStaleness = Seconds::zero();
+
+    // The number of background revalidations that may be in progress at once. Further
+    // revalidations wait, so that they don't compete with requests for missing resources.
+    uint32_t maximumConcurrentRevalidations = 4;
+
+    // Tile sets are usually updated as a whole. When a background revalidation finds a tile to be
+    // unchanged, the other expired tiles of the same tile set and zoom level are assumed to be
+    // unchanged as well, and aren't revalidated individually until they expire again.
+    bool coalesceZoomLevels = true;
+};
+
+} // namespace mbgl
@@ -2,8 +2,11 @@
 
 #include <mbgl/style/source.hpp>
 #include <mbgl/util/geojson.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/optional.hpp>
 
+#include <vector>
+
 namespace mbgl {
 
 class AsyncRequest;
@@ -30,6 +33,15 @@ public:
 
     void setURL(const std::string& url);
     void setGeoJSON(const GeoJSON&);
+    // Takes over the data without copying it, which matters for large data sets.
+    void setGeoJSON(GeoJSON&&);
+
+    // Adds the features, replacing any existing features with the same IDs. Features without an
+    // ID are ignored. Only the tiles that contain the old or new versions of the features are
+    // updated, which is much faster than setting the data again when few features change.
+    void updateFeatures(const FeatureCollection&);
+    // Removes the features with the given IDs.
+    void removeFeatures(const std::vector<FeatureIdentifier>&);
 
     optional<std::string> getURL() const;
 
@@ -1,12 +1,22 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace mbgl {
 namespace util {
 
-std::string compress(const std::string& raw);
-std::string decompress(const std::string& raw);
+std::string compress(const char* raw, std::size_t size);
+std::string decompress(const char* raw, std::size_t size);
+
+inline std::string compress(const std::string& raw) {
+    return compress(raw.data(), raw.size());
+}
+
+// Accepts both zlib and gzip streams.
+inline std::string decompress(const std::string& raw) {
+    return decompress(raw.data(), raw.size());
+}
 
 } // namespace util
 } // namespace mbgl
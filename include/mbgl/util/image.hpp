@@ -170,8 +170,12 @@ using UnassociatedImage = Image<ImageAlphaMode::Unassociated>;
 using PremultipliedImage = Image<ImageAlphaMode::Premultiplied>;
 using AlphaImage = Image<ImageAlphaMode::Exclusive>;
 
-// TODO: don't use std::string for binary data.
-PremultipliedImage decodeImage(const std::string&);
+PremultipliedImage decodeImage(const char* data, std::size_t size);
+
+inline PremultipliedImage decodeImage(const std::string& string) {
+    return decodeImage(string.data(), string.size());
+}
+
 std::string encodePNG(const PremultipliedImage&);
 
 } // namespace mbgl
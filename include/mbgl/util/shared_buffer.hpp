@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace mbgl {
+
+/**
+ * `SharedBuffer` is a nullable, reference-counted view of immutable bytes. The bytes are kept
+ * alive by an opaque owner, which may be a `std::string`, a memory mapping, or any other object
+ * that holds on to the storage. Copying a `SharedBuffer` never copies the underlying bytes, so it
+ * can be handed from a `FileSource` through to the tile parsers without intermediate copies.
+ *
+ * A default-constructed `SharedBuffer` is null, which is distinct from a non-null buffer that
+ * holds zero bytes.
+ */
+class SharedBuffer {
+public:
+    SharedBuffer() = default;
+
+    // Adopts the string without copying its contents.
+    SharedBuffer(std::shared_ptr<const std::string> string_)
+        : bytes(string_ ? string_->data() : nullptr),
+          length(string_ ? string_->size() : 0),
+          owner(std::move(string_)) {
+    }
+
+    SharedBuffer(std::shared_ptr<std::string> string_)
+        : SharedBuffer(std::shared_ptr<const std::string>(std::move(string_))) {
+    }
+
+    SharedBuffer(std::unique_ptr<std::string> string_)
+        : SharedBuffer(std::shared_ptr<const std::string>(std::move(string_))) {
+    }
+
+    // Wraps bytes whose lifetime is tied to `owner`.
+    SharedBuffer(std::shared_ptr<const void> owner_, const char* bytes_, std::size_t length_)
+        : bytes(bytes_), length(length_), owner(std::move(owner_)) {
+    }
+
+    // Takes ownership of externally allocated bytes; `deleter` is invoked with `bytes` once the
+    // last buffer referencing them is destroyed.
+    template <class Deleter>
+    SharedBuffer(const char* bytes_, std::size_t length_, Deleter deleter)
+        : bytes(bytes_), length(length_), owner(bytes_, std::move(deleter)) {
+    }
+
+    const char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    const char* begin() const { return bytes; }
+    const char* end() const { return bytes + length; }
+
+    explicit operator bool() const { return bool(owner); }
+
+    // Returns a view of a subrange that shares ownership with this buffer. The range is clamped
+    // to the bounds of this buffer.
+    SharedBuffer slice(std::size_t offset, std::size_t count = std::string::npos) const {
+        offset = offset < length ? offset : length;
+        count = count < length - offset ? count : length - offset;
+        return { owner, bytes + offset, count };
+    }
+
+    // Returns a copy of the bytes. Only use this for consumers that require a `std::string`.
+    std::string string() const {
+        return bytes ? std::string(bytes, length) : std::string();
+    }
+
+    friend bool operator==(const SharedBuffer& lhs, const SharedBuffer& rhs) {
+        return lhs.owner == rhs.owner && lhs.bytes == rhs.bytes && lhs.length == rhs.length;
+    }
+
+    friend bool operator!=(const SharedBuffer& lhs, const SharedBuffer& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    const char* bytes = nullptr;
+    std::size_t length = 0;
+    std::shared_ptr<const void> owner;
+};
+
+} // namespace mbgl
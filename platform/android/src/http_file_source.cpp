@@ -192,4 +192,16 @@ uint32_t HTTPFileSource::maximumConcurrentRequests() {
     return 20;
 }
 
+void HTTPFileSource::setConnectionMode(HTTPConnectionMode) {
+    // OkHttp negotiates HTTP/2 and multiplexes requests on its own.
+}
+
+bool HTTPFileSource::supportsConnectionModes() {
+    return false;
+}
+
+uint32_t HTTPFileSource::getConcurrencyLimit() const {
+    return maximumConcurrentRequests();
+}
+
 } // namespace mbgl
@@ -8,14 +8,14 @@
 
 namespace mbgl {
 
-PremultipliedImage decodeImage(const std::string& string) {
+PremultipliedImage decodeImage(const char* data, std::size_t size) {
     auto env{ android::AttachEnv() };
 
-    auto array = jni::Array<jni::jbyte>::New(*env, string.size());
-    jni::SetArrayRegion(*env, *array, 0, string.size(),
-                        reinterpret_cast<const signed char*>(string.data()));
+    auto array = jni::Array<jni::jbyte>::New(*env, size);
+    jni::SetArrayRegion(*env, *array, 0, size,
+                        reinterpret_cast<const signed char*>(data));
 
-    auto bitmap = android::BitmapFactory::DecodeByteArray(*env, array, 0, string.size());
+    auto bitmap = android::BitmapFactory::DecodeByteArray(*env, array, 0, size);
     return android::Bitmap::GetImage(*env, bitmap);
 }
 
@@ -61,7 +61,7 @@ namespace android {
         }
 
         // Update the core source
-        source.as<mbgl::style::GeoJSONSource>()->GeoJSONSource::setGeoJSON(*converted);
+        source.as<mbgl::style::GeoJSONSource>()->GeoJSONSource::setGeoJSON(std::move(*converted));
     }
 
     void GeoJSONSource::setFeatureCollection(jni::JNIEnv& env, jni::Object<geojson::FeatureCollection> jFeatures) {
@@ -196,6 +196,18 @@ uint32_t HTTPFileSource::maximumConcurrentRequests() {
     return 20;
 }
 
+void HTTPFileSource::setConnectionMode(HTTPConnectionMode) {
+    // NSURLSession negotiates HTTP/2 and multiplexes requests on its own.
+}
+
+bool HTTPFileSource::supportsConnectionModes() {
+    return false;
+}
+
+uint32_t HTTPFileSource::getConcurrencyLimit() const {
+    return maximumConcurrentRequests();
+}
+
 std::unique_ptr<AsyncRequest> HTTPFileSource::request(const Resource& resource, Callback callback) {
     auto request = std::make_unique<HTTPRequest>(callback);
     auto shared = request->shared; // Explicit copy so that it also gets copied into the completion handler block below.
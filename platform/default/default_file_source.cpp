@@ -6,6 +6,8 @@
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/offline_download.hpp>
 #include <mbgl/storage/resource_transform.hpp>
+#include <mbgl/storage/revalidation_scheduler.hpp>
+#include <mbgl/storage/tile_archive_file_source.hpp>
 
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/url.hpp>
@@ -30,7 +32,8 @@ class DefaultFileSource::Impl {
 public:
     Impl(ActorRef<Impl> self, std::shared_ptr<FileSource> assetFileSource_, const std::string& cachePath, uint64_t maximumCacheSize)
             : assetFileSource(assetFileSource_)
-            , localFileSource(std::make_unique<LocalFileSource>()) {
+            , localFileSource(std::make_unique<LocalFileSource>())
+            , tileArchiveFileSource(std::make_unique<TileArchiveFileSource>()) {
         // Initialize the Database asynchronously so as to not block Actor creation.
         self.invoke(&Impl::initializeOfflineDatabase, cachePath, maximumCacheSize);
     }
@@ -59,6 +62,14 @@ public:
         onlineFileSource.setResourceTransform(std::move(transform));
     }
 
+    void setHTTPConnectionMode(HTTPConnectionMode mode) {
+        onlineFileSource.setHTTPConnectionMode(mode);
+    }
+
+    void setRevalidationPolicy(RevalidationPolicy policy) {
+        revalidationScheduler.setPolicy(std::move(policy));
+    }
+
     void listRegions(std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
         try {
             callback({}, offlineDatabase->listRegions());
@@ -124,11 +135,25 @@ public:
         } else if (LocalFileSource::acceptsURL(resource.url)) {
             //Local file request
             tasks[req] = localFileSource->request(resource, callback);
+        } else if (TileArchiveFileSource::acceptsURL(resource.url)) {
+            //Tile archive request
+            tasks[req] = tileArchiveFileSource->request(resource, callback);
         } else {
+            // Whether the requestor has, or is about to receive, expired data that we're allowed to
+            // revalidate in the background.
+            bool revalidateInBackground = false;
+
             // Try the offline database
             if (resource.hasLoadingMethod(Resource::LoadingMethod::Cache)) {
                 auto offlineResponse = offlineDatabase->get(resource);
 
+                if (offlineResponse && !offlineResponse->isUsable() &&
+                    revalidationScheduler.acceptsStale(offlineResponse->expires)) {
+                    // Serve resources the server requested not to show when they're stale anyway,
+                    // as long as they're within the maximum staleness of the revalidation policy.
+                    offlineResponse->mustRevalidate = false;
+                }
+
                 if (resource.loadingMethod == Resource::LoadingMethod::CacheOnly) {
                     if (!offlineResponse) {
                         // Ensure there's always a response that we can send, so the caller knows that
@@ -159,12 +184,28 @@ public:
                 }
             }
 
+            if (resource.hasLoadingMethod(Resource::LoadingMethod::Network) &&
+                revalidationScheduler.acceptsStale(resource.priorExpires)) {
+                // The requestor already has the data, either from the lookup above, or from an
+                // earlier cache-only request when no prior data is passed along.
+                if (resource.loadingMethod == Resource::LoadingMethod::All || !resource.priorData) {
+                    resource.priorData = {};
+                    revalidateInBackground = true;
+                }
+            }
+
             // Get from the online file source
             if (resource.hasLoadingMethod(Resource::LoadingMethod::Network)) {
-                tasks[req] = onlineFileSource.request(resource, [=] (Response onlineResponse) mutable {
+                auto onlineCallback = [=] (Response onlineResponse) mutable {
                     this->offlineDatabase->put(resource, onlineResponse);
                     callback(onlineResponse);
-                });
+                };
+
+                if (revalidateInBackground) {
+                    tasks[req] = revalidationScheduler.revalidate(resource, onlineCallback);
+                } else {
+                    tasks[req] = onlineFileSource.request(resource, onlineCallback);
+                }
             }
         }
     }
@@ -198,8 +239,10 @@ private:
     // shared so that destruction is done on the creating thread
     const std::shared_ptr<FileSource> assetFileSource;
     const std::unique_ptr<FileSource> localFileSource;
+    const std::unique_ptr<FileSource> tileArchiveFileSource;
     std::unique_ptr<OfflineDatabase> offlineDatabase;
     OnlineFileSource onlineFileSource;
+    RevalidationScheduler revalidationScheduler { onlineFileSource };
     std::unordered_map<AsyncRequest*, std::unique_ptr<AsyncRequest>> tasks;
     std::unordered_map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
 };
@@ -251,6 +294,14 @@ void DefaultFileSource::setResourceTransform(optional<ActorRef<ResourceTransform
     impl->actor().invoke(&Impl::setResourceTransform, std::move(transform));
 }
 
+void DefaultFileSource::setHTTPConnectionMode(HTTPConnectionMode mode) {
+    impl->actor().invoke(&Impl::setHTTPConnectionMode, mode);
+}
+
+void DefaultFileSource::setRevalidationPolicy(RevalidationPolicy policy) {
+    impl->actor().invoke(&Impl::setRevalidationPolicy, policy);
+}
+
 std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resource, Callback callback) {
     auto req = std::make_unique<FileSourceRequest>(std::move(callback));
 
@@ -1,4 +1,5 @@
 #include <mbgl/storage/http_file_source.hpp>
+#include <mbgl/storage/adaptive_concurrency.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/util/logging.hpp>
@@ -33,6 +34,15 @@ static void handleError(CURLcode code) {
 
 namespace mbgl {
 
+namespace {
+
+// Bounds for the adaptive concurrency limit in the multiplexed modes. HTTP/2 servers typically
+// allow at least 100 concurrent streams per connection.
+const uint32_t minimumConcurrentRequests = 4;
+const uint32_t maximumMultiplexedRequests = 64;
+
+} // namespace
+
 class HTTPFileSource::Impl {
 public:
     Impl();
@@ -46,6 +56,8 @@ public:
     CURL *getHandle();
     void returnHandle(CURL *handle);
     void checkMultiInfo();
+    void setConnectionMode(HTTPConnectionMode);
+    uint32_t getConcurrencyLimit() const;
 
     // Used as the CURL timer function to periodically check for socket updates.
     util::Timer timeout;
@@ -60,6 +72,15 @@ public:
     // A queue that we use for storing resuable CURL easy handles to avoid creating and destroying
     // them all the time.
     std::queue<CURL *> handles;
+
+    HTTPConnectionMode connectionMode = HTTPConnectionMode::Default;
+
+    // Only used in the multiplexed modes.
+    AdaptiveConcurrency concurrency { HTTPFileSource::maximumConcurrentRequests(),
+                                      minimumConcurrentRequests, maximumMultiplexedRequests };
+
+    // Number of requests that are currently added to the multi handle.
+    uint32_t activeRequests = 0;
 };
 
 class HTTPRequest : public AsyncRequest {
@@ -70,6 +91,8 @@ public:
     void handleResult(CURLcode code);
 
 private:
+    void recordTimings();
+
     static size_t headerCallback(char *const buffer, const size_t size, const size_t nmemb, void *userp);
     static size_t writeCallback(void *const contents, const size_t size, const size_t nmemb, void *userp);
 
@@ -87,6 +110,9 @@ private:
     CURL *handle = nullptr;
     curl_slist *headers = nullptr;
 
+    // Whether the concurrency limit was reached while this request was active.
+    bool saturated = false;
+
     char error[CURL_ERROR_SIZE] = { 0 };
 };
 
@@ -134,6 +160,26 @@ void HTTPFileSource::Impl::returnHandle(CURL *handle) {
     handles.push(handle);
 }
 
+void HTTPFileSource::Impl::setConnectionMode(HTTPConnectionMode mode) {
+    connectionMode = mode;
+
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (43) << 8 | 0) // Introduced in 7.43.0
+    handleError(curl_multi_setopt(multi, CURLMOPT_PIPELINING,
+        mode == HTTPConnectionMode::Default ? CURLPIPE_NOTHING : CURLPIPE_MULTIPLEX));
+#endif
+
+    // In the multiplexed modes, keep enough idle connections around to serve a full set of
+    // concurrent requests to servers without HTTP/2 without reconnecting. Zero restores cURL's
+    // default pool size.
+    handleError(curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS,
+        mode == HTTPConnectionMode::Default ? 0L : long(HTTPFileSource::maximumConcurrentRequests())));
+}
+
+uint32_t HTTPFileSource::Impl::getConcurrencyLimit() const {
+    return connectionMode == HTTPConnectionMode::Default
+        ? HTTPFileSource::maximumConcurrentRequests() : concurrency.getLimit();
+}
+
 void HTTPFileSource::Impl::checkMultiInfo() {
     CURLMsg *message = nullptr;
     int pending = 0;
@@ -261,12 +307,32 @@ HTTPRequest::HTTPRequest(HTTPFileSource::Impl* context_, Resource resource_, Fil
     handleError(curl_easy_setopt(handle, CURLOPT_USERAGENT, "MapboxGL/1.0"));
     handleError(curl_easy_setopt(handle, CURLOPT_SHARE, context->share));
 
+    if (context->connectionMode != HTTPConnectionMode::Default) {
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (49) << 8 | 0) // Introduced in 7.49.0
+        handleError(curl_easy_setopt(handle, CURLOPT_HTTP_VERSION,
+            context->connectionMode == HTTPConnectionMode::MultiplexedPriorKnowledge
+                ? CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE : CURL_HTTP_VERSION_2TLS));
+#elif LIBCURL_VERSION_NUM >= ((7) << 16 | (47) << 8 | 0) // Introduced in 7.47.0
+        handleError(curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS));
+#endif
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (43) << 8 | 0) // Introduced in 7.43.0
+        // Wait for a connection that is being established to the same host, so that we can
+        // multiplex over it instead of opening a new one.
+        handleError(curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L));
+#endif
+    }
+
     // Start requesting the information.
     handleError(curl_multi_add_handle(context->multi, handle));
+
+    if (++context->activeRequests >= context->getConcurrencyLimit()) {
+        saturated = true;
+    }
 }
 
 HTTPRequest::~HTTPRequest() {
     handleError(curl_multi_remove_handle(context->multi, handle));
+    context->activeRequests--;
     context->returnHandle(handle);
     handle = nullptr;
 
@@ -284,6 +350,23 @@ size_t HTTPRequest::writeCallback(void *const contents, const size_t size, const
 
     if (!impl->data) {
         impl->data = std::make_shared<std::string>();
+
+        // Size the buffer up front when the server told us how much to expect, so that appending
+        // the body doesn't repeatedly reallocate and copy what we've received so far. The
+        // length is only a hint; it refers to the encoded body when the transfer is compressed.
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (55) << 8 | 0) // Introduced in 7.55.0
+        curl_off_t contentLength = -1;
+        if (curl_easy_getinfo(impl->handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength) == CURLE_OK &&
+            contentLength > 0) {
+            impl->data->reserve(size_t(contentLength));
+        }
+#else
+        double contentLength = -1;
+        if (curl_easy_getinfo(impl->handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD, &contentLength) == CURLE_OK &&
+            contentLength > 0) {
+            impl->data->reserve(size_t(contentLength));
+        }
+#endif
     }
 
     impl->data->append((char *)contents, size * nmemb);
@@ -397,12 +480,45 @@ void HTTPRequest::handleResult(CURLcode code) {
         }
     }
 
+    if (code == CURLE_OK && context->connectionMode != HTTPConnectionMode::Default) {
+        recordTimings();
+    }
+
     // Calling `callback` may result in deleting `this`. Copy data to temporaries first.
     auto callback_ = callback;
     auto response_ = *response;
     callback_(response_);
 }
 
+void HTTPRequest::recordTimings() {
+    // All times are in seconds since the start of the request. Time spent waiting for a
+    // connection and the TLS handshake are excluded from the latency, since they aren't affected
+    // by the number of concurrent requests on an established connection.
+    double pretransfer = 0;
+    double starttransfer = 0;
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (55) << 8 | 0) // Introduced in 7.55.0
+    curl_off_t downloaded = 0;
+    const CURLINFO downloadedInfo = CURLINFO_SIZE_DOWNLOAD_T;
+#else
+    double downloaded = 0;
+    const CURLINFO downloadedInfo = CURLINFO_SIZE_DOWNLOAD;
+#endif
+    if (curl_easy_getinfo(handle, CURLINFO_PRETRANSFER_TIME, &pretransfer) != CURLE_OK ||
+        curl_easy_getinfo(handle, CURLINFO_STARTTRANSFER_TIME, &starttransfer) != CURLE_OK ||
+        curl_easy_getinfo(handle, downloadedInfo, &downloaded) != CURLE_OK ||
+        starttransfer < pretransfer) {
+        return;
+    }
+
+    if (context->activeRequests >= context->getConcurrencyLimit()) {
+        saturated = true;
+    }
+
+    const auto latency = std::chrono::duration_cast<Duration>(
+        std::chrono::duration<double>(starttransfer - pretransfer));
+    context->concurrency.addSample(latency, uint64_t(downloaded), Clock::now(), saturated);
+}
+
 HTTPFileSource::HTTPFileSource()
     : impl(std::make_unique<Impl>()) {
 }
@@ -417,4 +533,20 @@ uint32_t HTTPFileSource::maximumConcurrentRequests() {
     return 20;
 }
 
+void HTTPFileSource::setConnectionMode(HTTPConnectionMode mode) {
+    impl->setConnectionMode(mode);
+}
+
+bool HTTPFileSource::supportsConnectionModes() {
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (49) << 8 | 0) // Prior knowledge was introduced in 7.49.0
+    return curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2;
+#else
+    return false;
+#endif
+}
+
+uint32_t HTTPFileSource::getConcurrencyLimit() const {
+    return impl->getConcurrencyLimit();
+}
+
 } // namespace mbgl
@@ -5,8 +5,14 @@
 #include <mbgl/util/thread.hpp>
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/util.hpp>
-#include <mbgl/util/io.hpp>
 
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -16,6 +22,79 @@ namespace {
 const char* protocol = "file://";
 const std::size_t protocolLength = 7;
 
+// Files of at least this size are memory-mapped instead of being read into a heap buffer. Below
+// it, the cost of setting up and tearing down the mapping outweighs the copy.
+const std::size_t mapThreshold = 64 * 1024;
+
+// Unknown or changing file sizes are read in chunks of this size.
+const std::size_t chunkSize = 64 * 1024;
+
+std::atomic<uint64_t> mappedBytes { 0 };
+std::atomic<uint64_t> allocatedBytes { 0 };
+
+class FileDescriptor {
+public:
+    FileDescriptor(int fd_) : fd(fd_) {}
+    ~FileDescriptor() { if (fd != -1) ::close(fd); }
+    operator int() const { return fd; }
+
+private:
+    const int fd;
+};
+
+[[noreturn]] void throwReadError(const std::string& path) {
+    throw std::runtime_error("Cannot read file " + path + ": " + std::strerror(errno));
+}
+
+// Maps the file read-only. The mapping is released once the last buffer referring to it is gone.
+mbgl::SharedBuffer mapFile(int fd, std::size_t size) {
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        return {};
+    }
+
+    // Parsers consume local resources front to back, so let the kernel read ahead aggressively.
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    mappedBytes += size;
+    return { reinterpret_cast<const char*>(mapping), size, [size](const char* bytes) {
+        munmap(const_cast<char*>(bytes), size);
+        mappedBytes -= size;
+    } };
+}
+
+// Reads the file straight into a buffer of the expected size, then continues in fixed-size
+// chunks in case the file is larger than expected or its size is unknown, e.g. for pipes.
+mbgl::SharedBuffer readFile(int fd, std::size_t sizeHint, const std::string& path) {
+    // Reserve one extra byte so that we hit EOF without growing the buffer when the file still
+    // has the size we saw in fstat().
+    auto data = std::make_unique<std::string>(sizeHint + 1, '\0');
+    std::size_t length = 0;
+    while (true) {
+        if (length == data->size()) {
+            data->resize(data->size() + chunkSize);
+        }
+        const ssize_t count = ::read(fd, &(*data)[length], data->size() - length);
+        if (count == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwReadError(path);
+        }
+        if (count == 0) {
+            break;
+        }
+        length += std::size_t(count);
+    }
+    data->resize(length);
+
+    allocatedBytes += length;
+    return std::shared_ptr<const std::string>(data.release(), [length](const std::string* string) {
+        allocatedBytes -= length;
+        delete string;
+    });
+}
+
 } // namespace
 
 namespace mbgl {
@@ -30,21 +109,28 @@ public:
 
         Response response;
 
-        struct stat buf;
-        int result = stat(path.c_str(), &buf);
-
-        if (result == 0 && S_ISDIR(buf.st_mode)) {
-            response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
-        } else if (result == -1 && errno == ENOENT) {
-            response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
-        } else {
-            try {
-                response.data = std::make_shared<std::string>(util::read_file(path));
-            } catch (...) {
-                response.error = std::make_unique<Response::Error>(
-                    Response::Error::Reason::Other,
-                    util::toString(std::current_exception()));
+        try {
+            FileDescriptor fd(::open(path.c_str(), O_RDONLY));
+            struct stat buf;
+            if (fd == -1 && errno == ENOENT) {
+                response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
+            } else if (fd == -1 || fstat(fd, &buf) == -1) {
+                throwReadError(path);
+            } else if (S_ISDIR(buf.st_mode)) {
+                response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
+            } else {
+                const std::size_t size = S_ISREG(buf.st_mode) ? std::size_t(buf.st_size) : 0;
+                if (size >= mapThreshold) {
+                    response.data = mapFile(fd, size);
+                }
+                if (!response.data) {
+                    response.data = readFile(fd, size, path);
+                }
             }
+        } catch (...) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other,
+                util::toString(std::current_exception()));
         }
 
         req.invoke(&FileSourceRequest::setResponse, response);
@@ -66,6 +152,10 @@ std::unique_ptr<AsyncRequest> LocalFileSource::request(const Resource& resource,
     return std::move(req);
 }
 
+LocalFileSource::MemoryUsage LocalFileSource::getMemoryUsage() {
+    return { mappedBytes, allocatedBytes };
+}
+
 bool LocalFileSource::acceptsURL(const std::string& url) {
     return url.compare(0, protocolLength, protocol) == 0;
 }
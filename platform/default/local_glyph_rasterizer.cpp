@@ -0,0 +1,25 @@
+#include <mbgl/text/local_glyph_rasterizer.hpp>
+
+namespace mbgl {
+
+// This platform has no font rendering, so all glyphs are downloaded. Local rasterization is only
+// implemented by the Qt platform (platform/qt/src/local_glyph_rasterizer.cpp); this file is used
+// by the Linux, macOS, iOS and Android builds.
+
+class LocalGlyphRasterizer::Impl {
+};
+
+LocalGlyphRasterizer::LocalGlyphRasterizer(const optional<std::string>&) {
+}
+
+LocalGlyphRasterizer::~LocalGlyphRasterizer() = default;
+
+bool LocalGlyphRasterizer::canRasterizeGlyph(const FontStack&, GlyphID) const {
+    return false;
+}
+
+Glyph LocalGlyphRasterizer::rasterizeGlyph(const FontStack&, GlyphID) {
+    return Glyph();
+}
+
+} // namespace mbgl
@@ -177,14 +177,17 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
         return { false, 0 };
     }
 
-    std::string compressedData;
+    SharedBuffer data = response.data;
     bool compressed = false;
     uint64_t size = 0;
 
     if (response.data) {
-        compressedData = util::compress(*response.data);
-        compressed = compressedData.size() < response.data->size();
-        size = compressed ? compressedData.size() : response.data->size();
+        std::string compressedData = util::compress(response.data.data(), response.data.size());
+        compressed = compressedData.size() < response.data.size();
+        if (compressed) {
+            data = std::make_shared<const std::string>(std::move(compressedData));
+        }
+        size = data.size();
     }
 
     if (evict_ && !evict(size)) {
@@ -197,11 +200,11 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
         inserted = putTile(*resource.tileData, response,
-                compressed ? compressedData : response.data ? *response.data : "",
+                data,
                 compressed);
     } else {
         inserted = putResource(resource, response,
-                compressed ? compressedData : response.data ? *response.data : "",
+                data,
                 compressed);
     }
 
@@ -247,8 +250,8 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
         response.data = std::make_shared<std::string>(util::decompress(*data));
         size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
         size = data->length();
+        response.data = std::make_shared<std::string>(std::move(*data));
     }
 
     return std::make_pair(response, size);
@@ -269,7 +272,7 @@ optional<int64_t> OfflineDatabase::hasResource(const Resource& resource) {
 
 bool OfflineDatabase::putResource(const Resource& resource,
                                   const Response& response,
-                                  const std::string& data,
+                                  const SharedBuffer& data,
                                   bool compressed) {
     if (response.notModified) {
         // clang-format off
@@ -321,7 +324,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         update->bind(7, nullptr);
         update->bind(8, false);
     } else {
-        update->bindBlob(7, data.data(), data.size(), false);
+        update->bindBlob(7, data ? data.data() : "", data.size(), false);
         update->bind(8, compressed);
     }
 
@@ -349,7 +352,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         insert->bind(8, nullptr);
         insert->bind(9, false);
     } else {
-        insert->bindBlob(8, data.data(), data.size(), false);
+        insert->bindBlob(8, data ? data.data() : "", data.size(), false);
         insert->bind(9, compressed);
     }
 
@@ -416,8 +419,8 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
         response.data = std::make_shared<std::string>(util::decompress(*data));
         size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
         size = data->length();
+        response.data = std::make_shared<std::string>(std::move(*data));
     }
 
     return std::make_pair(response, size);
@@ -450,7 +453,7 @@ optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
 
 bool OfflineDatabase::putTile(const Resource::TileData& tile,
                               const Response& response,
-                              const std::string& data,
+                              const SharedBuffer& data,
                               bool compressed) {
     if (response.notModified) {
         // clang-format off
@@ -516,7 +519,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         update->bind(6, nullptr);
         update->bind(7, false);
     } else {
-        update->bindBlob(6, data.data(), data.size(), false);
+        update->bindBlob(6, data ? data.data() : "", data.size(), false);
         update->bind(7, compressed);
     }
 
@@ -547,7 +550,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         insert->bind(11, nullptr);
         insert->bind(12, false);
     } else {
-        insert->bindBlob(11, data.data(), data.size(), false);
+        insert->bindBlob(11, data ? data.data() : "", data.size(), false);
         insert->bind(12, compressed);
     }
 
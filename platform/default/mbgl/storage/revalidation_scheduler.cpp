@@ -0,0 +1,194 @@
+#include <mbgl/storage/revalidation_scheduler.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <cassert>
+
+namespace mbgl {
+
+class RevalidationScheduler::Request : public AsyncRequest {
+public:
+    Request(RevalidationScheduler& scheduler_, Resource resource_, FileSource::Callback callback_)
+        : scheduler(scheduler_),
+          resource(std::move(resource_)),
+          callback(std::move(callback_)) {
+    }
+
+    ~Request() override {
+        scheduler.remove(*this);
+    }
+
+    void respond(const Response& response) {
+        // Calling the callback may result in `this` being deleted.
+        auto callback_ = callback;
+        callback_(response);
+    }
+
+    enum class State : uint8_t {
+        Queued,
+        Active,
+        Done,
+    };
+
+    RevalidationScheduler& scheduler;
+    Resource resource;
+    FileSource::Callback callback;
+
+    State state = State::Queued;
+    std::list<Request*>::iterator position;
+    optional<std::string> zoomLevel;
+
+    std::unique_ptr<AsyncRequest> request;
+};
+
+RevalidationScheduler::RevalidationScheduler(FileSource& fileSource_)
+    : fileSource(fileSource_),
+      asyncProcess([this] { process(); }) {
+}
+
+RevalidationScheduler::~RevalidationScheduler() {
+    assert(queue.empty());
+    assert(active == 0);
+}
+
+void RevalidationScheduler::setPolicy(RevalidationPolicy policy_) {
+    policy = std::move(policy_);
+    process();
+}
+
+bool RevalidationScheduler::acceptsStale(const optional<Timestamp>& expires) const {
+    if (policy.maximumStaleness == Seconds::zero() || !expires) {
+        return false;
+    }
+
+    const Timestamp now = util::now();
+    return *expires <= now && now - *expires <= policy.maximumStaleness;
+}
+
+std::unique_ptr<AsyncRequest> RevalidationScheduler::revalidate(const Resource& resource, FileSource::Callback callback) {
+    assert(!resource.priorData);
+
+    auto request = std::make_unique<Request>(*this, resource, std::move(callback));
+    if (policy.coalesceZoomLevels && resource.tileData) {
+        request->zoomLevel = resource.tileData->urlTemplate + "@" +
+            util::toString(resource.tileData->pixelRatio) + "/" +
+            util::toString(resource.tileData->z);
+        zoomLevels[*request->zoomLevel].requests++;
+    }
+    request->position = queue.insert(queue.end(), request.get());
+
+    process();
+
+    return std::move(request);
+}
+
+void RevalidationScheduler::process() {
+    // Starting or resolving a revalidation may synchronously call back into the scheduler and
+    // change the queue, so we start over after each of them.
+    bool progress = true;
+    while (progress) {
+        progress = false;
+
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            Request& request = **it;
+            ZoomLevel* level = request.zoomLevel ? &zoomLevels[*request.zoomLevel] : nullptr;
+
+            if (level && level->unchanged) {
+                if (*level->unchanged->expires > util::now()) {
+                    // Another tile of this zoom level was found to be unchanged; assume the same
+                    // for this one. We still keep an underlying request around, so that the tile
+                    // is refreshed once it expires again.
+                    const Response unchanged = *level->unchanged;
+                    queue.erase(it);
+                    request.state = Request::State::Done;
+                    request.resource.priorExpires = unchanged.expires;
+                    request.request = fileSource.request(request.resource, [&request] (Response res) {
+                        request.respond(res);
+                    });
+                    request.respond(unchanged);
+                    progress = true;
+                    break;
+                }
+                level->unchanged = {};
+            }
+
+            if ((level && level->revalidating) || active >= policy.maximumConcurrentRevalidations) {
+                continue;
+            }
+
+            queue.erase(it);
+            start(request);
+            progress = true;
+            break;
+        }
+    }
+}
+
+void RevalidationScheduler::start(Request& request) {
+    request.state = Request::State::Active;
+    active++;
+
+    if (request.zoomLevel) {
+        zoomLevels[*request.zoomLevel].revalidating = true;
+    }
+
+    request.request = fileSource.request(request.resource, [this, &request] (Response res) {
+        const bool first = request.state == Request::State::Active;
+        if (first) {
+            completed(request, res);
+        }
+
+        // Responding may delete the request, but not the scheduler.
+        request.respond(res);
+
+        if (first) {
+            process();
+        }
+    });
+}
+
+void RevalidationScheduler::completed(Request& request, const Response& response) {
+    request.state = Request::State::Done;
+    active--;
+
+    if (request.zoomLevel) {
+        ZoomLevel& level = zoomLevels[*request.zoomLevel];
+        level.revalidating = false;
+
+        if (response.notModified && !response.error && response.expires && *response.expires > util::now()) {
+            // Only the expiration applies to other tiles; their etags and modification dates
+            // differ from this one's.
+            level.unchanged.emplace();
+            level.unchanged->notModified = true;
+            level.unchanged->expires = response.expires;
+            level.unchanged->mustRevalidate = response.mustRevalidate;
+        }
+    }
+}
+
+void RevalidationScheduler::remove(Request& request) {
+    switch (request.state) {
+    case Request::State::Queued:
+        queue.erase(request.position);
+        break;
+    case Request::State::Active:
+        request.state = Request::State::Done;
+        active--;
+        if (request.zoomLevel) {
+            zoomLevels[*request.zoomLevel].revalidating = false;
+        }
+        asyncProcess.send();
+        break;
+    case Request::State::Done:
+        break;
+    }
+
+    if (request.zoomLevel) {
+        auto it = zoomLevels.find(*request.zoomLevel);
+        assert(it != zoomLevels.end() && it->second.requests > 0);
+        if (--it->second.requests == 0) {
+            zoomLevels.erase(it);
+        }
+    }
+}
+
+} // namespace mbgl
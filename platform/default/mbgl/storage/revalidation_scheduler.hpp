@@ -0,0 +1,72 @@
+#pragma once
+
+#include <mbgl/storage/file_source.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/revalidation_policy.hpp>
+#include <mbgl/util/async_task.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace mbgl {
+
+/**
+ * Runs background revalidations of expired resources that have already been handed out from the
+ * cache, according to a RevalidationPolicy. Revalidations are queued and passed on to the
+ * underlying file source when a slot is available.
+ *
+ * @private
+ */
+class RevalidationScheduler : private util::noncopyable {
+public:
+    explicit RevalidationScheduler(FileSource&);
+    ~RevalidationScheduler();
+
+    void setPolicy(RevalidationPolicy);
+
+    // Returns whether a cached resource with the given expiration may be served right away and
+    // revalidated in the background.
+    bool acceptsStale(const optional<Timestamp>& expires) const;
+
+    // Revalidates the resource, which mustn't have prior data since the requestor already has the
+    // data. Like a file source request, the callback receives the result of the revalidation and
+    // any later updates for as long as the request is alive.
+    std::unique_ptr<AsyncRequest> revalidate(const Resource&, FileSource::Callback);
+
+private:
+    class Request;
+
+    struct ZoomLevel {
+        // Number of live requests for tiles of this zoom level. The zoom level is dropped once
+        // the last of them is gone.
+        uint32_t requests = 0;
+
+        // Whether the revalidation of one of the tiles is in progress.
+        bool revalidating = false;
+
+        // Set when a revalidated tile turned out to be unchanged, until the tile expires again.
+        optional<Response> unchanged;
+    };
+
+    void process();
+    void start(Request&);
+    void completed(Request&, const Response&);
+    void remove(Request&);
+
+    FileSource& fileSource;
+    RevalidationPolicy policy;
+
+    std::list<Request*> queue;
+    uint32_t active = 0;
+    std::unordered_map<std::string, ZoomLevel> zoomLevels;
+
+    // Requests are removed from their destructors, which may run while the scheduler is busy, so
+    // queued revalidations that they make room for are started later.
+    util::AsyncTask asyncProcess;
+};
+
+} // namespace mbgl
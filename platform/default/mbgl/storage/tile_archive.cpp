@@ -0,0 +1,273 @@
+#include <mbgl/storage/tile_archive.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mbgl {
+
+namespace {
+
+const std::size_t headerLength = 127;
+
+// Leaf directories may point to further leaf directories, but the spec limits the nesting.
+const int maxDirectoryDepth = 4;
+
+// Bounds the number of parsed leaf directories we hold on to.
+const std::size_t maxCachedLeaves = 64;
+
+template <typename T>
+T readLE(const char* bytes) {
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        value |= T(uint8_t(bytes[i])) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t readVarint(const char*& it, const char* end) {
+    uint64_t value = 0;
+    for (int shift = 0; it != end && shift < 64; shift += 7) {
+        const uint8_t byte = uint8_t(*it++);
+        value |= uint64_t(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("malformed tile archive directory");
+}
+
+// Returns the entry with the greatest tile ID that is less than or equal to the given ID.
+const TileArchive::Entry* findEntry(const TileArchive::Directory& directory, uint64_t tileID) {
+    auto it = std::upper_bound(directory.begin(), directory.end(), tileID,
+        [](uint64_t id, const TileArchive::Entry& entry) { return id < entry.tileID; });
+    if (it == directory.begin()) {
+        return nullptr;
+    }
+    return &*std::prev(it);
+}
+
+void checkRange(uint64_t offset, uint64_t length, std::size_t size) {
+    if (offset > size || length > size - offset) {
+        throw std::runtime_error("tile archive offset out of bounds");
+    }
+}
+
+} // namespace
+
+std::shared_ptr<const TileArchive> TileArchive::open(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Cannot open tile archive " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == -1 || info.st_size < off_t(headerLength)) {
+        ::close(fd);
+        throw std::runtime_error("Invalid tile archive " + path);
+    }
+
+    void* mapping = mmap(nullptr, std::size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed.
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map tile archive " + path + ": " + std::strerror(errno));
+    }
+
+    try {
+        return std::shared_ptr<const TileArchive>(
+            new TileArchive(reinterpret_cast<const char*>(mapping), std::size_t(info.st_size)));
+    } catch (...) {
+        munmap(mapping, std::size_t(info.st_size));
+        throw;
+    }
+}
+
+TileArchive::TileArchive(const char* bytes_, std::size_t length_)
+    : bytes(bytes_), length(length_) {
+    if (std::memcmp(bytes, "PMTiles", 7) != 0 || bytes[7] != 3) {
+        throw std::runtime_error("unsupported tile archive format");
+    }
+
+    header.rootOffset = readLE<uint64_t>(bytes + 8);
+    header.rootLength = readLE<uint64_t>(bytes + 16);
+    header.leafOffset = readLE<uint64_t>(bytes + 40);
+    header.leafLength = readLE<uint64_t>(bytes + 48);
+    header.dataOffset = readLE<uint64_t>(bytes + 56);
+    header.dataLength = readLE<uint64_t>(bytes + 64);
+    header.internalCompression = Compression(bytes[97]);
+    header.tileCompression = Compression(bytes[98]);
+    header.minZoom = uint8_t(bytes[100]);
+    header.maxZoom = uint8_t(bytes[101]);
+    for (std::size_t i = 0; i < 4; ++i) {
+        header.bounds[i] = readLE<int32_t>(bytes + 102 + 4 * i);
+    }
+    header.centerZoom = uint8_t(bytes[118]);
+    header.center[0] = readLE<int32_t>(bytes + 119);
+    header.center[1] = readLE<int32_t>(bytes + 123);
+
+    if (header.internalCompression != Compression::None &&
+        header.internalCompression != Compression::Gzip) {
+        throw std::runtime_error("unsupported tile archive directory compression");
+    }
+    if (header.tileCompression != Compression::Unknown &&
+        header.tileCompression != Compression::None &&
+        header.tileCompression != Compression::Gzip) {
+        throw std::runtime_error("unsupported tile archive tile compression");
+    }
+
+    checkRange(header.rootOffset, header.rootLength, length);
+    checkRange(header.leafOffset, header.leafLength, length);
+    checkRange(header.dataOffset, header.dataLength, length);
+
+    root = parseDirectory(bytes + header.rootOffset, header.rootLength);
+}
+
+TileArchive::~TileArchive() {
+    munmap(const_cast<char*>(bytes), length);
+}
+
+uint64_t TileArchive::tileID(uint8_t z, uint32_t x, uint32_t y) {
+    uint64_t id = ((uint64_t(1) << (2 * z)) - 1) / 3;
+    for (uint64_t s = z > 0 ? uint64_t(1) << (z - 1) : 0; s > 0; s >>= 1) {
+        const uint64_t rx = (x & s) ? 1 : 0;
+        const uint64_t ry = (y & s) ? 1 : 0;
+        id += s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = uint32_t(s - 1 - x);
+                y = uint32_t(s - 1 - y);
+            }
+            std::swap(x, y);
+        }
+    }
+    return id;
+}
+
+SharedBuffer TileArchive::getTile(uint8_t z, uint32_t x, uint32_t y) const {
+    if (z < header.minZoom || z > header.maxZoom || z > 31 || x >> z || y >> z) {
+        return {};
+    }
+
+    const uint64_t id = tileID(z, x, y);
+
+    std::shared_ptr<const Directory> leaf;
+    const Directory* directory = &root;
+    for (int depth = 0; depth < maxDirectoryDepth; ++depth) {
+        const Entry* entry = findEntry(*directory, id);
+        if (!entry) {
+            return {};
+        }
+
+        if (entry->runLength == 0) {
+            leaf = getLeafDirectory(entry->offset, entry->length);
+            directory = leaf.get();
+            continue;
+        }
+
+        if (id - entry->tileID >= entry->runLength) {
+            return {};
+        }
+
+        checkRange(entry->offset, entry->length, header.dataLength);
+        const char* tile = bytes + header.dataOffset + entry->offset;
+
+        if (header.tileCompression == Compression::Gzip) {
+            return std::make_shared<const std::string>(util::decompress(tile, entry->length));
+        }
+
+        // The tile is referenced in place; the buffer keeps the archive, and with it the
+        // mapping, alive for as long as the tile data is in use.
+        return SharedBuffer(shared_from_this(), tile, entry->length);
+    }
+
+    throw std::runtime_error("tile archive directories are nested too deeply");
+}
+
+std::string TileArchive::getTileJSON(const std::string& url) const {
+    auto degrees = [](int32_t e7) {
+        return util::toString(double(e7) / 1e7);
+    };
+
+    return std::string("{\"tilejson\":\"2.2.0\",\"tiles\":[\"") + url + "\"]," +
+        "\"minzoom\":" + util::toString(header.minZoom) + "," +
+        "\"maxzoom\":" + util::toString(header.maxZoom) + "," +
+        "\"bounds\":[" + degrees(header.bounds[0]) + "," + degrees(header.bounds[1]) + "," +
+                         degrees(header.bounds[2]) + "," + degrees(header.bounds[3]) + "]," +
+        "\"center\":[" + degrees(header.center[0]) + "," + degrees(header.center[1]) + "," +
+                         util::toString(header.centerZoom) + "]}";
+}
+
+std::shared_ptr<const TileArchive::Directory> TileArchive::getLeafDirectory(uint64_t offset, uint32_t length_) const {
+    std::lock_guard<std::mutex> lock(leafMutex);
+
+    auto it = leaves.find(offset);
+    if (it != leaves.end()) {
+        return it->second;
+    }
+
+    checkRange(offset, length_, header.leafLength);
+    auto leaf = std::make_shared<const Directory>(
+        parseDirectory(bytes + header.leafOffset + offset, length_));
+
+    if (leaves.size() >= maxCachedLeaves) {
+        leaves.clear();
+    }
+    leaves.emplace(offset, leaf);
+
+    return leaf;
+}
+
+std::string TileArchive::decompressInternal(const char* data, std::size_t size) const {
+    if (header.internalCompression == Compression::Gzip) {
+        return util::decompress(data, size);
+    }
+    return std::string(data, size);
+}
+
+TileArchive::Directory TileArchive::parseDirectory(const char* data, std::size_t size) const {
+    const std::string raw = decompressInternal(data, size);
+    const char* it = raw.data();
+    const char* end = raw.data() + raw.size();
+
+    const uint64_t count = readVarint(it, end);
+    if (count > raw.size()) {
+        // Every entry occupies at least four bytes, so this can't be a valid directory.
+        throw std::runtime_error("malformed tile archive directory");
+    }
+
+    Directory directory(count);
+
+    uint64_t lastID = 0;
+    for (auto& entry : directory) {
+        lastID += readVarint(it, end);
+        entry.tileID = lastID;
+    }
+    for (auto& entry : directory) {
+        entry.runLength = uint32_t(readVarint(it, end));
+    }
+    for (auto& entry : directory) {
+        entry.length = uint32_t(readVarint(it, end));
+    }
+    for (std::size_t i = 0; i < directory.size(); ++i) {
+        const uint64_t value = readVarint(it, end);
+        if (value == 0 && i > 0) {
+            // Zero indicates that the data directly follows the previous entry's data.
+            directory[i].offset = directory[i - 1].offset + directory[i - 1].length;
+        } else {
+            directory[i].offset = value - 1;
+        }
+    }
+
+    return directory;
+}
+
+} // namespace mbgl
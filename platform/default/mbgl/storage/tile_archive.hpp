@@ -0,0 +1,93 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/shared_buffer.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+/*
+ * A read-only, memory-mapped single-file tile archive in the PMTiles v3 format: a fixed-size
+ * header, a root directory, optional leaf directories and the tile data, ideally clustered in
+ * tile ID order. Tiles are looked up by binary search in the directory index, and uncompressed
+ * tiles are returned as views into the mapping that keep the mapping alive, so they reach the
+ * tile parsers without being copied.
+ *
+ * Directories are parsed lazily and cached; all methods are safe to call from any thread.
+ */
+class TileArchive : public std::enable_shared_from_this<TileArchive>,
+                    private util::noncopyable {
+public:
+    // Maps the archive at the given path. Throws if the file can't be mapped or isn't a supported
+    // archive.
+    static std::shared_ptr<const TileArchive> open(const std::string& path);
+
+    ~TileArchive();
+
+    // Returns the tile's bytes, or a null buffer when the archive doesn't contain the tile.
+    SharedBuffer getTile(uint8_t z, uint32_t x, uint32_t y) const;
+
+    // Returns a TileJSON document describing the archive's zoom range and bounds, with `url` as
+    // the only tile URL.
+    std::string getTileJSON(const std::string& url) const;
+
+    // PMTiles identifies tiles by their position along a Hilbert curve, counting all tiles of
+    // lower zoom levels first.
+    static uint64_t tileID(uint8_t z, uint32_t x, uint32_t y);
+
+    struct Entry {
+        uint64_t tileID;
+        uint64_t offset;
+        uint32_t length;
+        // Number of consecutive tile IDs that share this entry's data. Zero for entries that
+        // point to a leaf directory.
+        uint32_t runLength;
+    };
+
+    using Directory = std::vector<Entry>;
+
+private:
+    TileArchive(const char* bytes, std::size_t length);
+
+    std::shared_ptr<const Directory> getLeafDirectory(uint64_t offset, uint32_t length) const;
+    std::string decompressInternal(const char* bytes, std::size_t length) const;
+    Directory parseDirectory(const char* bytes, std::size_t length) const;
+
+    const char* const bytes;
+    const std::size_t length;
+
+    enum class Compression : uint8_t {
+        Unknown = 0,
+        None = 1,
+        Gzip = 2,
+    };
+
+    struct Header {
+        uint64_t rootOffset;
+        uint64_t rootLength;
+        uint64_t leafOffset;
+        uint64_t leafLength;
+        uint64_t dataOffset;
+        uint64_t dataLength;
+        Compression internalCompression;
+        Compression tileCompression;
+        uint8_t minZoom;
+        uint8_t maxZoom;
+        int32_t bounds[4];
+        uint8_t centerZoom;
+        int32_t center[2];
+    } header;
+
+    Directory root;
+
+    mutable std::mutex leafMutex;
+    mutable std::unordered_map<uint64_t, std::shared_ptr<const Directory>> leaves;
+};
+
+} // namespace mbgl
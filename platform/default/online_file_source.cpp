@@ -103,7 +103,7 @@ public:
         assert(activeRequests.find(request) == activeRequests.end());
         assert(!request->request);
 
-        if (activeRequests.size() >= HTTPFileSource::maximumConcurrentRequests()) {
+        if (activeRequests.size() >= httpFileSource.getConcurrencyLimit()) {
             queueRequest(request);
         } else {
             activateRequest(request);
@@ -139,17 +139,17 @@ public:
     }
 
     void activatePendingRequest() {
-        if (pendingRequestsList.empty()) {
-            return;
-        }
-
-        OnlineFileRequest* request = pendingRequestsList.front();
-        pendingRequestsList.pop_front();
+        // The concurrency limit may have been raised in the meantime, so fill up all free slots.
+        while (!pendingRequestsList.empty() &&
+               activeRequests.size() < httpFileSource.getConcurrencyLimit()) {
+            OnlineFileRequest* request = pendingRequestsList.front();
+            pendingRequestsList.pop_front();
 
-        pendingRequestsMap.erase(request);
+            pendingRequestsMap.erase(request);
 
-        activateRequest(request);
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
+            activateRequest(request);
+            assert(pendingRequestsMap.size() == pendingRequestsList.size());
+        }
     }
 
     bool isPending(OnlineFileRequest* request) {
@@ -169,6 +169,10 @@ public:
         networkIsReachableAgain();
     }
 
+    void setHTTPConnectionMode(HTTPConnectionMode mode) {
+        httpFileSource.setConnectionMode(mode);
+    }
+
 private:
     void networkIsReachableAgain() {
         for (auto& request : allRequests) {
@@ -242,6 +246,10 @@ void OnlineFileSource::setResourceTransform(optional<ActorRef<ResourceTransform>
     impl->setResourceTransform(std::move(transform));
 }
 
+void OnlineFileSource::setHTTPConnectionMode(HTTPConnectionMode mode) {
+    impl->setHTTPConnectionMode(mode);
+}
+
 OnlineFileRequest::OnlineFileRequest(Resource resource_, Callback callback_, OnlineFileSource::Impl& impl_)
     : impl(impl_),
       resource(std::move(resource_)),
@@ -0,0 +1,96 @@
+#include <mbgl/storage/tile_archive_file_source.hpp>
+#include <mbgl/storage/file_source_request.hpp>
+#include <mbgl/storage/tile_archive.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/thread.hpp>
+#include <mbgl/util/url.hpp>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <unordered_map>
+
+namespace {
+
+const char* protocol = "pmtiles://";
+const std::size_t protocolLength = 10;
+
+} // namespace
+
+namespace mbgl {
+
+class TileArchiveFileSource::Impl {
+public:
+    Impl(ActorRef<Impl>) {}
+
+    void request(const Resource& resource, ActorRef<FileSourceRequest> req) {
+        // Cut off the protocol and any query string.
+        const std::string url = resource.url.substr(0, resource.url.find('?'));
+        const std::string path = mbgl::util::percentDecode(url.substr(protocolLength));
+
+        Response response;
+
+        try {
+            auto archive = getArchive(path);
+            if (!archive) {
+                response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
+            } else if (resource.kind == Resource::Kind::Tile && resource.tileData) {
+                const Resource::TileData& tile = *resource.tileData;
+                response.data = archive->getTile(tile.z, tile.x, tile.y);
+                if (!response.data) {
+                    response.noContent = true;
+                }
+            } else {
+                response.data = std::make_shared<const std::string>(archive->getTileJSON(url));
+            }
+        } catch (...) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other,
+                util::toString(std::current_exception()));
+        }
+
+        req.invoke(&FileSourceRequest::setResponse, response);
+    }
+
+private:
+    std::shared_ptr<const TileArchive> getArchive(const std::string& path) {
+        auto it = archives.find(path);
+        if (it != archives.end()) {
+            return it->second;
+        }
+
+        struct stat buf;
+        int result = stat(path.c_str(), &buf);
+        if ((result == 0 && S_ISDIR(buf.st_mode)) || (result == -1 && errno == ENOENT)) {
+            return nullptr;
+        }
+
+        // Archives stay mapped for the lifetime of the file source; tiles handed out keep their
+        // archive alive on their own.
+        return archives.emplace(path, TileArchive::open(path)).first->second;
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<const TileArchive>> archives;
+};
+
+TileArchiveFileSource::TileArchiveFileSource()
+    : impl(std::make_unique<util::Thread<Impl>>("TileArchiveFileSource")) {
+}
+
+TileArchiveFileSource::~TileArchiveFileSource() = default;
+
+std::unique_ptr<AsyncRequest> TileArchiveFileSource::request(const Resource& resource, Callback callback) {
+    auto req = std::make_unique<FileSourceRequest>(std::move(callback));
+
+    impl->actor().invoke(&Impl::request, resource, req->actor());
+
+    return std::move(req);
+}
+
+bool TileArchiveFileSource::acceptsURL(const std::string& url) {
+    return url.compare(0, protocolLength, protocol) == 0;
+}
+
+} // namespace mbgl
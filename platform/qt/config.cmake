@@ -65,6 +65,7 @@ endmacro()
 
 macro(mbgl_platform_test)
     target_sources(mbgl-test
+        PRIVATE platform/qt/test/local_glyph_rasterizer.test.cpp
         PRIVATE platform/qt/test/main.cpp
         PRIVATE platform/qt/test/qmapboxgl.test.cpp
         PRIVATE platform/qt/test/qmapboxgl.test.cpp
@@ -36,6 +36,7 @@ set(MBGL_QT_CORE_FILES
     # Platform integration
     PRIVATE platform/qt/src/async_task.cpp
     PRIVATE platform/qt/src/async_task_impl.hpp
+    PRIVATE platform/qt/src/local_glyph_rasterizer.cpp
     PRIVATE platform/qt/src/qt_image.cpp
     PRIVATE platform/qt/src/run_loop.cpp
     PRIVATE platform/qt/src/run_loop_impl.hpp
@@ -108,4 +108,16 @@ uint32_t HTTPFileSource::maximumConcurrentRequests() {
 #endif
 }
 
+void HTTPFileSource::setConnectionMode(HTTPConnectionMode) {
+    // Not supported by the Qt backend; requests always use the default connection handling.
+}
+
+bool HTTPFileSource::supportsConnectionModes() {
+    return false;
+}
+
+uint32_t HTTPFileSource::getConcurrencyLimit() const {
+    return maximumConcurrentRequests();
+}
+
 } // namespace mbgl
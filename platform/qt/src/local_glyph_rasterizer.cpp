@@ -0,0 +1,83 @@
+#include <mbgl/text/local_glyph_rasterizer.hpp>
+#include <mbgl/util/i18n.hpp>
+
+#include <QColor>
+#include <QFont>
+#include <QImage>
+#include <QPainter>
+#include <QString>
+
+namespace mbgl {
+
+namespace {
+
+// Ideographs are drawn into a square the size of a glyph in the SDF glyph ranges, and get the
+// same metrics as in the JavaScript implementation.
+constexpr int glyphSize = 24;
+
+} // namespace
+
+class LocalGlyphRasterizer::Impl {
+public:
+    Impl(const optional<std::string>& fontFamily_)
+        : fontFamily(fontFamily_) {
+        if (fontFamily) {
+            font.setFamily(QString::fromStdString(*fontFamily));
+            font.setPixelSize(glyphSize);
+        }
+    }
+
+    const optional<std::string> fontFamily;
+    QFont font;
+};
+
+LocalGlyphRasterizer::LocalGlyphRasterizer(const optional<std::string>& fontFamily)
+    : impl(std::make_unique<Impl>(fontFamily)) {
+}
+
+LocalGlyphRasterizer::~LocalGlyphRasterizer() = default;
+
+bool LocalGlyphRasterizer::canRasterizeGlyph(const FontStack&, GlyphID glyphID) const {
+    return impl->fontFamily && util::i18n::isIdeograph(glyphID);
+}
+
+Glyph LocalGlyphRasterizer::rasterizeGlyph(const FontStack& fontStack, GlyphID glyphID) {
+    // The font stack names fonts of the glyph server, which aren't installed locally. Only carry
+    // over their weight.
+    QFont font = impl->font;
+    for (const auto& name : fontStack) {
+        if (name.find("Bold") != std::string::npos) {
+            font.setBold(true);
+        }
+    }
+
+    QImage image(glyphSize, glyphSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.setFont(font);
+    painter.setPen(Qt::white);
+    painter.setRenderHints(QPainter::TextAntialiasing);
+    painter.drawText(QRect(0, 0, glyphSize, glyphSize), Qt::AlignCenter, QString(QChar(glyphID)));
+    painter.end();
+
+    Glyph glyph;
+    glyph.id = glyphID;
+    glyph.metrics.width = glyphSize;
+    glyph.metrics.height = glyphSize;
+    glyph.metrics.left = 0;
+    glyph.metrics.top = -8;
+    glyph.metrics.advance = glyphSize;
+
+    glyph.bitmap = AlphaImage({ glyphSize, glyphSize });
+    for (int y = 0; y < glyphSize; y++) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        for (int x = 0; x < glyphSize; x++) {
+            glyph.bitmap.data[y * glyphSize + x] = qAlpha(line[x]);
+        }
+    }
+
+    return glyph;
+}
+
+} // namespace mbgl
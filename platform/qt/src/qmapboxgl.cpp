@@ -1273,7 +1273,7 @@ void QMapboxGL::updateSource(const QString &id, const QVariantMap &params)
         Error error;
         auto result = convert<mbgl::GeoJSON>(params["data"], error);
         if (result) {
-            sourceGeoJSON->setGeoJSON(*result);
+            sourceGeoJSON->setGeoJSON(std::move(*result));
         }
     }
 }
@@ -24,9 +24,8 @@ PremultipliedImage decodeJPEG(const uint8_t*, size_t);
 PremultipliedImage decodeWebP(const uint8_t*, size_t);
 #endif
 
-PremultipliedImage decodeImage(const std::string& string) {
-    const uint8_t* data = reinterpret_cast<const uint8_t*>(string.data());
-    const size_t size = string.size();
+PremultipliedImage decodeImage(const char* bytes, std::size_t size) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(bytes);
 
 #if !defined(QT_IMAGE_DECODERS)
     if (size >= 12) {
@@ -0,0 +1,56 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/local_glyph_rasterizer.hpp>
+
+#include <QFontDatabase>
+
+#include <algorithm>
+
+using namespace mbgl;
+
+namespace {
+
+// The test doesn't depend on the fonts installed on the machine: it draws with a bundled font.
+const char* bundledFont() {
+    static const int id =
+        QFontDatabase::addApplicationFont("test/fixtures/local_glyph_rasterizer/Roboto-Regular.ttf");
+    EXPECT_NE(-1, id);
+    return "Roboto";
+}
+
+} // namespace
+
+TEST(LocalGlyphRasterizer, CanRasterizeIdeographs) {
+    LocalGlyphRasterizer rasterizer(std::string(bundledFont()));
+    EXPECT_TRUE(rasterizer.canRasterizeGlyph({ "Open Sans Regular" }, u'中'));
+    EXPECT_FALSE(rasterizer.canRasterizeGlyph({ "Open Sans Regular" }, u'A'));
+
+    LocalGlyphRasterizer withoutFont;
+    EXPECT_FALSE(withoutFont.canRasterizeGlyph({ "Open Sans Regular" }, u'中'));
+}
+
+TEST(LocalGlyphRasterizer, Rasterize) {
+    LocalGlyphRasterizer rasterizer(std::string(bundledFont()));
+
+    // The bundled font has no ideographs, but any glyph of it takes the same path.
+    const Glyph regular = rasterizer.rasterizeGlyph({ "Open Sans Regular" }, u'A');
+    EXPECT_EQ(GlyphID(u'A'), regular.id);
+    EXPECT_EQ(24u, regular.metrics.width);
+    EXPECT_EQ(24u, regular.metrics.height);
+    EXPECT_EQ(24u, regular.metrics.advance);
+    ASSERT_EQ(Size(24, 24), regular.bitmap.size);
+
+    // The glyph is drawn, and doesn't cover the whole square.
+    const auto begin = regular.bitmap.data.get();
+    const auto end = begin + regular.bitmap.bytes();
+    EXPECT_LT(128, *std::max_element(begin, end));
+    EXPECT_EQ(0, *std::min_element(begin, end));
+    const auto covered = std::count_if(begin, end, [] (uint8_t alpha) { return alpha > 0; });
+
+    // Bold font stacks are drawn with a heavier weight, which covers more of the square.
+    const Glyph bold = rasterizer.rasterizeGlyph({ "Open Sans Bold" }, u'A');
+    ASSERT_EQ(Size(24, 24), bold.bitmap.size);
+    const auto boldBegin = bold.bitmap.data.get();
+    EXPECT_GT(std::count_if(boldBegin, boldBegin + bold.bitmap.bytes(), [] (uint8_t alpha) { return alpha > 0; }),
+              covered);
+}
@@ -9,9 +9,14 @@
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/storage/file_source.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
 
 #include <boost/function_output_iterator.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace mbgl {
 
 using namespace style;
@@ -39,7 +44,6 @@ AnnotationID AnnotationManager::addAnnotation(const Annotation& annotation, cons
     Annotation::visit(annotation, [&] (const auto& annotation_) {
         this->add(id, annotation_, maxZoom);
     });
-    dirty = true;
     return id;
 }
 
@@ -48,31 +52,96 @@ bool AnnotationManager::updateAnnotation(const AnnotationID& id, const Annotatio
     Annotation::visit(annotation, [&] (const auto& annotation_) {
         this->update(id, annotation_, maxZoom);
     });
-    return dirty;
+    return !dirtyRegions.empty();
 }
 
 void AnnotationManager::removeAnnotation(const AnnotationID& id) {
     std::lock_guard<std::mutex> lock(mutex);
     remove(id);
-    dirty = true;
+}
+
+static LatLngBounds symbolBounds(const SymbolAnnotation& annotation) {
+    return LatLngBounds::singleton({ annotation.geometry.y, annotation.geometry.x });
+}
+
+AnnotationIDs AnnotationManager::addAnnotations(const std::vector<Annotation>& annotations, const uint8_t maxZoom) {
+    std::lock_guard<std::mutex> lock(mutex);
+    AnnotationIDs ids;
+    ids.reserve(annotations.size());
+
+    // Symbols are added to the tree together. Each of them marks its own area as changed, since a
+    // single area around all of them could cover most of the world.
+    std::vector<std::shared_ptr<const SymbolAnnotationImpl>> symbols;
+    const std::size_t existingSymbols = symbolTree.size();
+
+    for (const auto& annotation : annotations) {
+        const AnnotationID id = nextID++;
+        ids.push_back(id);
+        if (annotation.is<SymbolAnnotation>()) {
+            auto impl = std::make_shared<SymbolAnnotationImpl>(id, annotation.get<SymbolAnnotation>());
+            markDirty(symbolBounds(impl->annotation));
+            symbolAnnotations.emplace(id, impl);
+            symbols.push_back(std::move(impl));
+        } else {
+            Annotation::visit(annotation, [&] (const auto& annotation_) {
+                this->add(id, annotation_, maxZoom);
+            });
+        }
+    }
+
+    if (symbols.size() < existingSymbols) {
+        symbolTree.insert(symbols.begin(), symbols.end());
+    } else {
+        rebuildSymbolTree();
+    }
+
+    return ids;
+}
+
+void AnnotationManager::removeAnnotations(const AnnotationIDs& ids) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<std::shared_ptr<const SymbolAnnotationImpl>> symbols;
+
+    for (const AnnotationID id : ids) {
+        auto it = symbolAnnotations.find(id);
+        if (it != symbolAnnotations.end()) {
+            markDirty(symbolBounds(it->second->annotation));
+            symbols.push_back(it->second);
+            symbolAnnotations.erase(it);
+        } else {
+            remove(id);
+        }
+    }
+
+    if (symbols.size() < symbolAnnotations.size()) {
+        symbolTree.remove(symbols.begin(), symbols.end());
+    } else {
+        rebuildSymbolTree();
+    }
 }
 
 void AnnotationManager::add(const AnnotationID& id, const SymbolAnnotation& annotation, const uint8_t) {
     auto impl = std::make_shared<SymbolAnnotationImpl>(id, annotation);
     symbolTree.insert(impl);
     symbolAnnotations.emplace(id, impl);
+    markDirty(symbolBounds(annotation));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const LineAnnotation& annotation, const uint8_t maxZoom) {
     ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
         std::make_unique<LineAnnotationImpl>(id, annotation, maxZoom)).first->second;
     impl.updateStyle(*style.get().impl);
+    shapeIndex.add(impl);
+    markDirty(impl.bounds());
 }
 
 void AnnotationManager::add(const AnnotationID& id, const FillAnnotation& annotation, const uint8_t maxZoom) {
     ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
         std::make_unique<FillAnnotationImpl>(id, annotation, maxZoom)).first->second;
     impl.updateStyle(*style.get().impl);
+    shapeIndex.add(impl);
+    markDirty(impl.bounds());
 }
 
 void AnnotationManager::update(const AnnotationID& id, const SymbolAnnotation& annotation, const uint8_t maxZoom) {
@@ -85,8 +154,6 @@ void AnnotationManager::update(const AnnotationID& id, const SymbolAnnotation& a
     const SymbolAnnotation& existing = it->second->annotation;
 
     if (existing.geometry != annotation.geometry || existing.icon != annotation.icon) {
-        dirty = true;
-
         remove(id);
         add(id, annotation, maxZoom);
     }
@@ -99,9 +166,10 @@ void AnnotationManager::update(const AnnotationID& id, const LineAnnotation& ann
         return;
     }
 
+    markDirty(it->second->bounds());
+    shapeIndex.remove(*it->second);
     shapeAnnotations.erase(it);
     add(id, annotation, maxZoom);
-    dirty = true;
 }
 
 void AnnotationManager::update(const AnnotationID& id, const FillAnnotation& annotation, const uint8_t maxZoom) {
@@ -111,17 +179,21 @@ void AnnotationManager::update(const AnnotationID& id, const FillAnnotation& ann
         return;
     }
 
+    markDirty(it->second->bounds());
+    shapeIndex.remove(*it->second);
     shapeAnnotations.erase(it);
     add(id, annotation, maxZoom);
-    dirty = true;
 }
 
 void AnnotationManager::remove(const AnnotationID& id) {
     if (symbolAnnotations.find(id) != symbolAnnotations.end()) {
+        markDirty(symbolBounds(symbolAnnotations.at(id)->annotation));
         symbolTree.remove(symbolAnnotations.at(id));
         symbolAnnotations.erase(id);
     } else if (shapeAnnotations.find(id) != shapeAnnotations.end()) {
         auto it = shapeAnnotations.find(id);
+        markDirty(it->second->bounds());
+        shapeIndex.remove(*it->second);
         *style.get().impl->removeLayer(it->second->layerID);
         shapeAnnotations.erase(it);
     } else {
@@ -129,6 +201,16 @@ void AnnotationManager::remove(const AnnotationID& id) {
     }
 }
 
+void AnnotationManager::rebuildSymbolTree() {
+    std::vector<std::shared_ptr<const SymbolAnnotationImpl>> values;
+    values.reserve(symbolAnnotations.size());
+    for (const auto& entry : symbolAnnotations) {
+        values.push_back(entry.second);
+    }
+    // The range constructor packs the values into the tree with a bulk-loading algorithm.
+    symbolTree = SymbolAnnotationTree(values.begin(), values.end());
+}
+
 std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const CanonicalTileID& tileID) {
     if (symbolAnnotations.empty() && shapeAnnotations.empty())
         return nullptr;
@@ -144,9 +226,7 @@ std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const Canonic
             val->updateLayer(tileID, *pointLayer);
         }));
 
-    for (const auto& shape : shapeAnnotations) {
-        shape.second->updateTileData(tileID, *tileData);
-    }
+    shapeIndex.updateTileData(tileID, *tileData);
 
     return tileData;
 }
@@ -184,14 +264,70 @@ void AnnotationManager::updateStyle() {
     }
 }
 
+void AnnotationManager::markDirty(const LatLngBounds& bounds) {
+    if (!bounds.valid()) {
+        return;
+    }
+
+    // Regions are kept in world coordinates, so that updateData can check them against tiles of
+    // any zoom level without projecting them again.
+    auto project = [] (double latitude, double longitude) {
+        return TileCoordinate::fromLatLng(0, LatLng(util::clamp(latitude, -util::LATITUDE_MAX, util::LATITUDE_MAX), longitude)).p;
+    };
+    const Point<double> northwest = project(bounds.north(), bounds.west());
+    const Point<double> southeast = project(bounds.south(), bounds.east());
+
+    DirtyRegion region { northwest.x, northwest.y, southeast.x, southeast.y };
+    if (region.x2 - region.x1 >= 1) {
+        // The region covers every longitude.
+        region.x1 = 0;
+        region.x2 = 1;
+    } else {
+        // Move the region into the world copy that contains its western edge.
+        const double shift = std::floor(region.x1);
+        region.x1 -= shift;
+        region.x2 -= shift;
+    }
+    dirtyRegions.push_back(region);
+}
+
+bool AnnotationManager::intersects(const DirtyRegion& region, const CanonicalTileID& tileID) {
+    // Shape annotation tiles include geometry from a buffer around their edges, and geometry that
+    // crosses the antimeridian appears in the tiles of the neighbouring world copies.
+    const double scale = std::pow(2.0, tileID.z);
+    const double buffer = double(ShapeAnnotationImpl::tileBuffer) / util::EXTENT;
+    const double x1 = (tileID.x - buffer) / scale;
+    const double y1 = (tileID.y - buffer) / scale;
+    const double x2 = (tileID.x + 1 + buffer) / scale;
+    const double y2 = (tileID.y + 1 + buffer) / scale;
+
+    if (region.y1 > y2 || region.y2 < y1) {
+        return false;
+    }
+    for (const double wrap : { -1.0, 0.0, 1.0 }) {
+        if (region.x1 + wrap <= x2 && region.x2 + wrap >= x1) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void AnnotationManager::updateData() {
     std::lock_guard<std::mutex> lock(mutex);
-    if (dirty) {
-        for (auto& tile : tiles) {
-            tile->setData(getTileData(tile->id.canonical));
+    if (dirtyRegions.empty()) {
+        return;
+    }
+
+    // All changes made since the last frame are applied at once, and only tiles that overlap a
+    // changed area are regenerated.
+    for (auto& tile : tiles) {
+        const CanonicalTileID& tileID = tile->id.canonical;
+        if (std::any_of(dirtyRegions.begin(), dirtyRegions.end(),
+                        [&] (const DirtyRegion& region) { return intersects(region, tileID); })) {
+            tile->setData(getTileData(tileID));
         }
-        dirty = false;
     }
+    dirtyRegions.clear();
 }
 
 void AnnotationManager::addTile(AnnotationTile& tile) {
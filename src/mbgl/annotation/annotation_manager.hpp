@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/annotation/shape_annotation_index.hpp>
 #include <mbgl/annotation/symbol_annotation_impl.hpp>
 #include <mbgl/style/image.hpp>
 #include <mbgl/util/noncopyable.hpp>
@@ -32,6 +33,9 @@ public:
     bool updateAnnotation(const AnnotationID&, const Annotation&, const uint8_t maxZoom);
     void removeAnnotation(const AnnotationID&);
 
+    AnnotationIDs addAnnotations(const std::vector<Annotation>&, const uint8_t maxZoom);
+    void removeAnnotations(const AnnotationIDs&);
+
     void addImage(std::unique_ptr<style::Image>);
     void removeImage(const std::string&);
     double getTopOffsetPixelsForImage(const std::string&);
@@ -58,16 +62,32 @@ private:
 
     void remove(const AnnotationID&);
 
+    // Bulk-loads the symbol tree with all symbol annotations, which is faster than inserting or
+    // removing many of them one at a time, and produces a better tree.
+    void rebuildSymbolTree();
+
     void updateStyle();
 
+    // An area whose annotations changed since the last updateData call, in world coordinates
+    // (the unit square at zoom level 0).
+    struct DirtyRegion {
+        double x1;
+        double y1;
+        double x2;
+        double y2;
+    };
+
+    void markDirty(const LatLngBounds&);
+    static bool intersects(const DirtyRegion&, const CanonicalTileID&);
+
     std::unique_ptr<AnnotationTileData> getTileData(const CanonicalTileID&);
 
     std::reference_wrapper<style::Style> style;
 
     std::mutex mutex;
 
-    bool dirty = false;
-    
+    std::vector<DirtyRegion> dirtyRegions;
+
     AnnotationID nextID = 0;
 
     using SymbolAnnotationTree = boost::geometry::index::rtree<std::shared_ptr<const SymbolAnnotationImpl>, boost::geometry::index::rstar<16, 4>>;
@@ -80,6 +100,7 @@ private:
     SymbolAnnotationTree symbolTree;
     SymbolAnnotationMap symbolAnnotations;
     ShapeAnnotationMap shapeAnnotations;
+    ShapeAnnotationIndex shapeIndex;
     ImageMap images;
 
     std::unordered_set<AnnotationTile*> tiles;
@@ -63,8 +63,17 @@ std::unordered_map<std::string, std::vector<Feature>>
 RenderAnnotationSource::queryRenderedFeatures(const ScreenLineString& geometry,
                                               const TransformState& transformState,
                                               const std::vector<const RenderLayer*>& layers,
-                                              const RenderedQueryOptions& options) const {
-    return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options);
+                                              const RenderedQueryOptions& options,
+                                              Scheduler* scheduler) const {
+    return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, scheduler);
+}
+
+void RenderAnnotationSource::queryRenderedFeatureBatch(QueryBatch& batch,
+                                                       const std::vector<ScreenLineString>& geometries,
+                                                       const TransformState& transformState,
+                                                       const std::vector<const RenderLayer*>& layers,
+                                                       const RenderedQueryOptions& options) const {
+    tilePyramid.queryRenderedFeatureBatch(batch, geometries, transformState, layers, options);
 }
 
 std::vector<Feature> RenderAnnotationSource::querySourceFeatures(const SourceQueryOptions&) const {
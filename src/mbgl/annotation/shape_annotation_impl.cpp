@@ -6,11 +6,11 @@
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/geometry.hpp>
+#include <mbgl/util/geo.hpp>
 
 namespace mbgl {
 
 using namespace style;
-namespace geojsonvt = mapbox::geojsonvt;
 
 ShapeAnnotationImpl::ShapeAnnotationImpl(const AnnotationID id_, const uint8_t maxZoom_)
     : id(id_),
@@ -18,43 +18,28 @@ ShapeAnnotationImpl::ShapeAnnotationImpl(const AnnotationID id_, const uint8_t m
       layerID("com.mapbox.annotations.shape." + util::toString(id)) {
 }
 
-void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, AnnotationTileData& data) {
-    static const double baseTolerance = 4;
-
-    if (!shapeTiler) {
-        mapbox::geometry::feature_collection<double> features;
-        features.emplace_back(ShapeAnnotationGeometry::visit(geometry(), [] (auto&& geom) {
-            return Feature { std::move(geom) };
-        }));
-        mapbox::geojsonvt::Options options;
-        options.maxZoom = maxZoom;
-        options.buffer = 255u;
-        options.extent = util::EXTENT;
-        options.tolerance = baseTolerance;
-        shapeTiler = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(features, options);
-    }
-
-    const auto& shapeTile = shapeTiler->getTile(tileID.z, tileID.x, tileID.y);
-    if (shapeTile.features.empty())
-        return;
-
-    auto layer = data.addLayer(layerID);
+void ShapeAnnotationImpl::updateTileData(const mapbox::geometry::geometry<int16_t>& tileGeometry, AnnotationTileData& data) const {
+    FeatureType featureType = apply_visitor(ToFeatureType(), tileGeometry);
+    GeometryCollection renderGeometry = apply_visitor(ToGeometryCollection(), tileGeometry);
 
-    ToGeometryCollection toGeometryCollection;
-    ToFeatureType toFeatureType;
-    for (const auto& shapeFeature : shapeTile.features) {
-        FeatureType featureType = apply_visitor(toFeatureType, shapeFeature.geometry);
-        GeometryCollection renderGeometry = apply_visitor(toGeometryCollection, shapeFeature.geometry);
+    assert(featureType != FeatureType::Unknown);
 
-        assert(featureType != FeatureType::Unknown);
+    // https://github.com/mapbox/geojson-vt-cpp/issues/44
+    if (featureType == FeatureType::Polygon) {
+        renderGeometry = fixupPolygons(renderGeometry);
+    }
 
-        // https://github.com/mapbox/geojson-vt-cpp/issues/44
-        if (featureType == FeatureType::Polygon) {
-            renderGeometry = fixupPolygons(renderGeometry);
-        }
+    data.addLayer(layerID)->addFeature(id, featureType, renderGeometry);
+}
 
-        layer->addFeature(id, featureType, renderGeometry);
-    }
+LatLngBounds ShapeAnnotationImpl::bounds() const {
+    LatLngBounds result = LatLngBounds::empty();
+    ShapeAnnotationGeometry::visit(geometry(), [&] (const auto& geom) {
+        mapbox::geometry::for_each_point(geom, [&] (const Point<double>& point) {
+            result.extend(LatLng(util::clamp(point.y, -90.0, 90.0), point.x));
+        });
+    });
+    return result;
 }
 
 } // namespace mbgl
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <mbgl/util/string.hpp>
-#include <mapbox/geojsonvt.hpp>
 
 #include <mbgl/annotation/annotation.hpp>
 #include <mbgl/util/geometry.hpp>
@@ -13,7 +12,7 @@
 namespace mbgl {
 
 class AnnotationTileData;
-class CanonicalTileID;
+class LatLngBounds;
 
 class ShapeAnnotationImpl {
 public:
@@ -23,12 +22,18 @@ public:
     virtual void updateStyle(style::Style::Impl&) const = 0;
     virtual const ShapeAnnotationGeometry& geometry() const = 0;
 
-    void updateTileData(const CanonicalTileID&, AnnotationTileData&);
+    // Adds the part of the geometry that falls within a tile, as tiled by ShapeAnnotationIndex.
+    void updateTileData(const mapbox::geometry::geometry<int16_t>&, AnnotationTileData&) const;
+
+    // The bounds of the geometry, with latitudes clamped to ±90°. Longitudes are not wrapped.
+    LatLngBounds bounds() const;
+
+    // Tiles include the parts of the geometry within this many tile units of their edges.
+    static constexpr uint16_t tileBuffer = 255;
 
     const AnnotationID id;
     const uint8_t maxZoom;
     const std::string layerID;
-    std::unique_ptr<mapbox::geojsonvt::GeoJSONVT> shapeTiler;
 };
 
 struct CloseShapeAnnotation {
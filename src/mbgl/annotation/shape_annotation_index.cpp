@@ -0,0 +1,84 @@
+#include <mbgl/annotation/shape_annotation_index.hpp>
+#include <mbgl/annotation/shape_annotation_impl.hpp>
+#include <mbgl/annotation/annotation_tile.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <cassert>
+
+namespace mbgl {
+
+ShapeAnnotationIndex::ShapeAnnotationIndex(std::size_t groupSize_)
+    : groupSize(groupSize_) {
+    assert(groupSize > 0);
+}
+
+ShapeAnnotationIndex::~ShapeAnnotationIndex() = default;
+
+void ShapeAnnotationIndex::add(const ShapeAnnotationImpl& shape) {
+    assert(groupIndices.find(shape.id) == groupIndices.end());
+
+    std::size_t index = 0;
+    while (index < groups.size() &&
+           (groups[index].maxZoom != shape.maxZoom || groups[index].shapes.size() >= groupSize)) {
+        ++index;
+    }
+    if (index == groups.size()) {
+        groups.push_back({ shape.maxZoom, {}, nullptr });
+    }
+
+    Group& group = groups[index];
+    group.shapes.emplace(shape.id, &shape);
+    group.tiler.reset();
+    groupIndices.emplace(shape.id, index);
+}
+
+void ShapeAnnotationIndex::remove(const ShapeAnnotationImpl& shape) {
+    auto it = groupIndices.find(shape.id);
+    if (it == groupIndices.end()) {
+        assert(false); // Attempt to remove a shape that was never added
+        return;
+    }
+
+    Group& group = groups[it->second];
+    group.shapes.erase(shape.id);
+    group.tiler.reset();
+    groupIndices.erase(it);
+}
+
+void ShapeAnnotationIndex::updateTileData(const CanonicalTileID& tileID, AnnotationTileData& data) {
+    static const double baseTolerance = 4;
+
+    for (auto& group : groups) {
+        if (group.shapes.empty()) {
+            continue;
+        }
+
+        if (!group.tiler) {
+            mapbox::geometry::feature_collection<double> features;
+            features.reserve(group.shapes.size());
+            for (const auto& entry : group.shapes) {
+                features.emplace_back(ShapeAnnotationGeometry::visit(entry.second->geometry(), [] (auto&& geom) {
+                    return Feature { std::move(geom) };
+                }));
+                features.back().id = uint64_t(entry.first);
+            }
+            mapbox::geojsonvt::Options options;
+            options.maxZoom = group.maxZoom;
+            options.buffer = ShapeAnnotationImpl::tileBuffer;
+            options.extent = util::EXTENT;
+            options.tolerance = baseTolerance;
+            group.tiler = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(features, options);
+        }
+
+        for (const auto& shapeFeature : group.tiler->getTile(tileID.z, tileID.x, tileID.y).features) {
+            assert(shapeFeature.id && shapeFeature.id->is<uint64_t>());
+            auto shape = group.shapes.find(AnnotationID(shapeFeature.id->get<uint64_t>()));
+            if (shape != group.shapes.end()) {
+                shape->second->updateTileData(shapeFeature.geometry, data);
+            }
+        }
+    }
+}
+
+} // namespace mbgl
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <mbgl/annotation/annotation.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <mapbox/geojsonvt.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+class AnnotationTileData;
+class CanonicalTileID;
+class ShapeAnnotationImpl;
+
+/*
+    ShapeAnnotationIndex tiles the geometries of line and fill annotations. Rather than giving
+    every annotation its own geojson-vt index, annotations are kept in groups of up to `groupSize`
+    shapes with the same maximum zoom level, and each group is tiled by a single index whose
+    features carry the ID of the annotation they belong to.
+
+    Adding or removing an annotation only invalidates the index of its group, which is built again
+    the next time a tile is requested. The index refers to the annotations it contains; they must
+    be removed before they are destroyed.
+*/
+class ShapeAnnotationIndex : private util::noncopyable {
+public:
+    static constexpr std::size_t defaultGroupSize = 256;
+
+    ShapeAnnotationIndex(std::size_t groupSize = defaultGroupSize);
+    ~ShapeAnnotationIndex();
+
+    void add(const ShapeAnnotationImpl&);
+    void remove(const ShapeAnnotationImpl&);
+
+    // Adds a layer for each annotation that appears in the tile.
+    void updateTileData(const CanonicalTileID&, AnnotationTileData&);
+
+    std::size_t groupCount() const { return groups.size(); }
+
+private:
+    struct Group {
+        uint8_t maxZoom;
+        std::map<AnnotationID, const ShapeAnnotationImpl*> shapes;
+        std::unique_ptr<mapbox::geojsonvt::GeoJSONVT> tiler;
+    };
+
+    const std::size_t groupSize;
+
+    // Groups are never erased, so that their positions stay valid; empty groups are reused.
+    std::vector<Group> groups;
+    std::unordered_map<AnnotationID, std::size_t> groupIndices;
+};
+
+} // namespace mbgl
@@ -12,6 +12,7 @@
 
 #include <mapbox/geometry/envelope.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <string>
 
@@ -31,8 +32,12 @@ void FeatureIndex::insert(const GeometryCollection& geometries,
     }
 }
 
-static bool topDown(const IndexedSubfeature& a, const IndexedSubfeature& b) {
-    return a.sortIndex > b.sortIndex;
+void FeatureIndex::finish() {
+    grid.finish();
+}
+
+static bool topDown(const IndexedSubfeature* a, const IndexedSubfeature* b) {
+    return a->sortIndex > b->sortIndex;
 }
 
 static bool topDownSymbols(const IndexedSubfeature& a, const IndexedSubfeature& b) {
@@ -51,25 +56,88 @@ void FeatureIndex::query(
         const std::vector<const RenderLayer*>& layers,
         const CollisionTile* collisionTile,
         const float additionalQueryRadius) const {
+    query([&] (std::size_t, const std::string& layerID, const IndexedSubfeature&, const GeometryTileFeature& feature) {
+              result[layerID].push_back(convertFeature(feature, tileID));
+          },
+          { queryGeometry }, bearing, tileSize, scale, queryOptions, geometryTileData, tileID, layers,
+          collisionTile, additionalQueryRadius);
+}
+
+void FeatureIndex::query(
+        const HitCallback& hit,
+        const std::vector<GeometryCoordinates>& queryGeometries,
+        const float bearing,
+        const double tileSize,
+        const double scale,
+        const RenderedQueryOptions& queryOptions,
+        const GeometryTileData& geometryTileData,
+        const CanonicalTileID& tileID,
+        const std::vector<const RenderLayer*>& layers,
+        const CollisionTile* collisionTile,
+        const float additionalQueryRadius) const {
+    using BBox = GridIndex<IndexedSubfeature>::BBox;
 
     // Determine query radius
     const float pixelsToTileUnits = util::EXTENT / tileSize / scale;
     const int16_t additionalRadius = std::min<int16_t>(util::EXTENT, additionalQueryRadius * pixelsToTileUnits);
 
-    // Query the grid index
-    mapbox::geometry::box<int16_t> box = mapbox::geometry::envelope(queryGeometry);
-    std::vector<IndexedSubfeature> features = grid.query({ box.min - additionalRadius, box.max + additionalRadius });
+    // The boxes of the queries, and the box that covers all of them.
+    std::vector<BBox> queryBoxes;
+    queryBoxes.reserve(queryGeometries.size());
+    optional<BBox> unionBox;
+    for (const auto& queryGeometry : queryGeometries) {
+        if (queryGeometry.empty()) {
+            queryBoxes.push_back({ { 0, 0 }, { 0, 0 } });
+            continue;
+        }
+        const BBox envelope = mapbox::geometry::envelope(queryGeometry);
+        queryBoxes.push_back({ envelope.min - additionalRadius, envelope.max + additionalRadius });
+        const BBox& box = queryBoxes.back();
+        if (!unionBox) {
+            unionBox = box;
+        } else {
+            unionBox->min.x = util::min(unionBox->min.x, box.min.x);
+            unionBox->min.y = util::min(unionBox->min.y, box.min.y);
+            unionBox->max.x = util::max(unionBox->max.x, box.max.x);
+            unionBox->max.y = util::max(unionBox->max.y, box.max.y);
+        }
+    }
 
+    // Query the grid index once for all queries.
+    std::vector<std::pair<const IndexedSubfeature*, BBox>> features;
+    if (unionBox) {
+        grid.queryWithBoxes(*unionBox, [&] (const IndexedSubfeature& feature, const BBox& box) {
+            features.emplace_back(&feature, box);
+            return true;
+        });
+    }
 
-    std::sort(features.begin(), features.end(), topDown);
+    std::sort(features.begin(), features.end(), [] (const auto& a, const auto& b) {
+        return topDown(a.first, b.first);
+    });
     size_t previousSortIndex = std::numeric_limits<size_t>::max();
-    for (const auto& indexedFeature : features) {
+    std::vector<std::size_t> queries;
+    for (const auto& feature : features) {
+        const IndexedSubfeature* indexedFeature = feature.first;
 
         // If this feature is the same as the previous feature, skip it.
-        if (indexedFeature.sortIndex == previousSortIndex) continue;
-        previousSortIndex = indexedFeature.sortIndex;
+        if (indexedFeature->sortIndex == previousSortIndex) continue;
+        previousSortIndex = indexedFeature->sortIndex;
 
-        addFeature(result, indexedFeature, queryGeometry, queryOptions, geometryTileData, tileID, layers, bearing, pixelsToTileUnits);
+        // Only the queries whose boxes overlap the feature can hit it.
+        queries.clear();
+        for (std::size_t i = 0; i < queryBoxes.size(); ++i) {
+            const BBox& queryBox = queryBoxes[i];
+            if (!queryGeometries[i].empty() &&
+                queryBox.min.x <= feature.second.max.x && queryBox.min.y <= feature.second.max.y &&
+                queryBox.max.x >= feature.second.min.x && queryBox.max.y >= feature.second.min.y) {
+                queries.push_back(i);
+            }
+        }
+
+        if (!queries.empty()) {
+            addFeature(hit, *indexedFeature, queryGeometries, queries, queryOptions, geometryTileData, tileID, layers, bearing, pixelsToTileUnits);
+        }
     }
 
     // Query symbol features, if they've been placed.
@@ -77,17 +145,20 @@ void FeatureIndex::query(
         return;
     }
 
-    std::vector<IndexedSubfeature> symbolFeatures = collisionTile->queryRenderedSymbols(queryGeometry, scale);
-    std::sort(symbolFeatures.begin(), symbolFeatures.end(), topDownSymbols);
-    for (const auto& symbolFeature : symbolFeatures) {
-        addFeature(result, symbolFeature, queryGeometry, queryOptions, geometryTileData, tileID, layers, bearing, pixelsToTileUnits);
+    for (std::size_t i = 0; i < queryGeometries.size(); ++i) {
+        std::vector<IndexedSubfeature> symbolFeatures = collisionTile->queryRenderedSymbols(queryGeometries[i], scale);
+        std::sort(symbolFeatures.begin(), symbolFeatures.end(), topDownSymbols);
+        for (const auto& symbolFeature : symbolFeatures) {
+            addFeature(hit, symbolFeature, queryGeometries, { i }, queryOptions, geometryTileData, tileID, layers, bearing, pixelsToTileUnits);
+        }
     }
 }
 
 void FeatureIndex::addFeature(
-    std::unordered_map<std::string, std::vector<Feature>>& result,
+    const HitCallback& hit,
     const IndexedSubfeature& indexedFeature,
-    const GeometryCoordinates& queryGeometry,
+    const std::vector<GeometryCoordinates>& queryGeometries,
+    const std::vector<std::size_t>& queries,
     const RenderedQueryOptions& options,
     const GeometryTileData& geometryTileData,
     const CanonicalTileID& tileID,
@@ -107,6 +178,7 @@ void FeatureIndex::addFeature(
     // Lazily calculated.
     std::unique_ptr<GeometryTileLayer> sourceLayer;
     std::unique_ptr<GeometryTileFeature> geometryTileFeature;
+    optional<bool> passesFilter;
 
     for (const std::string& layerID : bucketLayerIDs.at(indexedFeature.bucketName)) {
         const RenderLayer* renderLayer = getRenderLayer(layerID);
@@ -122,16 +194,21 @@ void FeatureIndex::addFeature(
             assert(geometryTileFeature);
         }
 
-        if (!renderLayer->is<RenderSymbolLayer>() &&
-             !renderLayer->queryIntersectsFeature(queryGeometry, *geometryTileFeature, tileID.z, bearing, pixelsToTileUnits)) {
-            continue;
+        if (!passesFilter) {
+            passesFilter = !options.filter || (*options.filter)(*geometryTileFeature);
         }
-
-        if (options.filter && !(*options.filter)(*geometryTileFeature)) {
-            continue;
+        if (!*passesFilter) {
+            return;
         }
 
-        result[layerID].push_back(convertFeature(*geometryTileFeature, tileID));
+        for (const std::size_t query : queries) {
+            if (!renderLayer->is<RenderSymbolLayer>() &&
+                 !renderLayer->queryIntersectsFeature(queryGeometries[query], *geometryTileFeature, tileID.z, bearing, pixelsToTileUnits)) {
+                continue;
+            }
+
+            hit(query, layerID, indexedFeature, *geometryTileFeature);
+        }
     }
 }
 
@@ -157,6 +234,31 @@ optional<GeometryCoordinates> FeatureIndex::translateQueryGeometry(
     return translated;
 }
 
+std::vector<std::size_t> FeatureIndex::querySourceLayer(const std::string& sourceLayerName,
+                                                        const GeometryTileLayer& sourceLayer,
+                                                        const GridIndex<std::size_t>::BBox& box) const {
+    auto it = sourceLayerGrids.find(sourceLayerName);
+    if (it == sourceLayerGrids.end()) {
+        GridIndex<std::size_t> sourceLayerGrid(util::EXTENT, 16, 0);
+        for (std::size_t i = 0; i < sourceLayer.featureCount(); i++) {
+            const GeometryCollection geometries = sourceLayer.getFeature(i)->getGeometries();
+            if (!geometries.empty()) {
+                sourceLayerGrid.insert(std::size_t(i), mapbox::geometry::envelope(geometries));
+            }
+        }
+        sourceLayerGrid.finish();
+        it = sourceLayerGrids.emplace(sourceLayerName, std::move(sourceLayerGrid)).first;
+    }
+
+    std::vector<std::size_t> result;
+    it->second.query(box, [&] (std::size_t i) {
+        result.push_back(i);
+        return true;
+    });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
 void FeatureIndex::setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs) {
     bucketLayerIDs[bucketName] = layerIDs;
 }
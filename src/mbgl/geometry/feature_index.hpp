@@ -7,6 +7,7 @@
 
 #include <vector>
 #include <string>
+#include <functional>
 #include <unordered_map>
 
 namespace mbgl {
@@ -28,10 +29,18 @@ public:
 
 class FeatureIndex {
 public:
+    // Called with each feature that a query hits, once for every layer it is hit in. `query` is
+    // the position of the query geometry that hit the feature.
+    using HitCallback = std::function<void (std::size_t query, const std::string& layerID,
+                                            const IndexedSubfeature&, const GeometryTileFeature&)>;
+
     FeatureIndex();
 
     void insert(const GeometryCollection&, std::size_t index, const std::string& sourceLayerName, const std::string& bucketName);
 
+    // Prepares the index for queries once all features have been inserted.
+    void finish();
+
     void query(
             std::unordered_map<std::string, std::vector<Feature>>& result,
             const GeometryCoordinates& queryGeometry,
@@ -45,6 +54,23 @@ public:
             const CollisionTile*,
             const float additionalQueryRadius) const;
 
+    // Runs several queries with a single visit of the index, and reports the hits instead of
+    // converting them to features. Each feature found in the index is decoded once, and then tested
+    // against the queries whose bounding boxes overlap it. Symbols are looked up in the collision
+    // tile once per query geometry.
+    void query(
+            const HitCallback&,
+            const std::vector<GeometryCoordinates>& queryGeometries,
+            const float bearing,
+            const double tileSize,
+            const double scale,
+            const RenderedQueryOptions& options,
+            const GeometryTileData&,
+            const CanonicalTileID&,
+            const std::vector<const RenderLayer*>&,
+            const CollisionTile*,
+            const float additionalQueryRadius) const;
+
     static optional<GeometryCoordinates> translateQueryGeometry(
             const GeometryCoordinates& queryGeometry,
             const std::array<float, 2>& translate,
@@ -54,11 +80,20 @@ public:
 
     void setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs);
 
+    // Returns the positions of the features of a source layer of this tile whose bounding box
+    // intersects `box`, in ascending order. Unlike the features of the style's layers, which are
+    // indexed during layout, the source layer is indexed the first time it is queried.
+    std::vector<std::size_t> querySourceLayer(const std::string& sourceLayerName,
+                                              const GeometryTileLayer&,
+                                              const GridIndex<std::size_t>::BBox&) const;
+
 private:
+    // Tests the feature against each of `queries`, the positions of query geometries.
     void addFeature(
-            std::unordered_map<std::string, std::vector<Feature>>& result,
+            const HitCallback&,
             const IndexedSubfeature&,
-            const GeometryCoordinates& queryGeometry,
+            const std::vector<GeometryCoordinates>& queryGeometries,
+            const std::vector<std::size_t>& queries,
             const RenderedQueryOptions& options,
             const GeometryTileData&,
             const CanonicalTileID&,
@@ -70,5 +105,8 @@ private:
     unsigned int sortIndex = 0;
 
     std::unordered_map<std::string, std::vector<std::string>> bucketLayerIDs;
+
+    // Only used on the render thread.
+    mutable std::unordered_map<std::string, GridIndex<std::size_t>> sourceLayerGrids;
 };
 } // namespace mbgl
@@ -500,6 +500,16 @@ void Context::updateTexture(
                                   data));
 }
 
+void Context::updateTextureSubImage(
+    TextureID id, const Point<uint32_t> offset, const Size size, const void* data, TextureFormat format, TextureUnit unit) {
+    activeTextureUnit = unit;
+    texture[unit] = id;
+    // Rows of alpha textures aren't necessarily aligned to four bytes.
+    pixelStoreUnpack = { 1 };
+    MBGL_CHECK_ERROR(glTexSubImage2D(GL_TEXTURE_2D, 0, offset.x, offset.y, size.width, size.height,
+                                     static_cast<GLenum>(format), GL_UNSIGNED_BYTE, data));
+}
+
 void Context::bindTexture(Texture& obj,
                           TextureUnit unit,
                           TextureFilter filter,
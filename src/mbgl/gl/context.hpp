@@ -16,8 +16,9 @@
 #include <mbgl/gl/stencil_mode.hpp>
 #include <mbgl/gl/color_mode.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/geometry.hpp>
 
-
+#include <cassert>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -130,6 +131,16 @@ public:
         obj.size = image.size;
     }
 
+    // Replaces the region of an existing texture that starts at `offset` with the image data.
+    // The region must lie within the texture.
+    template <typename Image>
+    void updateTextureSubImage(Texture& obj, const Image& image, const Point<uint32_t>& offset, TextureUnit unit = 0) {
+        assert(offset.x + image.size.width <= obj.size.width);
+        assert(offset.y + image.size.height <= obj.size.height);
+        auto format = image.channels == 4 ? TextureFormat::RGBA : TextureFormat::Alpha;
+        updateTextureSubImage(obj.texture.get(), offset, image.size, image.data.get(), format, unit);
+    }
+
     // Creates an empty texture with the specified dimensions.
     Texture createTexture(const Size size,
                           TextureFormat format = TextureFormat::RGBA,
@@ -253,6 +264,7 @@ private:
     UniqueBuffer createIndexBuffer(const void* data, std::size_t size);
     UniqueTexture createTexture(Size size, const void* data, TextureFormat, TextureUnit);
     void updateTexture(TextureID, Size size, const void* data, TextureFormat, TextureUnit);
+    void updateTextureSubImage(TextureID, Point<uint32_t> offset, Size size, const void* data, TextureFormat, TextureUnit);
     UniqueFramebuffer createFramebuffer();
     UniqueRenderbuffer createRenderbuffer(RenderbufferType, Size size);
     std::unique_ptr<uint8_t[]> readFramebuffer(Size, TextureFormat, bool flip);
@@ -7,9 +7,11 @@
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
+#include <mbgl/text/bidi_cache.hpp>
 #include <mbgl/text/get_anchors.hpp>
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/text/shaping.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/utf.hpp>
 #include <mbgl/util/token.hpp>
@@ -49,6 +51,7 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
       zoom(parameters.tileID.overscaledZ),
       mode(parameters.mode),
       pixelRatio(parameters.pixelRatio),
+      bidiCache(parameters.bidiCache),
       tileSize(util::tileSize * overscaling),
       tilePixelRatio(float(util::EXTENT) / tileSize),
       textSize(layers.at(0)->as<RenderSymbolLayer>()->impl().layout.get<TextSize>()),
@@ -139,7 +142,8 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
                 u8string = platform::lowercase(u8string);
             }
 
-            ft.text = applyArabicShaping(util::utf8_to_utf16::convert(u8string));
+            const std::u16string text = util::utf8_to_utf16::convert(u8string);
+            ft.text = bidiCache ? bidiCache->applyArabicShaping(text) : applyArabicShaping(text);
             const bool canVerticalizeText = layout.get<TextRotationAlignment>() == AlignmentType::Map
                                          && layout.get<SymbolPlacement>() == SymbolPlacementType::Line
                                          && util::i18n::allowsVerticalWritingMode(*ft.text);
@@ -179,7 +183,8 @@ bool SymbolLayout::hasSymbolInstances() const {
 }
 
 void SymbolLayout::prepare(const GlyphMap& glyphMap, const GlyphPositions& glyphPositions,
-                           const ImageMap& imageMap, const ImagePositions& imagePositions) {
+                           const ImageMap& imageMap, const ImagePositions& imagePositions,
+                           ShapingCache* shapingCache) {
     const bool textAlongLine = layout.get<TextRotationAlignment>() == AlignmentType::Map &&
         layout.get<SymbolPlacement>() == SymbolPlacementType::Line;
 
@@ -202,8 +207,9 @@ void SymbolLayout::prepare(const GlyphMap& glyphMap, const GlyphPositions& glyph
         if (feature.text) {
             auto applyShaping = [&] (const std::u16string& text, WritingModeType writingMode) {
                 const float oneEm = 24.0f;
-                const Shaping result = getShaping(
+                const ShapingCache::Key key {
                     /* string */ text,
+                    /* font stack */ layout.get<TextFont>(),
                     /* maxWidth: ems */ layout.get<SymbolPlacement>() != SymbolPlacementType::Line ?
                         layout.evaluate<TextMaxWidth>(zoom, feature) * oneEm : 0,
                     /* lineHeight: ems */ layout.get<TextLineHeight>() * oneEm,
@@ -212,11 +218,16 @@ void SymbolLayout::prepare(const GlyphMap& glyphMap, const GlyphPositions& glyph
                     /* spacing: ems */ util::i18n::allowsLetterSpacing(*feature.text) ? layout.evaluate<TextLetterSpacing>(zoom, feature) * oneEm : 0.0f,
                     /* translate */ Point<float>(layout.evaluate<TextOffset>(zoom, feature)[0] * oneEm, layout.evaluate<TextOffset>(zoom, feature)[1] * oneEm),
                     /* verticalHeight */ oneEm,
-                    /* writingMode */ writingMode,
-                    /* bidirectional algorithm object */ bidi,
-                    /* glyphs */ glyphs);
+                    /* writingMode */ writingMode
+                };
 
-                return result;
+                if (shapingCache) {
+                    return shapingCache->getShaping(key, bidi, glyphs, bidiCache);
+                }
+
+                return getShaping(key.text, key.maxWidth, key.lineHeight, key.textAnchor,
+                                  key.textJustify, key.spacing, key.translate,
+                                  key.verticalHeight, key.writingMode, bidi, glyphs, bidiCache);
             };
 
             shapedTextOrientations.first = applyShaping(*feature.text, WritingModeType::Horizontal);
@@ -21,6 +21,8 @@ class SymbolBucket;
 class Anchor;
 class RenderLayer;
 class PlacedSymbol;
+class ShapingCache;
+class BiDiCache;
 
 namespace style {
 class Filter;
@@ -34,8 +36,10 @@ public:
                  ImageDependencies&,
                  GlyphDependencies&);
 
+    // Shapes labels through the shaping cache if one is given.
     void prepare(const GlyphMap&, const GlyphPositions&,
-                 const ImageMap&, const ImagePositions&);
+                 const ImageMap&, const ImagePositions&,
+                 ShapingCache* = nullptr);
 
     std::unique_ptr<SymbolBucket> place(CollisionTile&);
 
@@ -75,6 +79,7 @@ private:
     const float zoom;
     const MapMode mode;
     const float pixelRatio;
+    BiDiCache* const bidiCache;
 
     style::SymbolLayoutProperties::PossiblyEvaluated layout;
 
@@ -7,6 +7,10 @@
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/math.hpp>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace mbgl {
 
 	/*
@@ -102,6 +106,47 @@ namespace mbgl {
         return {{ static_cast<float>(pos[0] / pos[3]), static_cast<float>(pos[1] / pos[3]) }, pos[3] };
     }
 
+    void projectPoints(const mat4& m, std::size_t count, const float* x, const float* y,
+                       float* projectedX, float* projectedY, float* cameraDistance) {
+        // The points have z = 0 and w = 1, so only three columns of the matrix contribute. The
+        // arithmetic stays in double precision like `project`: at high zoom levels the translation
+        // of a tile matrix is too large to be represented accurately as a float.
+        std::size_t i = 0;
+
+#if defined(__SSE2__)
+        const __m128d m0 = _mm_set1_pd(m[0]), m1 = _mm_set1_pd(m[1]), m3 = _mm_set1_pd(m[3]);
+        const __m128d m4 = _mm_set1_pd(m[4]), m5 = _mm_set1_pd(m[5]), m7 = _mm_set1_pd(m[7]);
+        const __m128d m12 = _mm_set1_pd(m[12]), m13 = _mm_set1_pd(m[13]), m15 = _mm_set1_pd(m[15]);
+
+        auto load = [] (const float* p) {
+            return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+        };
+        auto store = [] (float* p, __m128d v) {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_castps_si128(_mm_cvtpd_ps(v)));
+        };
+
+        for (; i + 2 <= count; i += 2) {
+            const __m128d px = load(x + i);
+            const __m128d py = load(y + i);
+            const __m128d w = _mm_add_pd(_mm_add_pd(_mm_mul_pd(m3, px), _mm_mul_pd(m7, py)), m15);
+            const __m128d projX = _mm_add_pd(_mm_add_pd(_mm_mul_pd(m0, px), _mm_mul_pd(m4, py)), m12);
+            const __m128d projY = _mm_add_pd(_mm_add_pd(_mm_mul_pd(m1, px), _mm_mul_pd(m5, py)), m13);
+            store(projectedX + i, _mm_div_pd(projX, w));
+            store(projectedY + i, _mm_div_pd(projY, w));
+            store(cameraDistance + i, w);
+        }
+#endif
+
+        for (; i < count; i++) {
+            const double px = x[i];
+            const double py = y[i];
+            const double w = m[3] * px + m[7] * py + m[15];
+            projectedX[i] = (m[0] * px + m[4] * py + m[12]) / w;
+            projectedY[i] = (m[1] * px + m[5] * py + m[13]) / w;
+            cameraDistance[i] = w;
+        }
+    }
+
     float evaluateSizeForFeature(const ZoomEvaluatedSize& zoomEvaluatedSize, const PlacedSymbol& placedSymbol) {
         if (zoomEvaluatedSize.isFeatureConstant) {
             return zoomEvaluatedSize.size;
@@ -114,9 +159,7 @@ namespace mbgl {
         }
     }
 
-    bool isVisible(const vec4& anchorPos, const float placementZoom, const std::array<double, 2>& clippingBuffer, const FrameHistory& frameHistory) {
-        const float x = anchorPos[0] / anchorPos[3];
-        const float y = anchorPos[1] / anchorPos[3];
+    bool isVisible(const float x, const float y, const float placementZoom, const std::array<double, 2>& clippingBuffer, const FrameHistory& frameHistory) {
         const bool inPaddedViewport = (
                 x >= -clippingBuffer[0] &&
                 x <= clippingBuffer[0] &&
@@ -326,17 +369,38 @@ namespace mbgl {
         
         dynamicVertexArray.clear();
 
-        for (auto& placedSymbol : placedSymbols) {
-			vec4 anchorPos = {{ placedSymbol.anchorPoint.x, placedSymbol.anchorPoint.y, 0, 1 }};
-            matrix::transformMat4(anchorPos, anchorPos, posMatrix);
+        // Project all anchors up front, in two batches: into GL coordinates to find the visible
+        // labels and their distance from the camera, and into the label plane where the glyphs
+        // are placed along the line.
+        const std::size_t count = placedSymbols.size();
+        std::vector<float> buffer(count * 8);
+        float* const anchorX = buffer.data();
+        float* const anchorY = anchorX + count;
+        float* const clipX = anchorY + count;
+        float* const clipY = clipX + count;
+        float* const cameraDistance = clipY + count;
+        float* const labelPlaneX = cameraDistance + count;
+        float* const labelPlaneY = labelPlaneX + count;
+        float* const labelPlaneDistance = labelPlaneY + count;
+
+        for (std::size_t i = 0; i < count; i++) {
+            anchorX[i] = placedSymbols[i].anchorPoint.x;
+            anchorY[i] = placedSymbols[i].anchorPoint.y;
+        }
+
+        projectPoints(posMatrix, count, anchorX, anchorY, clipX, clipY, cameraDistance);
+        projectPoints(labelPlaneMatrix, count, anchorX, anchorY, labelPlaneX, labelPlaneY, labelPlaneDistance);
+
+        for (std::size_t i = 0; i < count; i++) {
+            const PlacedSymbol& placedSymbol = placedSymbols[i];
 
             // Don't bother calculating the correct point for invisible labels.
-            if (!isVisible(anchorPos, placedSymbol.placementZoom, clippingBuffer, frameHistory)) {
+            if (!isVisible(clipX[i], clipY[i], placedSymbol.placementZoom, clippingBuffer, frameHistory)) {
                 hideGlyphs(placedSymbol.glyphOffsets.size(), dynamicVertexArray);
                 continue;
             }
 
-            const float cameraToAnchorDistance = anchorPos[3];
+            const float cameraToAnchorDistance = cameraDistance[i];
             const float perspectiveRatio = 1 + 0.5 * ((cameraToAnchorDistance / state.getCameraToCenterDistance()) - 1.0);
 
             const float fontSize = evaluateSizeForFeature(partiallyEvaluatedSize, placedSymbol);
@@ -344,7 +408,7 @@ namespace mbgl {
                 fontSize * perspectiveRatio :
                 fontSize / perspectiveRatio;
             
-            const Point<float> anchorPoint = project(placedSymbol.anchorPoint, labelPlaneMatrix).first;
+            const Point<float> anchorPoint = { labelPlaneX[i], labelPlaneY[i] };
 
             PlacementResult placeUnflipped = placeGlyphsAlongLine(placedSymbol, pitchScaledFontSize, false /*unflipped*/, values.keepUpright, posMatrix, labelPlaneMatrix, glCoordMatrix, dynamicVertexArray, anchorPoint);
 
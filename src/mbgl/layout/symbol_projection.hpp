@@ -4,6 +4,8 @@
 #include <mbgl/gl/vertex_buffer.hpp>
 #include <mbgl/programs/symbol_program.hpp>
 
+#include <cstddef>
+
 namespace mbgl {
 
     class TransformState;
@@ -18,6 +20,13 @@ namespace mbgl {
     mat4 getLabelPlaneMatrix(const mat4& posMatrix, const bool pitchWithMap, const bool rotateWithMap, const TransformState& state, const float pixelsToTileUnits);
     mat4 getGlCoordMatrix(const mat4& posMatrix, const bool pitchWithMap, const bool rotateWithMap, const TransformState& state, const float pixelsToTileUnits);
 
+    // Projects `count` points in the z = 0 plane with `matrix`, taking their tile coordinates from
+    // the `x` and `y` arrays. Writes the projected coordinates and the distance of each point from
+    // the camera (w) into the output arrays. Processes several points per instruction where the
+    // target supports it.
+    void projectPoints(const mat4& matrix, std::size_t count, const float* x, const float* y,
+                       float* projectedX, float* projectedY, float* cameraDistance);
+
     void reprojectLineLabels(gl::VertexVector<SymbolDynamicLayoutAttributes::Vertex>&, const std::vector<PlacedSymbol>&,
             const mat4& posMatrix, const style::SymbolPropertyValues&,
             const RenderTile&, const SymbolSizeBinder& sizeBinder, const TransformState&, const FrameHistory& frameHistory);
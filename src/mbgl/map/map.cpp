@@ -692,6 +692,17 @@ void Map::removeAnnotation(AnnotationID annotation) {
     impl->onUpdate();
 }
 
+AnnotationIDs Map::addAnnotations(const std::vector<Annotation>& annotations) {
+    auto result = impl->annotationManager.addAnnotations(annotations, getMaxZoom());
+    impl->onUpdate();
+    return result;
+}
+
+void Map::removeAnnotations(const AnnotationIDs& annotations) {
+    impl->annotationManager.removeAnnotations(annotations);
+    impl->onUpdate();
+}
+
 #pragma mark - Toggles
 
 void Map::setDebug(MapDebugOptions debugOptions) {
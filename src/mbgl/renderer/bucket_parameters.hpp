@@ -5,11 +5,16 @@
 
 namespace mbgl {
 
+class BiDiCache;
+
 class BucketParameters {
 public:
     const OverscaledTileID tileID;
     const MapMode mode;
     const float pixelRatio;
+
+    // Shared with the workers of other tiles; may be null.
+    BiDiCache* const bidiCache;
 };
 
 } // namespace mbgl
@@ -9,6 +9,7 @@
 
 #include <mapbox/shelf-pack.hpp>
 
+#include <memory>
 #include <set>
 #include <string>
 
@@ -18,6 +19,8 @@ namespace gl {
 class Context;
 } // namespace gl
 
+class SharedImageAtlas;
+
 class ImageRequestor {
 public:
     virtual ~ImageRequestor() = default;
@@ -53,6 +56,16 @@ public:
     void getImages(ImageRequestor&, ImageRequestPair&&);
     void removeRequestor(ImageRequestor&);
 
+    // When set, tiles created afterwards copy their icons into the shared atlas instead of
+    // building an icon atlas of their own.
+    void setSharedAtlas(std::shared_ptr<SharedImageAtlas> atlas) {
+        sharedAtlas = std::move(atlas);
+    }
+
+    const std::shared_ptr<SharedImageAtlas>& getSharedAtlas() const {
+        return sharedAtlas;
+    }
+
 private:
     void notify(ImageRequestor&, const ImageRequestPair&) const;
 
@@ -60,6 +73,7 @@ private:
 
     std::unordered_map<ImageRequestor*, ImageRequestPair> requestors;
     ImageMap images;
+    std::shared_ptr<SharedImageAtlas> sharedAtlas;
 
 // Pattern stuff
 public:
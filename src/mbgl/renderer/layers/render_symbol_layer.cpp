@@ -120,7 +120,9 @@ void RenderSymbolLayer::render(PaintParameters& parameters, RenderSource*) {
         assert(dynamic_cast<GeometryTile*>(&tile.tile));
         GeometryTile& geometryTile = static_cast<GeometryTile&>(tile.tile);
 
-        if (bucket.hasIconData()) {
+        // Without an icon atlas, the tile is waiting to be laid out again after the shared icon
+        // atlas was repacked.
+        if (bucket.hasIconData() && geometryTile.hasIconAtlas()) {
             auto values = iconPropertyValues(layout);
             auto paintPropertyValues = iconPaintProperties();
 
@@ -128,27 +130,16 @@ void RenderSymbolLayer::render(PaintParameters& parameters, RenderSource*) {
                 layout.get<IconRotationAlignment>() == AlignmentType::Map;
 
             if (alongLine) {
-                reprojectLineLabels(bucket.icon.dynamicVertices,
-                                    bucket.icon.placedSymbols,
-                                    tile.matrix,
-                                    values,
-                                    tile,
-                                    *bucket.iconSizeBinder,
-                                    parameters.state,
-                                    parameters.frameHistory);
-
                 parameters.context.updateVertexBuffer(*bucket.icon.dynamicVertexBuffer, std::move(bucket.icon.dynamicVertices));
             }
 
             const bool iconScaled = layout.get<IconSize>().constantOr(1.0) != 1.0 || bucket.iconsNeedLinear;
             const bool iconTransformed = values.rotationAlignment == AlignmentType::Map || parameters.state.getPitch() != 0;
 
-            parameters.context.bindTexture(*geometryTile.iconAtlasTexture, 0,
+            const Size texsize = geometryTile.bindIconAtlas(parameters.context,
                 bucket.sdfIcons || parameters.state.isChanging() || iconScaled || iconTransformed
                     ? gl::TextureFilter::Linear : gl::TextureFilter::Nearest);
 
-            const Size texsize = geometryTile.iconAtlasTexture->size;
-
             if (bucket.sdfIcons) {
                 if (values.hasHalo) {
                     draw(parameters.programs.symbolIconSDF,
@@ -181,7 +172,7 @@ void RenderSymbolLayer::render(PaintParameters& parameters, RenderSource*) {
         }
 
         if (bucket.hasTextData()) {
-            parameters.context.bindTexture(*geometryTile.glyphAtlasTexture, 0, gl::TextureFilter::Linear);
+            const Size texsize = geometryTile.bindGlyphAtlas(parameters.context);
 
             auto values = textPropertyValues(layout);
             auto paintPropertyValues = textPaintProperties();
@@ -190,20 +181,9 @@ void RenderSymbolLayer::render(PaintParameters& parameters, RenderSource*) {
                 layout.get<TextRotationAlignment>() == AlignmentType::Map;
 
             if (alongLine) {
-                reprojectLineLabels(bucket.text.dynamicVertices,
-                                    bucket.text.placedSymbols,
-                                    tile.matrix,
-                                    values,
-                                    tile,
-                                    *bucket.textSizeBinder,
-                                    parameters.state,
-                                    parameters.frameHistory);
-
                 parameters.context.updateVertexBuffer(*bucket.text.dynamicVertexBuffer, std::move(bucket.text.dynamicVertices));
             }
 
-            const Size texsize = geometryTile.glyphAtlasTexture->size;
-
             if (values.hasHalo) {
                 draw(parameters.programs.symbolGlyph,
                      SymbolSDFTextProgram::uniformValues(true, values, texsize, parameters.pixelsToGLUnits, alongLine, tile, parameters.state, SymbolSDFPart::Halo),
@@ -257,6 +237,40 @@ void RenderSymbolLayer::render(PaintParameters& parameters, RenderSource*) {
     }
 }
 
+void RenderSymbolLayer::reprojectLineLabels(const TransformState& state,
+                                            const FrameHistory& frameHistory,
+                                            std::vector<std::function<void()>>& jobs,
+                                            std::unordered_set<const SymbolBucket*>& buckets) {
+    for (const RenderTile& tile : renderTiles) {
+        assert(dynamic_cast<SymbolBucket*>(tile.tile.getBucket(*baseImpl)));
+        SymbolBucket& bucket = *reinterpret_cast<SymbolBucket*>(tile.tile.getBucket(*baseImpl));
+        if (!buckets.insert(&bucket).second) {
+            continue;
+        }
+
+        const auto& layout = bucket.layout;
+        const bool lineLabels = layout.get<SymbolPlacement>() == SymbolPlacementType::Line;
+
+        // Mirrors the conditions under which render() draws the icons.
+        assert(dynamic_cast<GeometryTile*>(&tile.tile));
+        if (lineLabels && bucket.hasIconData() && static_cast<GeometryTile&>(tile.tile).hasIconAtlas() &&
+            layout.get<IconRotationAlignment>() == AlignmentType::Map) {
+            jobs.push_back([&tile, &bucket, &state, &frameHistory, values = iconPropertyValues(layout)] {
+                mbgl::reprojectLineLabels(bucket.icon.dynamicVertices, bucket.icon.placedSymbols,
+                                          tile.matrix, values, tile, *bucket.iconSizeBinder, state, frameHistory);
+            });
+        }
+
+        if (lineLabels && bucket.hasTextData() &&
+            layout.get<TextRotationAlignment>() == AlignmentType::Map) {
+            jobs.push_back([&tile, &bucket, &state, &frameHistory, values = textPropertyValues(layout)] {
+                mbgl::reprojectLineLabels(bucket.text.dynamicVertices, bucket.text.placedSymbols,
+                                          tile.matrix, values, tile, *bucket.textSizeBinder, state, frameHistory);
+            });
+        }
+    }
+}
+
 style::IconPaintProperties::PossiblyEvaluated RenderSymbolLayer::iconPaintProperties() const {
     return style::IconPaintProperties::PossiblyEvaluated {
             evaluated.get<style::IconOpacity>(),
@@ -6,8 +6,13 @@
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 
+#include <functional>
+#include <unordered_set>
+
 namespace mbgl {
 
+class SymbolBucket;
+
 namespace style {
 
 // {icon,text}-specific paint-property packs for use in the symbol Programs.
@@ -57,6 +62,8 @@ public:
 class BucketParameters;
 class SymbolLayout;
 class GeometryTileLayer;
+class TransformState;
+class FrameHistory;
 
 class RenderSymbolLayer: public RenderLayer {
 public:
@@ -68,6 +75,16 @@ public:
     bool hasTransition() const override;
     void render(PaintParameters&, RenderSource*) override;
 
+    // Appends a job for every tile with icons or text placed along lines, which computes the
+    // positions of their glyphs for the current frame. Jobs don't share any mutable state and may
+    // run concurrently. render() uploads their results.
+    //
+    // Layers with the same layout share their buckets; `buckets` holds the buckets that already
+    // have jobs, so that each one is only reprojected once.
+    void reprojectLineLabels(const TransformState&, const FrameHistory&,
+                             std::vector<std::function<void()>>& jobs,
+                             std::unordered_set<const SymbolBucket*>& buckets);
+
     style::IconPaintProperties::PossiblyEvaluated iconPaintProperties() const;
     style::TextPaintProperties::PossiblyEvaluated textPaintProperties() const;
 
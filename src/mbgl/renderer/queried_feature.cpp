@@ -0,0 +1,47 @@
+#include <mbgl/renderer/queried_feature.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <cassert>
+
+namespace mbgl {
+
+QueriedFeature::QueriedFeature(std::shared_ptr<const GeometryTileLayer> layer_,
+                               std::size_t index_,
+                               const CanonicalTileID& tileID_)
+    : layer(std::move(layer_)),
+      index(index_),
+      tileID(tileID_) {
+    assert(layer);
+}
+
+std::unique_ptr<GeometryTileFeature> QueriedFeature::decode() const {
+    auto feature = layer->getFeature(index);
+    assert(feature);
+    return feature;
+}
+
+optional<FeatureIdentifier> QueriedFeature::getID() const {
+    return decode()->getID();
+}
+
+FeatureType QueriedFeature::getType() const {
+    return decode()->getType();
+}
+
+optional<Value> QueriedFeature::getValue(const std::string& key) const {
+    return decode()->getValue(key);
+}
+
+PropertyMap QueriedFeature::getProperties() const {
+    return decode()->getProperties();
+}
+
+Feature::geometry_type QueriedFeature::getGeometry() const {
+    return convertGeometry(*decode(), tileID);
+}
+
+Feature QueriedFeature::toFeature() const {
+    return convertFeature(*decode(), tileID);
+}
+
+} // namespace mbgl
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <mbgl/renderer/queried_feature.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+
+// Collects the hits of many rendered feature queries that are answered in a single pass over the
+// tiles. A tile adds each of its features once, however many queries and layers hit it.
+class QueryBatch {
+public:
+    struct Hit {
+        std::size_t query;
+        // Index into `features`.
+        std::size_t feature;
+        // Owned by the feature index of the tile, which outlives the query.
+        const std::string* layerID;
+    };
+
+    std::vector<QueriedFeature> features;
+    std::vector<Hit> hits;
+};
+
+// The query geometries of a batch that overlap a tile, in tile coordinates, along with their
+// position in the batch.
+using TileQueryGeometries = std::vector<std::pair<std::size_t, GeometryCoordinates>>;
+
+} // namespace mbgl
@@ -24,6 +24,8 @@ class SourceQueryOptions;
 class Tile;
 class RenderSourceObserver;
 class TileParameters;
+class Scheduler;
+class QueryBatch;
 
 class RenderSource : protected TileObserver {
 public:
@@ -59,11 +61,20 @@ public:
     // Returns an unsorted list of RenderTiles.
     virtual std::vector<std::reference_wrapper<RenderTile>> getRenderTiles() = 0;
 
+    // Queries the tiles in parallel on `scheduler` if given, or one after another otherwise.
     virtual std::unordered_map<std::string, std::vector<Feature>>
     queryRenderedFeatures(const ScreenLineString& geometry,
                           const TransformState& transformState,
                           const std::vector<const RenderLayer*>& layers,
-                          const RenderedQueryOptions& options) const = 0;
+                          const RenderedQueryOptions& options,
+                          Scheduler* scheduler) const = 0;
+
+    // Answers many queries in a single pass over the tiles, without merging their results.
+    virtual void queryRenderedFeatureBatch(QueryBatch&,
+                                           const std::vector<ScreenLineString>& geometries,
+                                           const TransformState& transformState,
+                                           const std::vector<const RenderLayer*>& layers,
+                                           const RenderedQueryOptions& options) const = 0;
 
     virtual std::vector<Feature>
     querySourceFeatures(const SourceQueryOptions&) const = 0;
@@ -40,17 +40,44 @@ std::vector<Feature> Renderer::queryRenderedFeatures(const ScreenCoordinate& poi
     return impl->queryRenderedFeatures({ point }, options);
 }
 
+static ScreenLineString boxGeometry(const ScreenBox& box) {
+    return {
+        box.min,
+        {box.max.x, box.min.y},
+        box.max,
+        {box.min.x, box.max.y},
+        box.min
+    };
+}
+
 std::vector<Feature> Renderer::queryRenderedFeatures(const ScreenBox& box, const RenderedQueryOptions& options) const {
-    return impl->queryRenderedFeatures(
-            {
-                    box.min,
-                    {box.max.x, box.min.y},
-                    box.max,
-                    {box.min.x, box.max.y},
-                    box.min
-            },
-            options
-    );
+    return impl->queryRenderedFeatures(boxGeometry(box), options);
+}
+
+std::vector<QueriedFeature> Renderer::queryRenderedFeatureHandles(const ScreenCoordinate& point, const RenderedQueryOptions& options) const {
+    return impl->queryRenderedFeatureHandles({ point }, options);
+}
+
+std::vector<QueriedFeature> Renderer::queryRenderedFeatureHandles(const ScreenBox& box, const RenderedQueryOptions& options) const {
+    return impl->queryRenderedFeatureHandles(boxGeometry(box), options);
+}
+
+RenderedQueryBatchResult Renderer::queryRenderedFeaturesBatch(const std::vector<ScreenCoordinate>& points, const RenderedQueryOptions& options) const {
+    std::vector<ScreenLineString> geometries;
+    geometries.reserve(points.size());
+    for (const auto& point : points) {
+        geometries.push_back({ point });
+    }
+    return impl->queryRenderedFeaturesBatch(geometries, options);
+}
+
+RenderedQueryBatchResult Renderer::queryRenderedFeaturesBatch(const std::vector<ScreenBox>& boxes, const RenderedQueryOptions& options) const {
+    std::vector<ScreenLineString> geometries;
+    geometries.reserve(boxes.size());
+    for (const auto& box : boxes) {
+        geometries.push_back(boxGeometry(box));
+    }
+    return impl->queryRenderedFeaturesBatch(geometries, options);
 }
 
 AnnotationIDs Renderer::queryPointAnnotations(const ScreenBox& box) const {
@@ -74,6 +101,34 @@ std::vector<Feature> Renderer::querySourceFeatures(const std::string& sourceID,
     return impl->querySourceFeatures(sourceID, options);
 }
 
+void Renderer::setParallelFeatureQueries(bool enabled) {
+    impl->setParallelFeatureQueries(enabled);
+}
+
+void Renderer::setSharedGlyphAtlas(bool enabled) {
+    impl->setSharedGlyphAtlas(enabled);
+}
+
+void Renderer::setLocalIdeographFontFamily(const optional<std::string>& fontFamily) {
+    impl->setLocalIdeographFontFamily(fontFamily);
+}
+
+void Renderer::setGlyphWarmup(bool enabled) {
+    impl->setGlyphWarmup(enabled);
+}
+
+void Renderer::setSharedIconAtlas(bool enabled) {
+    impl->setSharedIconAtlas(enabled);
+}
+
+void Renderer::setCollisionIndex(CollisionIndexType type) {
+    impl->setCollisionIndex(type);
+}
+
+void Renderer::setParallelLineLabels(bool enabled) {
+    impl->setParallelLineLabels(enabled);
+}
+
 void Renderer::dumpDebugLogs() {
     impl->dumDebugLogs();
 }
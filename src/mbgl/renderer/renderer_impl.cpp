@@ -14,24 +14,43 @@
 #include <mbgl/renderer/layers/render_background_layer.hpp>
 #include <mbgl/renderer/layers/render_custom_layer.hpp>
 #include <mbgl/renderer/layers/render_fill_extrusion_layer.hpp>
+#include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/style_diff.hpp>
 #include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/query_batch.hpp>
 #include <mbgl/renderer/backend_scope.hpp>
 #include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/shared_image_atlas.hpp>
 #include <mbgl/gl/debugging.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/style/source_impl.hpp>
+#include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/text/local_glyph_rasterizer.hpp>
+#include <mbgl/text/shared_glyph_atlas.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/parallel.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <unordered_set>
+
 namespace mbgl {
 
 using namespace style;
 
+// Glyph ranges that are requested for every font stack when glyph warmup is enabled: Basic Latin
+// and Latin-1 Supplement, Latin Extended-A and -B, and General Punctuation.
+static const GlyphRangeSet warmupGlyphRanges {
+    { 0, 255 }, { 256, 511 }, { 8192, 8447 }
+};
+
 static RendererObserver& nullObserver() {
     static RendererObserver observer;
     return observer;
@@ -50,7 +69,7 @@ Renderer::Impl::Impl(RendererBackend& backend_,
     , contextMode(contextMode_)
     , pixelRatio(pixelRatio_)
     , programCacheDir(programCacheDir_)
-    , glyphManager(std::make_unique<GlyphManager>(fileSource))
+    , glyphManager(std::make_unique<GlyphManager>(fileSource, scheduler))
     , imageManager(std::make_unique<ImageManager>())
     , lineAtlas(std::make_unique<LineAtlas>(Size{ 256, 512 }))
     , imageImpls(makeMutable<std::vector<Immutable<style::Image::Impl>>>())
@@ -117,7 +136,8 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         updateParameters.annotationManager,
         *imageManager,
         *glyphManager,
-        updateParameters.prefetchZoomDelta
+        updateParameters.prefetchZoomDelta,
+        collisionIndex
     };
 
     glyphManager->setURL(updateParameters.glyphURL);
@@ -189,6 +209,23 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         }
     }
 
+    // Request the glyphs of the style before the sources request their first tiles, so that both
+    // load at the same time. Ranges that are loaded or loading already aren't requested again.
+    if (glyphWarmup && (!layerDiff.added.empty() || !layerDiff.changed.empty())) {
+        std::set<FontStack> fontStacks;
+        for (const auto& layerImpl : *layerImpls) {
+            if (layerImpl->type == LayerType::Symbol) {
+                static_cast<const SymbolLayer::Impl&>(*layerImpl).addFontStacks(fontStacks);
+            }
+        }
+
+        GlyphRangeDependencies warmup;
+        for (const auto& fontStack : fontStacks) {
+            warmup.emplace(fontStack, warmupGlyphRanges);
+        }
+        glyphManager->prefetchGlyphs(warmup);
+    }
+
 
     const SourceDifference sourceDiff = diffSources(sourceImpls, updateParameters.sources);
     sourceImpls = updateParameters.sources;
@@ -406,6 +443,30 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         }
     }
 
+    // - LINE LABEL PASS ---------------------------------------------------------------------------
+    // Computes the positions of icons and glyphs that follow lines for the current camera, now that
+    // the tile matrices are known. Tiles are independent of each other, so when enabled, this work
+    // is spread over the worker threads while the render thread takes part in it.
+    {
+        std::vector<std::function<void()>> jobs;
+        std::unordered_set<const SymbolBucket*> buckets;
+        for (auto& item : order) {
+            if (RenderSymbolLayer* symbolLayer = item.layer.as<RenderSymbolLayer>()) {
+                if (symbolLayer->hasRenderPass(RenderPass::Translucent)) {
+                    symbolLayer->reprojectLineLabels(parameters.state, parameters.frameHistory, jobs, buckets);
+                }
+            }
+        }
+
+        if (parallelLineLabels) {
+            util::runInParallel(scheduler, jobs, maxLineLabelHelpers);
+        } else {
+            for (auto& job : jobs) {
+                job();
+            }
+        }
+    }
+
     // - 3D PASS -------------------------------------------------------------------------------------
     // Renders any 3D layers bottom-to-top to unique FBOs with texture attachments, but share the same
     // depth rbo between them.
@@ -621,7 +682,7 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
     parameters.context.performCleanup();
 }
 
-std::vector<Feature> Renderer::Impl::queryRenderedFeatures(const ScreenLineString& geometry, const RenderedQueryOptions& options) const {
+std::vector<const RenderLayer*> Renderer::Impl::getQueriedLayers(const RenderedQueryOptions& options) const {
     std::vector<const RenderLayer*> layers;
     if (options.layerIDs) {
         for (const auto& layerID : *options.layerIDs) {
@@ -634,6 +695,11 @@ std::vector<Feature> Renderer::Impl::queryRenderedFeatures(const ScreenLineStrin
             layers.emplace_back(entry.second.get());
         }
     }
+    return layers;
+}
+
+std::vector<Feature> Renderer::Impl::queryRenderedFeatures(const ScreenLineString& geometry, const RenderedQueryOptions& options) const {
+    const std::vector<const RenderLayer*> layers = getQueriedLayers(options);
 
     std::unordered_set<std::string> sourceIDs;
     for (const RenderLayer* layer : layers) {
@@ -643,7 +709,8 @@ std::vector<Feature> Renderer::Impl::queryRenderedFeatures(const ScreenLineStrin
     std::unordered_map<std::string, std::vector<Feature>> resultsByLayer;
     for (const auto& sourceID : sourceIDs) {
         if (RenderSource* renderSource = getRenderSource(sourceID)) {
-            auto sourceResults = renderSource->queryRenderedFeatures(geometry, transformState, layers, options);
+            auto sourceResults = renderSource->queryRenderedFeatures(geometry, transformState, layers, options,
+                                                                     parallelFeatureQueries ? &scheduler : nullptr);
             std::move(sourceResults.begin(), sourceResults.end(), std::inserter(resultsByLayer, resultsByLayer.begin()));
         }
     }
@@ -669,6 +736,87 @@ std::vector<Feature> Renderer::Impl::queryRenderedFeatures(const ScreenLineStrin
     return result;
 }
 
+std::vector<QueriedFeature> Renderer::Impl::queryRenderedFeatureHandles(const ScreenLineString& geometry, const RenderedQueryOptions& options) const {
+    RenderedQueryBatchResult batch = queryRenderedFeaturesBatch({ geometry }, options);
+
+    std::vector<QueriedFeature> result;
+    result.reserve(batch.featureIndices.size());
+    for (const uint32_t index : batch.featureIndices) {
+        result.push_back(batch.features[index]);
+    }
+    return result;
+}
+
+RenderedQueryBatchResult Renderer::Impl::queryRenderedFeaturesBatch(const std::vector<ScreenLineString>& geometries, const RenderedQueryOptions& options) const {
+    const std::vector<const RenderLayer*> layers = getQueriedLayers(options);
+
+    std::unordered_set<std::string> sourceIDs;
+    for (const RenderLayer* layer : layers) {
+        sourceIDs.emplace(layer->baseImpl->source);
+    }
+
+    QueryBatch batch;
+    for (const auto& sourceID : sourceIDs) {
+        if (RenderSource* renderSource = getRenderSource(sourceID)) {
+            renderSource->queryRenderedFeatureBatch(batch, geometries, transformState, layers, options);
+        }
+    }
+
+    // Position of the layers in the style, leaving out those that aren't rendered.
+    std::unordered_map<std::string, std::size_t> layerOrder;
+    for (const auto& layerImpl : *layerImpls) {
+        const RenderLayer* layer = getRenderLayer(layerImpl->id);
+        if (layer->needsRendering(zoomHistory.lastZoom)) {
+            const std::size_t order = layerOrder.size();
+            layerOrder.emplace(layerImpl->id, order);
+        }
+    }
+
+    struct OrderedHit {
+        std::size_t query;
+        std::size_t layer;
+        std::size_t feature;
+    };
+    std::vector<OrderedHit> hits;
+    hits.reserve(batch.hits.size());
+    for (const auto& hit : batch.hits) {
+        auto it = layerOrder.find(*hit.layerID);
+        if (it != layerOrder.end()) {
+            hits.push_back({ hit.query, it->second, hit.feature });
+        }
+    }
+
+    // Combine the results of each query based on the style layer order. Within a layer, hits
+    // keep the order of the tiles that reported them, like with a single query.
+    std::stable_sort(hits.begin(), hits.end(), [] (const OrderedHit& a, const OrderedHit& b) {
+        return std::tie(a.query, a.layer) < std::tie(b.query, b.layer);
+    });
+
+    RenderedQueryBatchResult result;
+    result.offsets.reserve(geometries.size() + 1);
+    result.featureIndices.reserve(hits.size());
+
+    // Only keep the features of layers that are rendered, in the order they are first hit.
+    const uint32_t unused = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> featureIndices(batch.features.size(), unused);
+
+    auto hit = hits.begin();
+    for (std::size_t query = 0; query < geometries.size(); ++query) {
+        result.offsets.push_back(static_cast<uint32_t>(result.featureIndices.size()));
+        for (; hit != hits.end() && hit->query == query; ++hit) {
+            uint32_t& index = featureIndices[hit->feature];
+            if (index == unused) {
+                index = static_cast<uint32_t>(result.features.size());
+                result.features.push_back(std::move(batch.features[hit->feature]));
+            }
+            result.featureIndices.push_back(index);
+        }
+    }
+    result.offsets.push_back(static_cast<uint32_t>(result.featureIndices.size()));
+
+    return result;
+}
+
 std::vector<Feature> Renderer::Impl::querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options) const {
     const RenderSource* source = getRenderSource(sourceID);
     if (!source) return {};
@@ -676,6 +824,38 @@ std::vector<Feature> Renderer::Impl::querySourceFeatures(const std::string& sour
     return source->querySourceFeatures(options);
 }
 
+void Renderer::Impl::setParallelFeatureQueries(bool enabled) {
+    parallelFeatureQueries = enabled;
+}
+
+void Renderer::Impl::setSharedGlyphAtlas(bool enabled) {
+    if (enabled != bool(glyphManager->getSharedAtlas())) {
+        glyphManager->setSharedAtlas(enabled ? std::make_shared<SharedGlyphAtlas>() : nullptr);
+    }
+}
+
+void Renderer::Impl::setLocalIdeographFontFamily(const optional<std::string>& fontFamily) {
+    glyphManager->setLocalGlyphRasterizer(std::make_shared<LocalGlyphRasterizer>(fontFamily));
+}
+
+void Renderer::Impl::setGlyphWarmup(bool enabled) {
+    glyphWarmup = enabled;
+}
+
+void Renderer::Impl::setSharedIconAtlas(bool enabled) {
+    if (enabled != bool(imageManager->getSharedAtlas())) {
+        imageManager->setSharedAtlas(enabled ? std::make_shared<SharedImageAtlas>() : nullptr);
+    }
+}
+
+void Renderer::Impl::setCollisionIndex(CollisionIndexType type) {
+    collisionIndex = type;
+}
+
+void Renderer::Impl::setParallelLineLabels(bool enabled) {
+    parallelLineLabels = enabled;
+}
+
 void Renderer::Impl::onLowMemory() {
     assert(BackendScope::exists());
     backend.getContext().performCleanup();
@@ -691,6 +871,32 @@ void Renderer::Impl::dumDebugLogs() {
     }
 
     imageManager->dumpDebugLogs();
+
+    if (const auto& glyphAtlas = glyphManager->getSharedAtlas()) {
+        const SharedGlyphAtlas::Stats stats = glyphAtlas->getStats();
+        Log::Info(Event::General, "SharedGlyphAtlas::glyphs: %s", util::toString(stats.glyphs).c_str());
+        Log::Info(Event::General, "SharedGlyphAtlas::referencedGlyphs: %s", util::toString(stats.referencedGlyphs).c_str());
+        Log::Info(Event::General, "SharedGlyphAtlas::evictedGlyphs: %s", util::toString(stats.evictedGlyphs).c_str());
+        Log::Info(Event::General, "SharedGlyphAtlas::memoryBytes: %s", util::toString(stats.memoryBytes).c_str());
+        Log::Info(Event::General, "SharedGlyphAtlas::uploadedBytes: %s", util::toString(stats.uploadedBytes).c_str());
+    }
+
+    if (const auto& iconAtlas = imageManager->getSharedAtlas()) {
+        const SharedImageAtlas::Stats stats = iconAtlas->getStats();
+        Log::Info(Event::General, "SharedImageAtlas::images: %s", util::toString(stats.images).c_str());
+        Log::Info(Event::General, "SharedImageAtlas::referencedImages: %s", util::toString(stats.referencedImages).c_str());
+        Log::Info(Event::General, "SharedImageAtlas::evictedImages: %s", util::toString(stats.evictedImages).c_str());
+        Log::Info(Event::General, "SharedImageAtlas::repacks: %s", util::toString(stats.repacks).c_str());
+        Log::Info(Event::General, "SharedImageAtlas::memoryBytes: %s", util::toString(stats.memoryBytes).c_str());
+        Log::Info(Event::General, "SharedImageAtlas::uploadedBytes: %s", util::toString(stats.uploadedBytes).c_str());
+    }
+
+    const ShapingCache::Stats shapingStats = glyphManager->getShapingCache()->getStats();
+    Log::Info(Event::General, "ShapingCache::entries: %s", util::toString(shapingStats.entries).c_str());
+    Log::Info(Event::General, "ShapingCache::hits: %s", util::toString(shapingStats.hits).c_str());
+    Log::Info(Event::General, "ShapingCache::misses: %s", util::toString(shapingStats.misses).c_str());
+    Log::Info(Event::General, "ShapingCache::evictions: %s", util::toString(shapingStats.evictions).c_str());
+    Log::Info(Event::General, "ShapingCache::hitRate: %s", util::toString(shapingStats.hitRate()).c_str());
 }
 
 RenderLayer* Renderer::Impl::getRenderLayer(const std::string& id) {
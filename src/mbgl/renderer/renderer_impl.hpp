@@ -11,6 +11,7 @@
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/map/zoom_history.hpp>
 #include <mbgl/text/glyph_manager_observer.hpp>
+#include <mbgl/text/placement_config.hpp>
 
 #include <memory>
 #include <string>
@@ -48,8 +49,18 @@ public:
     void render(const UpdateParameters&);
 
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions&) const;
+    std::vector<QueriedFeature> queryRenderedFeatureHandles(const ScreenLineString&, const RenderedQueryOptions&) const;
+    RenderedQueryBatchResult queryRenderedFeaturesBatch(const std::vector<ScreenLineString>&, const RenderedQueryOptions&) const;
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions&) const;
 
+    void setParallelFeatureQueries(bool);
+    void setSharedGlyphAtlas(bool);
+    void setLocalIdeographFontFamily(const optional<std::string>&);
+    void setGlyphWarmup(bool);
+    void setSharedIconAtlas(bool);
+    void setCollisionIndex(CollisionIndexType);
+    void setParallelLineLabels(bool);
+
     void onLowMemory();
     void dumDebugLogs();
 
@@ -62,6 +73,9 @@ private:
           RenderLayer* getRenderLayer(const std::string& id);
     const RenderLayer* getRenderLayer(const std::string& id) const;
 
+    // The layers that a feature query with these options looks at.
+    std::vector<const RenderLayer*> getQueriedLayers(const RenderedQueryOptions&) const;
+
     // GlyphManagerObserver implementation.
     void onGlyphsError(const FontStack&, const GlyphRange&, std::exception_ptr) override;
 
@@ -92,6 +106,17 @@ private:
     ZoomHistory zoomHistory;
     TransformState transformState;
 
+    CollisionIndexType collisionIndex = defaultCollisionIndexType;
+
+    // Number of worker threads that compute the positions of line labels in addition to the
+    // render thread, when parallelLineLabels is enabled.
+    static constexpr std::size_t maxLineLabelHelpers = 3;
+    bool parallelLineLabels = false;
+
+    bool glyphWarmup = false;
+
+    bool parallelFeatureQueries = false;
+
     std::unique_ptr<GlyphManager> glyphManager;
     std::unique_ptr<ImageManager> imageManager;
     std::unique_ptr<LineAtlas> lineAtlas;
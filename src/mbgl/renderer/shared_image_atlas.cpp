@@ -0,0 +1,207 @@
+#include <mbgl/renderer/shared_image_atlas.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+// Icon images are padded with one pixel of fully transparent pixels on each side, which ensures
+// the correct behavior of GL_LINEAR texture sampling mode.
+static constexpr uint16_t padding = 1;
+
+// Shelf packing wastes some space at the end of shelves and above smaller images, so a repack
+// only helps if the referenced images occupy noticeably less than the whole atlas.
+static constexpr double maximumRepackOccupancy = 0.8;
+
+SharedImageAtlas::SharedImageAtlas(Size initialSize, Size maximumSize_)
+    : maximumSize(maximumSize_),
+      atlas(initialSize, maximumSize, [this] (ShelfAtlas<PremultipliedImage>::Entry& entry) {
+          evicted(static_cast<Entry&>(entry));
+      }) {
+}
+
+SharedImageAtlas::~SharedImageAtlas() = default;
+
+SharedImageAtlas::Reference::Reference(std::shared_ptr<SharedImageAtlas> atlas_, uint64_t generation_)
+    : atlas(std::move(atlas_)), generation(generation_) {
+}
+
+SharedImageAtlas::Reference::~Reference() {
+    atlas->release(*this);
+}
+
+std::unique_ptr<SharedImageAtlas::Reference> SharedImageAtlas::addImages(const ImageMap& images, ImagePositions& positions) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::unique_ptr<Reference> reference(new Reference(shared_from_this(), generation));
+    generations[generation]++;
+
+    for (const auto& imageEntry : images) {
+        const Immutable<style::Image::Impl>& imageImpl = imageEntry.second;
+
+        auto it = entries.find(imageImpl.get());
+        if (it == entries.end()) {
+            it = entries.emplace(imageImpl.get(), Entry { imageImpl }).first;
+        }
+
+        Entry& entry = it->second;
+        if (!entry.bin && !place(entry)) {
+            Log::Warning(Event::Sprite, "Image \"%s\" doesn't fit in the shared icon atlas", imageImpl->id.c_str());
+            if (entry.references == 0) {
+                entries.erase(it);
+            }
+            reference->incomplete = true;
+            continue;
+        }
+
+        if (entry.references++ == 0) {
+            atlas.reference(entry);
+            referencedImages++;
+            referencedArea += entry.area();
+        }
+
+        reference->entries.push_back(&entry);
+        positions.emplace(imageEntry.first, ImagePosition { *entry.bin, *imageImpl });
+    }
+
+    return reference;
+}
+
+std::size_t SharedImageAtlas::Entry::area() const {
+    const Size size = image->image.size;
+    return std::size_t(size.width + 2 * padding) * (size.height + 2 * padding);
+}
+
+bool SharedImageAtlas::place(Entry& entry) {
+    const PremultipliedImage& src = entry.image->image;
+    const uint16_t width = src.size.width + 2 * padding;
+    const uint16_t height = src.size.height + 2 * padding;
+
+    mapbox::Bin* bin = atlas.allocate(width, height);
+    if (!bin) {
+        failedArea += entry.area();
+        return false;
+    }
+
+    atlas.copy(src, *bin, padding);
+    entry.bin = bin;
+    return true;
+}
+
+void SharedImageAtlas::evicted(Entry& entry) {
+    const style::Image::Impl* key = entry.image.get();
+    entries.erase(key);
+    evictedImages++;
+}
+
+bool SharedImageAtlas::needsRepack() const {
+    return failedArea > 0 &&
+           failedArea + referencedArea <= maximumRepackOccupancy * maximumSize.area();
+}
+
+void SharedImageAtlas::repack() {
+    atlas.clear();
+
+    // Packing the tallest images first keeps the shelves tight.
+    std::vector<Entry*> sorted;
+    sorted.reserve(entries.size());
+    for (auto& entry : entries) {
+        sorted.push_back(&entry.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), [] (const Entry* a, const Entry* b) {
+        return a->image->image.size.height > b->image->image.size.height;
+    });
+
+    for (Entry* entry : sorted) {
+        entry->bin = nullptr;
+        place(*entry);
+    }
+
+    // Images that don't fit even now won't fit after another repack either.
+    failedArea = 0;
+
+    generation++;
+    repacks++;
+}
+
+void SharedImageAtlas::release(const Reference& reference) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (Entry* entry : reference.entries) {
+        assert(entry->references > 0);
+        if (--entry->references == 0) {
+            referencedImages--;
+            referencedArea -= entry->area();
+            if (entry->bin) {
+                atlas.release(*entry);
+            } else {
+                const style::Image::Impl* key = entry->image.get();
+                entries.erase(key);
+            }
+        }
+    }
+
+    auto it = generations.find(reference.generation);
+    if (--it->second == 0) {
+        generations.erase(it);
+    }
+}
+
+uint64_t SharedImageAtlas::getGeneration() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return generation;
+}
+
+void SharedImageAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (needsRepack()) {
+        // Tiles of the current generation continue to use the current texture until they have
+        // been laid out again, so it has to include all changes made so far.
+        uploadedBytes += atlas.upload(context, texture, unit);
+        previousTexture = std::move(texture);
+        texture = {};
+        repack();
+    }
+
+    if (previousTexture && generations.find(generation - 1) == generations.end()) {
+        previousTexture = {};
+    }
+
+    uploadedBytes += atlas.upload(context, texture, unit);
+}
+
+bool SharedImageAtlas::hasTexture(uint64_t generation_) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return generation_ == generation ? bool(texture)
+         : generation_ + 1 == generation ? bool(previousTexture)
+         : false;
+}
+
+Size SharedImageAtlas::bind(gl::Context& context, gl::TextureUnit unit, gl::TextureFilter filter, uint64_t generation_) {
+    std::lock_guard<std::mutex> lock(mutex);
+    gl::Texture& obj = generation_ == generation ? *texture : *previousTexture;
+    context.bindTexture(obj, unit, filter);
+    return obj.size;
+}
+
+SharedImageAtlas::Stats SharedImageAtlas::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Stats stats;
+    stats.images = entries.size();
+    stats.referencedImages = referencedImages;
+    stats.evictedImages = evictedImages;
+    stats.repacks = repacks;
+    stats.memoryBytes = atlas.getImage().bytes();
+    stats.uploadedBytes = uploadedBytes;
+    return stats;
+}
+
+PremultipliedImage SharedImageAtlas::getAtlasImage() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return atlas.getImage().clone();
+}
+
+} // namespace mbgl
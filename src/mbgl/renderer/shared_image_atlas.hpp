@@ -0,0 +1,148 @@
+#pragma once
+
+#include <mbgl/renderer/image_atlas.hpp>
+#include <mbgl/renderer/shelf_atlas.hpp>
+#include <mbgl/gl/texture.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+namespace gl {
+class Context;
+} // namespace gl
+
+/*
+    SharedImageAtlas is a renderer-wide alternative to the per-tile icon atlases built by
+    `makeImageAtlas`. Each icon image is copied into a single texture once, and tiles hold a
+    `Reference` to the icons their symbol buckets use.
+
+    Icons that are no longer referenced stay in the atlas until their space is needed. New icons
+    are sent to the GPU with sub-image uploads of the changed region only.
+
+    Over time, icons of different sizes come and go and the atlas fragments. When an icon doesn't
+    fit even though the referenced icons would leave enough room if they were packed tightly, the
+    atlas is repacked into a new texture on the next upload. Repacking moves icons, so it starts a
+    new generation: tiles whose reference belongs to an older generation keep rendering with the
+    texture of the previous generation until they have laid out their symbols again, and don't
+    render icons at all if their generation is older than that.
+
+    `addImages` may be called from worker threads; all other methods that take a `gl::Context`
+    must be called on the render thread.
+*/
+class SharedImageAtlas : public std::enable_shared_from_this<SharedImageAtlas>,
+                         private util::noncopyable {
+private:
+    struct Entry;
+
+public:
+    SharedImageAtlas(Size initialSize = { 128, 128 }, Size maximumSize = { 2048, 2048 });
+    ~SharedImageAtlas();
+
+    // Keeps the atlas regions of a set of icons alive. Released when destroyed.
+    class Reference : private util::noncopyable {
+    public:
+        ~Reference();
+
+        // The generation of the atlas that the positions of the icons refer to.
+        uint64_t getGeneration() const { return generation; }
+
+        // Whether repacking the atlas invalidates the positions: true if the reference includes
+        // any icons, or if some of the icons didn't fit.
+        bool isAffectedByRepack() const { return !entries.empty() || incomplete; }
+
+    private:
+        friend class SharedImageAtlas;
+        Reference(std::shared_ptr<SharedImageAtlas>, uint64_t generation);
+
+        std::shared_ptr<SharedImageAtlas> atlas;
+        const uint64_t generation;
+        std::vector<Entry*> entries;
+        bool incomplete = false;
+    };
+
+    // Adds all images that aren't in the atlas yet and returns a reference to the regions of all
+    // of them. The positions of the images are added to `positions`; images that don't fit in
+    // the atlas are omitted.
+    std::unique_ptr<Reference> addImages(const ImageMap&, ImagePositions& positions);
+
+    uint64_t getGeneration() const;
+
+    // Repacks the atlas if necessary and uploads all changes.
+    void upload(gl::Context&, gl::TextureUnit);
+
+    // Whether there's a texture for positions of the given generation.
+    bool hasTexture(uint64_t generation) const;
+
+    // Binds the texture for positions of the given generation and returns its size.
+    Size bind(gl::Context&, gl::TextureUnit, gl::TextureFilter, uint64_t generation);
+
+    struct Stats {
+        // Number of images in the atlas, including unreferenced ones that weren't evicted yet.
+        std::size_t images = 0;
+        std::size_t referencedImages = 0;
+        std::size_t evictedImages = 0;
+        std::size_t repacks = 0;
+        // Size of the CPU-side atlas image, which equals the size of the current texture.
+        std::size_t memoryBytes = 0;
+        // Total number of bytes sent to the GPU.
+        uint64_t uploadedBytes = 0;
+    };
+
+    Stats getStats() const;
+
+    // Only for use in tests.
+    PremultipliedImage getAtlasImage() const;
+
+private:
+    // `bin` is null if the image didn't fit into the atlas.
+    struct Entry : ShelfAtlas<PremultipliedImage>::Entry {
+        Entry(Immutable<style::Image::Impl> image_) : image(std::move(image_)) {}
+
+        // Padded area of the image.
+        std::size_t area() const;
+
+        Immutable<style::Image::Impl> image;
+        uint32_t references = 0;
+    };
+
+    bool place(Entry&);
+    void evicted(Entry&);
+    bool needsRepack() const;
+    void repack();
+    void release(const Reference&);
+
+    const Size maximumSize;
+
+    mutable std::mutex mutex;
+    ShelfAtlas<PremultipliedImage> atlas;
+
+    // Keyed by image rather than by ID, since tiles may still use an image that was updated since.
+    std::unordered_map<const style::Image::Impl*, Entry> entries;
+
+    // Number of live references per generation.
+    std::map<uint64_t, std::size_t> generations;
+    uint64_t generation = 0;
+
+    // Padded area of the images that didn't fit since the last repack.
+    std::size_t failedArea = 0;
+
+    // Padded area of the images that tiles reference, whether or not they fit.
+    std::size_t referencedArea = 0;
+
+    optional<gl::Texture> texture;
+    optional<gl::Texture> previousTexture;
+
+    std::size_t referencedImages = 0;
+    std::size_t evictedImages = 0;
+    std::size_t repacks = 0;
+    uint64_t uploadedBytes = 0;
+};
+
+} // namespace mbgl
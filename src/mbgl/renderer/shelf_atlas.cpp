@@ -0,0 +1,156 @@
+#include <mbgl/renderer/shelf_atlas.hpp>
+#include <mbgl/gl/context.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace mbgl {
+
+static mapbox::ShelfPack::ShelfPackOptions shelfPackOptions() {
+    mapbox::ShelfPack::ShelfPackOptions options;
+    options.autoResize = false;
+    return options;
+}
+
+template <class Image>
+ShelfAtlas<Image>::ShelfAtlas(Size initialSize_, Size maximumSize_, std::function<void (Entry&)> evicted_)
+    : initialSize(initialSize_),
+      maximumSize(maximumSize_),
+      evicted(std::move(evicted_)),
+      shelfPack(initialSize.width, initialSize.height, shelfPackOptions()),
+      image(initialSize) {
+    assert(initialSize.width <= maximumSize.width && initialSize.height <= maximumSize.height);
+}
+
+template <class Image>
+mapbox::Bin* ShelfAtlas<Image>::allocate(uint16_t width, uint16_t height) {
+    // Prefer growing the atlas over evicting entries that tiles loaded later might need again.
+    while (true) {
+        if (mapbox::Bin* bin = shelfPack.packOne(-1, width, height)) {
+            return bin;
+        }
+        if (!grow() && !evictOne()) {
+            return nullptr;
+        }
+    }
+}
+
+template <class Image>
+void ShelfAtlas<Image>::copy(const Image& src, const mapbox::Bin& bin, uint16_t padding) {
+    // Regions of evicted entries are reused, so clear the padding that surrounds the image.
+    const uint32_t x = bin.x;
+    const uint32_t y = bin.y;
+    Image::clear(image, { x, y }, { uint32_t(bin.w), uint32_t(bin.h) });
+    Image::copy(src, image, { 0, 0 }, { x + padding, y + padding }, src.size);
+    markDirty(bin);
+}
+
+template <class Image>
+void ShelfAtlas<Image>::reference(Entry& entry) {
+    if (entry.lru) {
+        unreferenced.erase(*entry.lru);
+        entry.lru = {};
+    }
+}
+
+template <class Image>
+void ShelfAtlas<Image>::release(Entry& entry) {
+    assert(entry.bin && !entry.lru);
+    entry.lru = unreferenced.insert(unreferenced.end(), &entry);
+}
+
+template <class Image>
+void ShelfAtlas<Image>::clear() {
+    std::list<Entry*> released;
+    released.swap(unreferenced);
+    for (Entry* entry : released) {
+        entry->lru = {};
+        evicted(*entry);
+    }
+
+    shelfPack.clear();
+    shelfPack.resize(initialSize.width, initialSize.height);
+    image = Image(initialSize);
+    dirty = {};
+    resized = true;
+}
+
+template <class Image>
+bool ShelfAtlas<Image>::grow() {
+    const Size size = image.size;
+    Size newSize = size;
+    if (size.width <= size.height && size.width < maximumSize.width) {
+        newSize.width = std::min(size.width * 2, maximumSize.width);
+    } else if (size.height < maximumSize.height) {
+        newSize.height = std::min(size.height * 2, maximumSize.height);
+    } else {
+        return false;
+    }
+
+    shelfPack.resize(newSize.width, newSize.height);
+    image.resize(newSize);
+    resized = true;
+    return true;
+}
+
+template <class Image>
+bool ShelfAtlas<Image>::evictOne() {
+    if (unreferenced.empty()) {
+        return false;
+    }
+
+    Entry* entry = unreferenced.front();
+    unreferenced.pop_front();
+    entry->lru = {};
+
+    shelfPack.unref(*entry->bin);
+    evicted(*entry);
+    return true;
+}
+
+template <class Image>
+void ShelfAtlas<Image>::markDirty(const mapbox::Bin& bin) {
+    const uint32_t x = bin.x;
+    const uint32_t y = bin.y;
+    const uint32_t w = bin.w;
+    const uint32_t h = bin.h;
+
+    if (!dirty) {
+        dirty = Rect<uint32_t> { x, y, w, h };
+        return;
+    }
+
+    const uint32_t left = std::min(dirty->x, x);
+    const uint32_t top = std::min(dirty->y, y);
+    const uint32_t right = std::max(dirty->x + dirty->w, x + w);
+    const uint32_t bottom = std::max(dirty->y + dirty->h, y + h);
+    dirty = Rect<uint32_t> { left, top, right - left, bottom - top };
+}
+
+template <class Image>
+std::size_t ShelfAtlas<Image>::upload(gl::Context& context, optional<gl::Texture>& texture, gl::TextureUnit unit) {
+    std::size_t bytes = 0;
+    if (!texture || resized) {
+        if (!texture) {
+            texture = context.createTexture(image, unit);
+        } else {
+            context.updateTexture(*texture, image, unit);
+        }
+        bytes = image.bytes();
+    } else if (dirty) {
+        // GLES 2 can't upload a subregion of a larger client-side image, so copy it out first.
+        Image region({ dirty->w, dirty->h });
+        Image::copy(image, region, { dirty->x, dirty->y }, { 0, 0 }, region.size);
+        context.updateTextureSubImage(*texture, region, { dirty->x, dirty->y }, unit);
+        bytes = region.bytes();
+    }
+
+    dirty = {};
+    resized = false;
+    return bytes;
+}
+
+template class ShelfAtlas<AlphaImage>;
+template class ShelfAtlas<PremultipliedImage>;
+
+} // namespace mbgl
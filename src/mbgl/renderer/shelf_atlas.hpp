@@ -0,0 +1,85 @@
+#pragma once
+
+#include <mbgl/gl/texture.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/rect.hpp>
+
+#include <mapbox/shelf-pack.hpp>
+
+#include <functional>
+#include <list>
+
+namespace mbgl {
+
+namespace gl {
+class Context;
+} // namespace gl
+
+/*
+    ShelfAtlas holds the image of a texture atlas that is shared between tiles, such as
+    `SharedGlyphAtlas` and `SharedImageAtlas`. It packs regions into shelves, grows the image up to
+    a maximum size, evicts the regions of entries that no tile references anymore when it is full,
+    and uploads the changed part of the image to a texture.
+
+    The owner keeps its entries, and derives their type from `ShelfAtlas::Entry`. It is notified
+    of every entry that is evicted, so that it can drop the entry. ShelfAtlas isn't thread-safe;
+    the owner guards it with its own lock.
+*/
+template <class Image>
+class ShelfAtlas : private util::noncopyable {
+public:
+    struct Entry {
+        // Null if the entry doesn't have a region in the atlas.
+        mapbox::Bin* bin = nullptr;
+        // Position in the eviction order while no tile references the entry.
+        optional<std::list<Entry*>::iterator> lru;
+    };
+
+    ShelfAtlas(Size initialSize, Size maximumSize, std::function<void (Entry&)> evicted);
+
+    // Packs a region of the given size. Grows the atlas if the region doesn't fit, and once the
+    // atlas can't grow anymore, evicts unreferenced entries, least recently released first, until
+    // it fits. Returns null if it doesn't fit even then.
+    mapbox::Bin* allocate(uint16_t width, uint16_t height);
+
+    // Copies `src` into the region, surrounded by `padding` transparent pixels on each side.
+    void copy(const Image& src, const mapbox::Bin&, uint16_t padding);
+
+    // Called when the first tile references an entry with a region, and when the last tile
+    // releases it. Released entries are evicted only when their space is needed.
+    void reference(Entry&);
+    void release(Entry&);
+
+    // Evicts all unreferenced entries, and empties and shrinks the atlas to its initial size.
+    // The regions of the remaining entries are no longer valid.
+    void clear();
+
+    // Uploads the whole image if there's no texture yet or the atlas grew, and otherwise only the
+    // region that changed since the last upload. Returns the number of bytes uploaded.
+    std::size_t upload(gl::Context&, optional<gl::Texture>&, gl::TextureUnit);
+
+    const Image& getImage() const { return image; }
+
+private:
+    bool grow();
+    bool evictOne();
+    void markDirty(const mapbox::Bin&);
+
+    const Size initialSize;
+    const Size maximumSize;
+    const std::function<void (Entry&)> evicted;
+
+    mapbox::ShelfPack shelfPack;
+    Image image;
+
+    // Unreferenced entries, least recently released first.
+    std::list<Entry*> unreferenced;
+
+    // Region of `image` that changed since the last upload.
+    optional<Rect<uint32_t>> dirty;
+    bool resized = false;
+};
+
+} // namespace mbgl
@@ -0,0 +1,101 @@
+#include <mbgl/renderer/sources/geojson_source_worker.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/tile/geojson_tile.hpp>
+#include <mbgl/util/logging.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace mbgl {
+
+GeoJSONSourceWorker::GeoJSONSourceWorker(ActorRef<GeoJSONSourceWorker>) {
+}
+
+GeoJSONSourceWorker::~GeoJSONSourceWorker() = default;
+
+void GeoJSONSourceWorker::setData(std::shared_ptr<const GeoJSON> geoJSON_, style::GeoJSONOptions options_) {
+    geoJSON = std::move(geoJSON_);
+    options = std::move(options_);
+
+    replaced.clear();
+    changed.clear();
+    overlay.reset();
+    clusterChange.reset();
+
+    index(*geoJSON);
+}
+
+void GeoJSONSourceWorker::index(const GeoJSON& features) {
+    // Release the previous index before building a new one, to limit peak memory use.
+    data.reset();
+
+    try {
+        data = style::GeoJSONData::create(features, options);
+    } catch (...) {
+        // Tiles of the source stay empty, rather than waiting for data that never comes.
+        Log::Error(Event::ParseTile, "Failed to index GeoJSON data: %s",
+                   util::toString(std::current_exception()).c_str());
+    }
+}
+
+void GeoJSONSourceWorker::updateFeatures(std::shared_ptr<const style::GeoJSONFeatureChange> change) {
+    if (options.cluster) {
+        // Clusters depend on all the points of the source, so they can't be updated incrementally.
+        // The changes are merged into the data, which is clustered again once a tile needs it.
+        clusterChange = std::move(change);
+        return;
+    }
+
+    for (const auto& feature : change->updated) {
+        replaced.insert(*feature.id);
+        changed[*feature.id] = feature;
+    }
+    for (const auto& id : change->removed) {
+        replaced.insert(id);
+        changed.erase(id);
+    }
+    overlay.reset();
+}
+
+void GeoJSONSourceWorker::getTile(CanonicalTileID tileID, ActorRef<GeoJSONTile> tile) {
+    if (clusterChange) {
+        index(clusterChange->applyTo(geoJSON.get()));
+        clusterChange.reset();
+    }
+
+    mapbox::geometry::feature_collection<int16_t> features;
+    if (data) {
+        features = data->getTile(tileID);
+    }
+
+    if (!replaced.empty()) {
+        features.erase(std::remove_if(features.begin(), features.end(), [&] (const auto& feature) {
+            return feature.id && replaced.count(*feature.id);
+        }), features.end());
+    }
+
+    if (!changed.empty() && !overlay) {
+        FeatureCollection changedFeatures;
+        changedFeatures.reserve(changed.size());
+        for (const auto& entry : changed) {
+            changedFeatures.push_back(entry.second);
+        }
+        try {
+            overlay = style::GeoJSONData::create(GeoJSON { std::move(changedFeatures) }, options);
+        } catch (...) {
+            Log::Error(Event::ParseTile, "Failed to index GeoJSON features: %s",
+                       util::toString(std::current_exception()).c_str());
+        }
+    }
+    if (!changed.empty() && overlay) {
+        auto changedFeatures = overlay->getTile(tileID);
+        features.insert(features.end(),
+                        std::make_move_iterator(changedFeatures.begin()),
+                        std::make_move_iterator(changedFeatures.end()));
+    }
+
+    tile.invoke(&GeoJSONTile::updateData, std::move(features));
+}
+
+} // namespace mbgl
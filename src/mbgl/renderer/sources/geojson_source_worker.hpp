@@ -0,0 +1,53 @@
+#pragma once
+
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/tile/tile_id.hpp>
+
+#include <map>
+#include <memory>
+#include <set>
+
+namespace mbgl {
+
+class GeoJSONTile;
+
+namespace style {
+class GeoJSONData;
+class GeoJSONFeatureChange;
+} // namespace style
+
+// Builds the index of a GeoJSON source and slices tiles from it, off the render thread. Messages
+// are processed in order, so tiles requested after new data has been set are sliced from the new
+// index.
+//
+// Features changed after the data was set are kept apart from it: they are left out of the tiles
+// of the data, and sliced from a separate, much smaller index instead. Clustered data is indexed
+// again with the changes merged in.
+class GeoJSONSourceWorker {
+public:
+    GeoJSONSourceWorker(ActorRef<GeoJSONSourceWorker>);
+    ~GeoJSONSourceWorker();
+
+    void setData(std::shared_ptr<const GeoJSON>, style::GeoJSONOptions);
+    void updateFeatures(std::shared_ptr<const style::GeoJSONFeatureChange>);
+    void getTile(CanonicalTileID, ActorRef<GeoJSONTile>);
+
+private:
+    void index(const GeoJSON&);
+
+    std::shared_ptr<const GeoJSON> geoJSON;
+    style::GeoJSONOptions options;
+    std::unique_ptr<style::GeoJSONData> data;
+
+    // IDs of the features of the data that have been updated or removed.
+    std::set<FeatureIdentifier> replaced;
+    // The current versions of the updated features, and their index, built when a tile needs it.
+    std::map<FeatureIdentifier, Feature> changed;
+    std::unique_ptr<style::GeoJSONData> overlay;
+
+    // The latest change to clustered data that hasn't been merged into its index yet.
+    std::shared_ptr<const style::GeoJSONFeatureChange> clusterChange;
+};
+
+} // namespace mbgl
@@ -7,6 +7,8 @@
 #include <mbgl/algorithm/generate_clip_ids.hpp>
 #include <mbgl/algorithm/generate_clip_ids_impl.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 using namespace style;
@@ -33,23 +35,64 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
 
     enabled = needsRendering;
 
-    GeoJSONData* data_ = impl().getData();
+    std::shared_ptr<const GeoJSON> geoJSON_ = impl().getGeoJSON();
+    const bool dataChanged = geoJSON_ != geoJSON;
 
-    if (data_ != data) {
-        data = data_;
-        tilePyramid.cache.clear();
+    if (dataChanged) {
+        geoJSON = geoJSON_;
+        appliedChanges = 0;
 
-        if (data) {
-            const uint8_t maxZ = impl().getZoomRange().max;
-            for (const auto& pair : tilePyramid.tiles) {
-                if (pair.first.canonical.z <= maxZ) {
-                    static_cast<GeoJSONTile*>(pair.second.get())->updateData(data->getTile(pair.first.canonical));
-                }
+        if (geoJSON) {
+            if (!worker) {
+                worker = std::make_unique<Actor<GeoJSONSourceWorker>>(parameters.workerScheduler);
             }
+
+            // The new data is indexed in the background. Existing tiles keep rendering their
+            // previous features until the new ones arrive.
+            worker->invoke(&GeoJSONSourceWorker::setData, geoJSON, impl().getOptions());
+        }
+    }
+
+    // Send the worker the feature changes it hasn't seen yet, oldest first.
+    std::vector<std::shared_ptr<const GeoJSONFeatureChange>> changes;
+    if (geoJSON) {
+        for (auto change = impl().getChanges(); change && change->length > appliedChanges; change = change->previous) {
+            changes.push_back(change);
+        }
+        for (auto it = changes.rbegin(); it != changes.rend(); ++it) {
+            worker->invoke(&GeoJSONSourceWorker::updateFeatures, *it);
+        }
+        if (!changes.empty()) {
+            appliedChanges = changes.front()->length;
         }
     }
 
-    if (!data) {
+    if (geoJSON && (dataChanged || !changes.empty())) {
+        // Only tiles that contain changed features, including their buffer, need new data. Any
+        // change can move clusters in every tile, though.
+        const bool all = dataChanged || impl().getOptions().cluster;
+        const double buffer = double(impl().getOptions().buffer) / util::tileSize;
+        auto affected = [&] (const OverscaledTileID& tileID) {
+            return all || std::any_of(changes.begin(), changes.end(), [&] (const auto& change) {
+                return change->affects(tileID.canonical, buffer);
+            });
+        };
+
+        if (all) {
+            tilePyramid.cache.clear();
+        } else {
+            tilePyramid.cache.removeIf(affected);
+        }
+
+        const uint8_t maxZ = impl().getZoomRange().max;
+        for (const auto& pair : tilePyramid.tiles) {
+            if (pair.first.canonical.z <= maxZ && affected(pair.first)) {
+                static_cast<GeoJSONTile*>(pair.second.get())->requestData(worker->self());
+            }
+        }
+    }
+
+    if (!geoJSON) {
         tilePyramid.tiles.clear();
         tilePyramid.renderTiles.clear();
         return;
@@ -63,7 +106,9 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
                        util::tileSize,
                        impl().getZoomRange(),
                        [&] (const OverscaledTileID& tileID) {
-                           return std::make_unique<GeoJSONTile>(tileID, impl().id, parameters, data->getTile(tileID.canonical));
+                           auto tile = std::make_unique<GeoJSONTile>(tileID, impl().id, parameters);
+                           tile->requestData(worker->self());
+                           return tile;
                        });
 }
 
@@ -84,8 +129,17 @@ std::unordered_map<std::string, std::vector<Feature>>
 RenderGeoJSONSource::queryRenderedFeatures(const ScreenLineString& geometry,
                                            const TransformState& transformState,
                                            const std::vector<const RenderLayer*>& layers,
-                                           const RenderedQueryOptions& options) const {
-    return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options);
+                                           const RenderedQueryOptions& options,
+                                           Scheduler* scheduler) const {
+    return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, scheduler);
+}
+
+void RenderGeoJSONSource::queryRenderedFeatureBatch(QueryBatch& batch,
+                                                    const std::vector<ScreenLineString>& geometries,
+                                                    const TransformState& transformState,
+                                                    const std::vector<const RenderLayer*>& layers,
+                                                    const RenderedQueryOptions& options) const {
+    tilePyramid.queryRenderedFeatureBatch(batch, geometries, transformState, layers, options);
 }
 
 std::vector<Feature> RenderGeoJSONSource::querySourceFeatures(const SourceQueryOptions& options) const {
@@ -2,14 +2,12 @@
 
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/tile_pyramid.hpp>
+#include <mbgl/renderer/sources/geojson_source_worker.hpp>
 #include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/actor/actor.hpp>
 
 namespace mbgl {
 
-namespace style {
-class GeoJSONData;
-} // namespace style
-
 class RenderGeoJSONSource : public RenderSource {
 public:
     RenderGeoJSONSource(Immutable<style::GeoJSONSource::Impl>);
@@ -31,7 +29,14 @@ public:
     queryRenderedFeatures(const ScreenLineString& geometry,
                           const TransformState& transformState,
                           const std::vector<const RenderLayer*>& layers,
-                          const RenderedQueryOptions& options) const final;
+                          const RenderedQueryOptions& options,
+                          Scheduler* scheduler) const final;
+
+    void queryRenderedFeatureBatch(QueryBatch&,
+                                   const std::vector<ScreenLineString>& geometries,
+                                   const TransformState& transformState,
+                                   const std::vector<const RenderLayer*>& layers,
+                                   const RenderedQueryOptions& options) const final;
 
     std::vector<Feature>
     querySourceFeatures(const SourceQueryOptions&) const final;
@@ -43,7 +48,12 @@ private:
     const style::GeoJSONSource::Impl& impl() const;
 
     TilePyramid tilePyramid;
-    style::GeoJSONData* data = nullptr;
+
+    // The data that the worker has last been asked to index.
+    std::shared_ptr<const GeoJSON> geoJSON;
+    // The number of changes to its features that the worker has been sent since then.
+    std::size_t appliedChanges = 0;
+    std::unique_ptr<Actor<GeoJSONSourceWorker>> worker;
 };
 
 template <>
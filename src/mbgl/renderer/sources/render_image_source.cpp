@@ -84,10 +84,18 @@ std::unordered_map<std::string, std::vector<Feature>>
 RenderImageSource::queryRenderedFeatures(const ScreenLineString&,
                                          const TransformState&,
                                          const std::vector<const RenderLayer*>&,
-                                         const RenderedQueryOptions&) const {
+                                         const RenderedQueryOptions&,
+                                         Scheduler*) const {
     return std::unordered_map<std::string, std::vector<Feature>> {};
 }
 
+void RenderImageSource::queryRenderedFeatureBatch(QueryBatch&,
+                                                  const std::vector<ScreenLineString>&,
+                                                  const TransformState&,
+                                                  const std::vector<const RenderLayer*>&,
+                                                  const RenderedQueryOptions&) const {
+}
+
 std::vector<Feature> RenderImageSource::querySourceFeatures(const SourceQueryOptions&) const {
     return {};
 }
@@ -74,10 +74,18 @@ std::unordered_map<std::string, std::vector<Feature>>
 RenderRasterSource::queryRenderedFeatures(const ScreenLineString&,
                                           const TransformState&,
                                           const std::vector<const RenderLayer*>&,
-                                          const RenderedQueryOptions&) const {
+                                          const RenderedQueryOptions&,
+                                          Scheduler*) const {
     return std::unordered_map<std::string, std::vector<Feature>> {};
 }
 
+void RenderRasterSource::queryRenderedFeatureBatch(QueryBatch&,
+                                                   const std::vector<ScreenLineString>&,
+                                                   const TransformState&,
+                                                   const std::vector<const RenderLayer*>&,
+                                                   const RenderedQueryOptions&) const {
+}
+
 std::vector<Feature> RenderRasterSource::querySourceFeatures(const SourceQueryOptions&) const {
     return {};
 }
@@ -27,7 +27,14 @@ public:
     queryRenderedFeatures(const ScreenLineString& geometry,
                           const TransformState& transformState,
                           const std::vector<const RenderLayer*>& layers,
-                          const RenderedQueryOptions& options) const final;
+                          const RenderedQueryOptions& options,
+                          Scheduler* scheduler) const final;
+
+    void queryRenderedFeatureBatch(QueryBatch&,
+                                   const std::vector<ScreenLineString>& geometries,
+                                   const TransformState& transformState,
+                                   const std::vector<const RenderLayer*>& layers,
+                                   const RenderedQueryOptions& options) const final;
 
     std::vector<Feature>
     querySourceFeatures(const SourceQueryOptions&) const final;
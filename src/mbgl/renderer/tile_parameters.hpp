@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/map/mode.hpp>
+#include <mbgl/text/placement_config.hpp>
 
 namespace mbgl {
 
@@ -23,6 +24,7 @@ public:
     ImageManager& imageManager;
     GlyphManager& glyphManager;
     const uint8_t prefetchZoomDelta;
+    const CollisionIndexType collisionIndex = defaultCollisionIndexType;
 };
 
 } // namespace mbgl
@@ -10,12 +10,14 @@
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/enum.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/parallel.hpp>
 
 #include <mbgl/algorithm/update_renderables.hpp>
 
 #include <mapbox/geometry/envelope.hpp>
 
 #include <algorithm>
+#include <iterator>
 
 namespace mbgl {
 
@@ -23,6 +25,9 @@ using namespace style;
 
 static TileObserver nullObserver;
 
+// Number of worker threads that query tiles in addition to the calling thread.
+static constexpr std::size_t maxQueryHelpers = 3;
+
 TilePyramid::TilePyramid()
     : observer(&nullObserver) {
 }
@@ -197,69 +202,159 @@ void TilePyramid::update(const std::vector<Immutable<style::Layer::Impl>>& layer
                                        parameters.transformState.getPitch(),
                                        parameters.transformState.getCameraToCenterDistance(),
                                        parameters.transformState.getCameraToTileDistance(pair.first.toUnwrapped()),
-                                       parameters.debugOptions & MapDebugOptions::Collision };
+                                       parameters.debugOptions & MapDebugOptions::Collision,
+                                       parameters.collisionIndex };
+
+        pair.second->setPlacementConfig(config, parameters.transformState.isChanging());
+    }
+}
+
+std::vector<std::reference_wrapper<const RenderTile>> TilePyramid::getSortedRenderTiles() const {
+    std::vector<std::reference_wrapper<const RenderTile>> sortedTiles{ renderTiles.begin(),
+                                                                       renderTiles.end() };
+    std::sort(sortedTiles.begin(), sortedTiles.end(), [](const RenderTile& a, const RenderTile& b) {
+        return std::tie(a.id.canonical.z, a.id.canonical.y, a.id.wrap, a.id.canonical.x) <
+            std::tie(b.id.canonical.z, b.id.canonical.y, b.id.wrap, b.id.canonical.x);
+    });
+    return sortedTiles;
+}
+
+static LineString<double> toWorldCoordinates(const ScreenLineString& geometry, const TransformState& transformState) {
+    LineString<double> queryGeometry;
+    for (const auto& p : geometry) {
+        queryGeometry.push_back(TileCoordinate::fromScreenCoordinate(
+            transformState, 0, { p.x, transformState.getSize().height - p.y }).p);
+    }
+    return queryGeometry;
+}
+
+static bool tileIntersects(const UnwrappedTileID& tileID, const mapbox::geometry::box<double>& box) {
+    GeometryCoordinate tileSpaceBoundsMin = TileCoordinate::toGeometryCoordinate(tileID, box.min);
+    if (tileSpaceBoundsMin.x >= util::EXTENT || tileSpaceBoundsMin.y >= util::EXTENT) {
+        return false;
+    }
+
+    GeometryCoordinate tileSpaceBoundsMax = TileCoordinate::toGeometryCoordinate(tileID, box.max);
+    return tileSpaceBoundsMax.x >= 0 && tileSpaceBoundsMax.y >= 0;
+}
 
-        pair.second->setPlacementConfig(config);
+static GeometryCoordinates toTileCoordinates(const UnwrappedTileID& tileID, const LineString<double>& queryGeometry) {
+    GeometryCoordinates tileSpaceQueryGeometry;
+    tileSpaceQueryGeometry.reserve(queryGeometry.size());
+    for (const auto& c : queryGeometry) {
+        tileSpaceQueryGeometry.push_back(TileCoordinate::toGeometryCoordinate(tileID, c));
     }
+    return tileSpaceQueryGeometry;
 }
 
 std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRenderedFeatures(const ScreenLineString& geometry,
                                            const TransformState& transformState,
                                            const std::vector<const RenderLayer*>& layers,
-                                           const RenderedQueryOptions& options) const {
+                                           const RenderedQueryOptions& options,
+                                           Scheduler* scheduler) const {
     std::unordered_map<std::string, std::vector<Feature>> result;
     if (renderTiles.empty() || geometry.empty()) {
         return result;
     }
 
-    LineString<double> queryGeometry;
+    const LineString<double> queryGeometry = toWorldCoordinates(geometry, transformState);
+    const mapbox::geometry::box<double> box = mapbox::geometry::envelope(queryGeometry);
 
-    for (const auto& p : geometry) {
-        queryGeometry.push_back(TileCoordinate::fromScreenCoordinate(
-            transformState, 0, { p.x, transformState.getSize().height - p.y }).p);
+    std::vector<std::reference_wrapper<const RenderTile>> queriedTiles;
+    for (const RenderTile& renderTile : getSortedRenderTiles()) {
+        if (tileIntersects(renderTile.id, box)) {
+            queriedTiles.push_back(renderTile);
+        }
+    }
+
+    auto queryTile = [&] (const RenderTile& renderTile, std::unordered_map<std::string, std::vector<Feature>>& tileResult) {
+        renderTile.tile.queryRenderedFeatures(tileResult,
+                                              toTileCoordinates(renderTile.id, queryGeometry),
+                                              transformState,
+                                              layers,
+                                              options);
+    };
+
+    if (!scheduler || queriedTiles.size() < 2) {
+        for (const RenderTile& renderTile : queriedTiles) {
+            queryTile(renderTile, result);
+        }
+        return result;
     }
 
-    mapbox::geometry::box<double> box = mapbox::geometry::envelope(queryGeometry);
+    // Each tile is only read by the job that queries it, and the render thread doesn't change
+    // any tile until all jobs have finished. The results of the tiles are then combined in the
+    // same order as when querying them one after another.
+    std::vector<std::unordered_map<std::string, std::vector<Feature>>> tileResults(queriedTiles.size());
+    std::vector<std::function<void()>> jobs;
+    jobs.reserve(queriedTiles.size());
+    for (std::size_t i = 0; i < queriedTiles.size(); ++i) {
+        jobs.emplace_back([&, i] {
+            queryTile(queriedTiles[i], tileResults[i]);
+        });
+    }
 
-    std::vector<std::reference_wrapper<const RenderTile>> sortedTiles{ renderTiles.begin(),
-                                                                       renderTiles.end() };
-    std::sort(sortedTiles.begin(), sortedTiles.end(), [](const RenderTile& a, const RenderTile& b) {
-        return std::tie(a.id.canonical.z, a.id.canonical.y, a.id.wrap, a.id.canonical.x) <
-            std::tie(b.id.canonical.z, b.id.canonical.y, b.id.wrap, b.id.canonical.x);
-    });
+    util::runInParallel(*scheduler, jobs, maxQueryHelpers);
 
-    for (const RenderTile& renderTile : sortedTiles) {
-        GeometryCoordinate tileSpaceBoundsMin = TileCoordinate::toGeometryCoordinate(renderTile.id, box.min);
-        if (tileSpaceBoundsMin.x >= util::EXTENT || tileSpaceBoundsMin.y >= util::EXTENT) {
-            continue;
+    for (auto& tileResult : tileResults) {
+        for (auto& layerResult : tileResult) {
+            std::vector<Feature>& features = result[layerResult.first];
+            std::move(layerResult.second.begin(), layerResult.second.end(), std::back_inserter(features));
         }
+    }
 
-        GeometryCoordinate tileSpaceBoundsMax = TileCoordinate::toGeometryCoordinate(renderTile.id, box.max);
-        if (tileSpaceBoundsMax.x < 0 || tileSpaceBoundsMax.y < 0) {
-            continue;
+    return result;
+}
+
+void TilePyramid::queryRenderedFeatureBatch(QueryBatch& batch,
+                                            const std::vector<ScreenLineString>& geometries,
+                                            const TransformState& transformState,
+                                            const std::vector<const RenderLayer*>& layers,
+                                            const RenderedQueryOptions& options) const {
+    if (renderTiles.empty() || geometries.empty()) {
+        return;
+    }
+
+    // Transform every query to world coordinates once, rather than once for every tile.
+    struct WorldQuery {
+        std::size_t index;
+        LineString<double> geometry;
+        mapbox::geometry::box<double> box;
+    };
+    std::vector<WorldQuery> worldQueries;
+    worldQueries.reserve(geometries.size());
+    for (std::size_t i = 0; i < geometries.size(); ++i) {
+        if (!geometries[i].empty()) {
+            LineString<double> queryGeometry = toWorldCoordinates(geometries[i], transformState);
+            const mapbox::geometry::box<double> box = mapbox::geometry::envelope(queryGeometry);
+            worldQueries.push_back({ i, std::move(queryGeometry), box });
         }
+    }
 
-        GeometryCoordinates tileSpaceQueryGeometry;
-        tileSpaceQueryGeometry.reserve(queryGeometry.size());
-        for (const auto& c : queryGeometry) {
-            tileSpaceQueryGeometry.push_back(TileCoordinate::toGeometryCoordinate(renderTile.id, c));
+    // Hand each tile all of the queries that overlap it at once, so that it visits its feature
+    // index once over the union of their bounding boxes, and decodes each candidate feature only
+    // once for all of them. Symbols are still looked up per query in the collision tile.
+    TileQueryGeometries tileQueryGeometries;
+    for (const RenderTile& renderTile : getSortedRenderTiles()) {
+        tileQueryGeometries.clear();
+        for (const WorldQuery& query : worldQueries) {
+            if (tileIntersects(renderTile.id, query.box)) {
+                tileQueryGeometries.emplace_back(query.index, toTileCoordinates(renderTile.id, query.geometry));
+            }
         }
 
-        renderTile.tile.queryRenderedFeatures(result,
-                                              tileSpaceQueryGeometry,
-                                              transformState,
-                                              layers,
-                                              options);
+        if (!tileQueryGeometries.empty()) {
+            renderTile.tile.queryRenderedFeatureBatch(batch, tileQueryGeometries, transformState, layers, options);
+        }
     }
-
-    return result;
 }
 
 std::vector<Feature> TilePyramid::querySourceFeatures(const SourceQueryOptions& options) const {
     std::vector<Feature> result;
+    SourceFeatureIDs returned;
 
     for (const auto& pair : tiles) {
-        pair.second->querySourceFeatures(result, options);
+        pair.second->querySourceFeatures(result, options, returned);
     }
 
     return result;
@@ -25,6 +25,7 @@ class RenderLayer;
 class RenderedQueryOptions;
 class SourceQueryOptions;
 class TileParameters;
+class Scheduler;
 
 class TilePyramid {
 public:
@@ -51,7 +52,14 @@ public:
     queryRenderedFeatures(const ScreenLineString& geometry,
                           const TransformState& transformState,
                           const std::vector<const RenderLayer*>&,
-                          const RenderedQueryOptions& options) const;
+                          const RenderedQueryOptions& options,
+                          Scheduler* scheduler) const;
+
+    void queryRenderedFeatureBatch(QueryBatch&,
+                                   const std::vector<ScreenLineString>& geometries,
+                                   const TransformState& transformState,
+                                   const std::vector<const RenderLayer*>&,
+                                   const RenderedQueryOptions& options) const;
 
     std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const;
 
@@ -69,6 +77,10 @@ public:
     std::vector<RenderTile> renderTiles;
 
     TileObserver* observer = nullptr;
+
+private:
+    // The render tiles in the order in which queries combine their results.
+    std::vector<std::reference_wrapper<const RenderTile>> getSortedRenderTiles() const;
 };
 
 } // namespace mbgl
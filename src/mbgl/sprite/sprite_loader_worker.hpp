@@ -2,9 +2,7 @@
 
 #include <mbgl/actor/actor_ref.hpp>
 #include <mbgl/sprite/sprite_parser.hpp>
-
-#include <memory>
-#include <string>
+#include <mbgl/util/shared_buffer.hpp>
 
 namespace mbgl {
 
@@ -14,7 +12,7 @@ class SpriteLoaderWorker {
 public:
     SpriteLoaderWorker(ActorRef<SpriteLoaderWorker>, ActorRef<SpriteLoader>);
 
-    void parse(std::shared_ptr<const std::string> image, std::shared_ptr<const std::string> json);
+    void parse(SharedBuffer image, SharedBuffer json);
 
 private:
     ActorRef<SpriteLoader> parent;
@@ -0,0 +1,81 @@
+#include <mbgl/storage/adaptive_concurrency.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace mbgl {
+
+namespace {
+
+// Small windows are too noisy to judge the latency or throughput.
+const uint32_t minimumWindowSize = 8;
+
+// Average latency in a window, relative to the minimum latency, above which we consider the
+// network or the server to be congested.
+const double congestedLatencyRatio = 2.0;
+
+// Relative throughput increase that justifies raising the limit further.
+const double throughputGain = 1.05;
+
+// The minimum latency is re-established periodically so that we follow changes in the network,
+// e.g. when switching from Wi-Fi to a cellular connection.
+const uint32_t minLatencyWindows = 20;
+
+} // namespace
+
+AdaptiveConcurrency::AdaptiveConcurrency(uint32_t initial, uint32_t minimum_, uint32_t maximum_)
+    : minimum(minimum_),
+      maximum(maximum_),
+      limit(std::min(std::max(initial, minimum_), maximum_)) {
+    assert(minimum > 0 && minimum <= maximum);
+}
+
+void AdaptiveConcurrency::addSample(Duration latency, uint64_t bytes_, TimePoint completed, bool saturated) {
+    if (samples == 0) {
+        // The window starts when the first of its requests was sent, which we approximate with the
+        // time at which the first response started arriving.
+        windowStart = completed - latency;
+    }
+
+    samples++;
+    if (saturated) {
+        saturatedSamples++;
+    }
+    bytes += bytes_;
+    totalLatency += latency;
+    windowMinLatency = std::min(windowMinLatency, latency);
+    lastCompleted = std::max(lastCompleted, completed);
+
+    if (samples >= std::max(limit, minimumWindowSize)) {
+        evaluateWindow();
+    }
+}
+
+void AdaptiveConcurrency::evaluateWindow() {
+    if (++windowsSinceMinLatency >= minLatencyWindows) {
+        minLatency = windowMinLatency;
+        windowsSinceMinLatency = 0;
+    } else {
+        minLatency = std::min(minLatency, windowMinLatency);
+    }
+
+    const Duration averageLatency = totalLatency / samples;
+    const double elapsed = std::chrono::duration<double>(lastCompleted - windowStart).count();
+    const double throughput = elapsed > 0 ? bytes / elapsed : 0;
+
+    if (averageLatency > minLatency * congestedLatencyRatio) {
+        limit = std::max(minimum, limit * 3 / 4);
+    } else if (saturatedSamples * 2 >= samples && throughput >= lastThroughput * throughputGain) {
+        limit = std::min(maximum, limit + std::max(1u, limit / 4));
+    }
+
+    lastThroughput = throughput;
+
+    samples = 0;
+    saturatedSamples = 0;
+    bytes = 0;
+    totalLatency = Duration::zero();
+    windowMinLatency = Duration::max();
+}
+
+} // namespace mbgl
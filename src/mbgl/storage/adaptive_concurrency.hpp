@@ -0,0 +1,49 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstdint>
+
+namespace mbgl {
+
+/*
+ * Adapts the number of concurrent requests to network conditions, based on completed requests.
+ *
+ * Samples are evaluated in windows of roughly `limit` requests. When the average latency in a
+ * window rises well above the lowest latency we've seen, requests are queueing up on the way to
+ * or in the server and the limit is reduced. While the limit is actually reached and raising it
+ * increased the throughput, it is raised further; otherwise it is left as is.
+ */
+class AdaptiveConcurrency {
+public:
+    AdaptiveConcurrency(uint32_t initial, uint32_t minimum, uint32_t maximum);
+
+    // Records a completed request. `latency` is the time until the first byte of the response
+    // arrived, `completed` the time at which the response was complete, and `saturated` whether
+    // the limit was reached while the request was in flight.
+    void addSample(Duration latency, uint64_t bytes, TimePoint completed, bool saturated);
+
+    uint32_t getLimit() const { return limit; }
+
+private:
+    void evaluateWindow();
+
+    const uint32_t minimum;
+    const uint32_t maximum;
+    uint32_t limit;
+
+    Duration minLatency = Duration::max();
+    uint32_t windowsSinceMinLatency = 0;
+    double lastThroughput = 0;
+
+    // Current window
+    TimePoint windowStart;
+    uint32_t samples = 0;
+    uint32_t saturatedSamples = 0;
+    uint64_t bytes = 0;
+    Duration totalLatency = Duration::zero();
+    Duration windowMinLatency = Duration::max();
+    TimePoint lastCompleted;
+};
+
+} // namespace mbgl
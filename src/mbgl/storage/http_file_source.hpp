@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/storage/file_source.hpp>
+#include <mbgl/storage/http_connection_mode.hpp>
 
 namespace mbgl {
 
@@ -13,6 +14,17 @@ public:
 
     static uint32_t maximumConcurrentRequests();
 
+    // Selects how requests share connections; affects requests started afterwards. Platforms whose
+    // HTTP stack manages connections on its own ignore this.
+    void setConnectionMode(HTTPConnectionMode);
+
+    // Whether setConnectionMode() can make requests use HTTP/2 on this platform.
+    static bool supportsConnectionModes();
+
+    // The number of requests that should be active at once. Adapts to network conditions in the
+    // multiplexed modes, and is maximumConcurrentRequests() otherwise.
+    uint32_t getConcurrencyLimit() const;
+
     class Impl;
 
 private:
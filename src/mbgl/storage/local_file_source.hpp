@@ -2,6 +2,8 @@
 
 #include <mbgl/storage/file_source.hpp>
 
+#include <cstdint>
+
 namespace mbgl {
 
 namespace util {
@@ -17,6 +19,15 @@ public:
 
     static bool acceptsURL(const std::string& url);
 
+    // Bytes of file contents currently held in memory by responses from any LocalFileSource.
+    // Large files are memory-mapped; those bytes are backed by the page cache and can be
+    // reclaimed by the OS, while smaller files are copied into heap allocations.
+    struct MemoryUsage {
+        uint64_t mapped;
+        uint64_t allocated;
+    };
+    static MemoryUsage getMemoryUsage();
+
 private:
     class Impl;
 
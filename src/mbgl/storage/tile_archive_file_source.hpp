@@ -0,0 +1,30 @@
+#pragma once
+
+#include <mbgl/storage/file_source.hpp>
+
+namespace mbgl {
+
+namespace util {
+template <typename T> class Thread;
+} // namespace util
+
+// Serves tiles from single-file PMTiles archives, addressed as pmtiles:///path/to/archive.pmtiles.
+// The same URL works both as a source URL, which yields a TileJSON document describing the
+// archive, and as a tile URL template, in which case the tile coordinates are taken from the
+// resource's tile data.
+class TileArchiveFileSource : public FileSource {
+public:
+    TileArchiveFileSource();
+    ~TileArchiveFileSource() override;
+
+    std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+
+    static bool acceptsURL(const std::string& url);
+
+private:
+    class Impl;
+
+    std::unique_ptr<util::Thread<Impl>> impl;
+};
+
+} // namespace mbgl
@@ -1,6 +1,7 @@
 #include <mbgl/style/conversion.hpp>
 #include <mbgl/style/rapidjson_conversion.hpp>
 
+#include <cstddef>
 #include <string>
 #include <sstream>
 
@@ -8,10 +9,11 @@ namespace mbgl {
 namespace style {
 namespace conversion {
 
+// Parses `length` bytes of JSON in place; the bytes need not be null-terminated.
 template <class T, class...Args>
-optional<T> convertJSON(const std::string& json, Error& error, Args&&...args) {
+optional<T> convertJSON(const char* json, std::size_t length, Error& error, Args&&...args) {
     JSDocument document;
-    document.Parse<0>(json.c_str());
+    document.Parse<0>(json, length);
 
     if (document.HasParseError()) {
         std::stringstream message;
@@ -23,6 +25,11 @@ optional<T> convertJSON(const std::string& json, Error& error, Args&&...args) {
     return convert<T>(document, error, std::forward<Args>(args)...);
 }
 
+template <class T, class...Args>
+optional<T> convertJSON(const std::string& json, Error& error, Args&&...args) {
+    return convertJSON<T>(json.data(), json.size(), error, std::forward<Args>(args)...);
+}
+
 } // namespace conversion
 } // namespace style
 } // namespace mbgl
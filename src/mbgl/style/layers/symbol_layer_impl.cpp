@@ -12,5 +12,22 @@ bool SymbolLayer::Impl::hasLayoutDifference(const Layer::Impl& other) const {
            paint.hasDataDrivenPropertyDifference(impl.paint);
 }
 
+void SymbolLayer::Impl::addFontStacks(std::set<FontStack>& fontStacks) const {
+    const PropertyValue<FontStack>& textFont = layout.get<TextFont>();
+    if (textFont.isUndefined()) {
+        fontStacks.insert(TextFont::defaultValue());
+    } else if (textFont.isConstant()) {
+        fontStacks.insert(textFont.asConstant());
+    } else if (textFont.isCameraFunction()) {
+        textFont.asCameraFunction().stops.match(
+            [&] (const auto& stops) {
+                for (const auto& stop : stops.stops) {
+                    fontStacks.insert(stop.second);
+                }
+            }
+        );
+    }
+}
+
 } // namespace style
 } // namespace mbgl
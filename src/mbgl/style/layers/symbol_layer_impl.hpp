@@ -3,6 +3,9 @@
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
+#include <mbgl/util/font_stack.hpp>
+
+#include <set>
 
 namespace mbgl {
 namespace style {
@@ -14,6 +17,9 @@ public:
     bool hasLayoutDifference(const Layer::Impl&) const override;
     void stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const override;
 
+    // Adds the font stacks that `text-font` may evaluate to.
+    void addFontStacks(std::set<FontStack>&) const;
+
     SymbolLayoutProperties::Unevaluated layout;
     SymbolPaintProperties::Transitionable paint;
 };
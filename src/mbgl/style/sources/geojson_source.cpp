@@ -31,8 +31,22 @@ void GeoJSONSource::setURL(const std::string& url_) {
 }
 
 void GeoJSONSource::setGeoJSON(const mapbox::geojson::geojson& geoJSON) {
+    setGeoJSON(GeoJSON(geoJSON));
+}
+
+void GeoJSONSource::setGeoJSON(mapbox::geojson::geojson&& geoJSON) {
     req.reset();
-    baseImpl = makeMutable<Impl>(impl(), geoJSON);
+    baseImpl = makeMutable<Impl>(impl(), std::move(geoJSON));
+    observer->onSourceChanged(*this);
+}
+
+void GeoJSONSource::updateFeatures(const FeatureCollection& features) {
+    baseImpl = makeMutable<Impl>(impl(), features, std::vector<FeatureIdentifier>());
+    observer->onSourceChanged(*this);
+}
+
+void GeoJSONSource::removeFeatures(const std::vector<FeatureIdentifier>& ids) {
+    baseImpl = makeMutable<Impl>(impl(), FeatureCollection(), ids);
     observer->onSourceChanged(*this);
 }
 
@@ -61,7 +75,7 @@ void GeoJSONSource::loadDescription(FileSource& fileSource) {
                 *this, std::make_exception_ptr(std::runtime_error("unexpectedly empty GeoJSON")));
         } else {
             conversion::Error error;
-            optional<GeoJSON> geoJSON = conversion::convertJSON<GeoJSON>(*res.data, error);
+            optional<GeoJSON> geoJSON = conversion::convertJSON<GeoJSON>(res.data.data(), res.data.size(), error);
             if (!geoJSON) {
                 Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: %s",
                            error.message.c_str());
@@ -69,7 +83,7 @@ void GeoJSONSource::loadDescription(FileSource& fileSource) {
                 // tiles to load.
                 baseImpl = makeMutable<Impl>(impl(), GeoJSON{ FeatureCollection{} });
             } else {
-                baseImpl = makeMutable<Impl>(impl(), *geoJSON);
+                baseImpl = makeMutable<Impl>(impl(), std::move(*geoJSON));
             }
 
             loaded = true;
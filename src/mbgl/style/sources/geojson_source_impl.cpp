@@ -2,11 +2,17 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/string.hpp>
+#include <mbgl/util/geometry.hpp>
+#include <mbgl/util/projection.hpp>
+#include <mbgl/math/clamp.hpp>
 
 #include <mapbox/geojsonvt.hpp>
 #include <supercluster.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <set>
 
 namespace mbgl {
 namespace style {
@@ -39,14 +45,7 @@ private:
     mapbox::supercluster::Supercluster impl;
 };
 
-GeoJSONSource::Impl::Impl(std::string id_, GeoJSONOptions options_)
-    : Source::Impl(SourceType::GeoJSON, std::move(id_)),
-      options(std::move(options_)) {
-}
-
-GeoJSONSource::Impl::Impl(const Impl& other, const GeoJSON& geoJSON)
-    : Source::Impl(other),
-      options(other.options) {
+std::unique_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON, const GeoJSONOptions& options) {
     double scale = util::EXTENT / util::tileSize;
 
     if (options.cluster
@@ -56,7 +55,7 @@ GeoJSONSource::Impl::Impl(const Impl& other, const GeoJSON& geoJSON)
         clusterOptions.maxZoom = options.clusterMaxZoom;
         clusterOptions.extent = util::EXTENT;
         clusterOptions.radius = ::round(scale * options.clusterRadius);
-        data = std::make_unique<SuperclusterData>(
+        return std::make_unique<SuperclusterData>(
             geoJSON.get<mapbox::geometry::feature_collection<double>>(), clusterOptions);
     } else {
         mapbox::geojsonvt::Options vtOptions;
@@ -64,7 +63,234 @@ GeoJSONSource::Impl::Impl(const Impl& other, const GeoJSON& geoJSON)
         vtOptions.extent = util::EXTENT;
         vtOptions.buffer = ::round(scale * options.buffer);
         vtOptions.tolerance = scale * options.tolerance;
-        data = std::make_unique<GeoJSONVTData>(geoJSON, vtOptions);
+        return std::make_unique<GeoJSONVTData>(geoJSON, vtOptions);
+    }
+}
+
+namespace {
+
+// Once this many features have been changed since the data was set, the changes are merged into
+// the data, which is then indexed again from scratch.
+constexpr std::size_t maxChangedFeatures = 4096;
+
+FeatureCollection toFeatures(const GeoJSON& geoJSON) {
+    return geoJSON.match(
+        [] (const mapbox::geometry::geometry<double>& geometry) {
+            return FeatureCollection { Feature { geometry } };
+        },
+        [] (const Feature& feature) {
+            return FeatureCollection { feature };
+        },
+        [] (const FeatureCollection& features) {
+            return features;
+        });
+}
+
+template <class Fn>
+void forEachFeature(const GeoJSON& geoJSON, Fn&& fn) {
+    geoJSON.match(
+        [] (const mapbox::geometry::geometry<double>&) {},
+        [&] (const Feature& feature) {
+            fn(feature);
+        },
+        [&] (const FeatureCollection& features) {
+            for (const auto& feature : features) {
+                fn(feature);
+            }
+        });
+}
+
+optional<GeoJSONFeatureChange::Area> featureArea(const mapbox::geometry::geometry<double>& geometry) {
+    optional<GeoJSONFeatureChange::Area> area;
+    forEachPoint(geometry, [&] (const Point<double>& point) {
+        const LatLng latLng(util::clamp(point.y, -util::LATITUDE_MAX, util::LATITUDE_MAX), point.x);
+        const Point<double> p = Projection::project(latLng, 1) / double(util::tileSize);
+        if (!area) {
+            area = GeoJSONFeatureChange::Area { p.x, p.y, p.x, p.y };
+        } else {
+            area->x1 = std::min(area->x1, p.x);
+            area->y1 = std::min(area->y1, p.y);
+            area->x2 = std::max(area->x2, p.x);
+            area->y2 = std::max(area->y2, p.y);
+        }
+    });
+
+    if (area) {
+        if (area->x2 - area->x1 >= 1) {
+            // The area covers every longitude.
+            area->x1 = 0;
+            area->x2 = 1;
+        } else {
+            // Move the area into the world copy that contains its western edge.
+            const double shift = std::floor(area->x1);
+            area->x1 -= shift;
+            area->x2 -= shift;
+        }
+    }
+    return area;
+}
+
+// Indexes the areas covered by the features of a data set by their IDs.
+std::shared_ptr<const GeoJSONFeatureAreas> indexAreas(const GeoJSON& geoJSON) {
+    auto areas = std::make_shared<GeoJSONFeatureAreas>();
+    forEachFeature(geoJSON, [&] (const Feature& feature) {
+        if (feature.id) {
+            if (auto area = featureArea(feature.geometry)) {
+                (*areas)[*feature.id] = *area;
+            }
+        }
+    });
+    return std::move(areas);
+}
+
+} // namespace
+
+bool GeoJSONFeatureChange::affects(const CanonicalTileID& tileID, double buffer) const {
+    const double scale = std::pow(2.0, tileID.z);
+    const double x1 = (tileID.x - buffer) / scale;
+    const double y1 = (tileID.y - buffer) / scale;
+    const double x2 = (tileID.x + 1 + buffer) / scale;
+    const double y2 = (tileID.y + 1 + buffer) / scale;
+
+    for (const Area& area : areas) {
+        if (area.y1 > y2 || area.y2 < y1) {
+            continue;
+        }
+        // Features that cross the antimeridian appear in the tiles of the neighbouring world copies.
+        for (const double wrap : { -1.0, 0.0, 1.0 }) {
+            if (area.x1 + wrap <= x2 && area.x2 + wrap >= x1) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+GeoJSON GeoJSONFeatureChange::applyTo(const GeoJSON* geoJSON) const {
+    std::vector<const GeoJSONFeatureChange*> chain;
+    for (const GeoJSONFeatureChange* change = this; change; change = change->previous.get()) {
+        chain.push_back(change);
+    }
+
+    FeatureCollection features = geoJSON ? toFeatures(*geoJSON) : FeatureCollection();
+    std::vector<bool> present(features.size(), true);
+    std::map<FeatureIdentifier, std::size_t> positions;
+    for (std::size_t i = 0; i < features.size(); ++i) {
+        if (features[i].id) {
+            positions[*features[i].id] = i;
+        }
+    }
+
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        for (const auto& feature : (*it)->updated) {
+            auto position = positions.find(*feature.id);
+            if (position == positions.end()) {
+                positions.emplace(*feature.id, features.size());
+                features.push_back(feature);
+                present.push_back(true);
+            } else {
+                features[position->second] = feature;
+                present[position->second] = true;
+            }
+        }
+        for (const auto& id : (*it)->removed) {
+            auto position = positions.find(id);
+            if (position != positions.end()) {
+                present[position->second] = false;
+            }
+        }
+    }
+
+    FeatureCollection result;
+    result.reserve(features.size());
+    for (std::size_t i = 0; i < features.size(); ++i) {
+        if (present[i]) {
+            result.push_back(std::move(features[i]));
+        }
+    }
+    return GeoJSON { std::move(result) };
+}
+
+GeoJSONSource::Impl::Impl(std::string id_, GeoJSONOptions options_)
+    : Source::Impl(SourceType::GeoJSON, std::move(id_)),
+      options(std::move(options_)) {
+}
+
+GeoJSONSource::Impl::Impl(const Impl& other, GeoJSON&& geoJSON_)
+    : Source::Impl(other),
+      options(other.options),
+      geoJSON(std::make_shared<const GeoJSON>(std::move(geoJSON_))) {
+}
+
+GeoJSONSource::Impl::Impl(const Impl& other, FeatureCollection updated, std::vector<FeatureIdentifier> removed)
+    : Source::Impl(other),
+      options(other.options),
+      geoJSON(other.geoJSON),
+      areas(other.areas),
+      changes(other.changes) {
+    // Features without an ID can't be matched with their previous versions.
+    updated.erase(std::remove_if(updated.begin(), updated.end(),
+                                 [] (const Feature& feature) { return !feature.id; }),
+                  updated.end());
+
+    auto change = std::make_shared<GeoJSONFeatureChange>();
+
+    // Find the areas of the current versions of the changed features: the most recent change that
+    // mentions them decides, or else the data the changes were made to.
+    std::set<FeatureIdentifier> ids;
+    for (const auto& feature : updated) {
+        ids.insert(*feature.id);
+    }
+    ids.insert(removed.begin(), removed.end());
+
+    std::set<FeatureIdentifier> found;
+    for (const GeoJSONFeatureChange* previous = changes.get(); previous && found.size() < ids.size();
+         previous = previous->previous.get()) {
+        for (const auto& id : previous->removed) {
+            if (ids.count(id)) {
+                found.insert(id);
+            }
+        }
+        for (const auto& feature : previous->updated) {
+            if (ids.count(*feature.id) && found.insert(*feature.id).second) {
+                if (auto area = featureArea(feature.geometry)) {
+                    change->areas.push_back(*area);
+                }
+            }
+        }
+    }
+    if (geoJSON && found.size() < ids.size()) {
+        // Scanning the data for every change would be slow for large data sets, so its features
+        // are indexed once and the index is shared by all later changes to the same data.
+        if (!areas) {
+            areas = indexAreas(*geoJSON);
+        }
+        for (const auto& id : ids) {
+            auto it = areas->find(id);
+            if (it != areas->end() && !found.count(id)) {
+                change->areas.push_back(it->second);
+            }
+        }
+    }
+
+    for (const auto& feature : updated) {
+        if (auto area = featureArea(feature.geometry)) {
+            change->areas.push_back(*area);
+        }
+    }
+
+    change->length = (changes ? changes->length : 0) + 1;
+    change->featureCount = (changes ? changes->featureCount : 0) + updated.size() + removed.size();
+    change->updated = std::move(updated);
+    change->removed = std::move(removed);
+    change->previous = changes;
+
+    if (!geoJSON || change->featureCount > maxChangedFeatures) {
+        geoJSON = std::make_shared<const GeoJSON>(change->applyTo(geoJSON.get()));
+        areas.reset();
+        changes.reset();
+    } else {
+        changes = std::move(change);
     }
 }
 
@@ -74,8 +300,16 @@ Range<uint8_t> GeoJSONSource::Impl::getZoomRange() const {
     return { options.minzoom, options.maxzoom };
 }
 
-GeoJSONData* GeoJSONSource::Impl::getData() const {
-    return data.get();
+const GeoJSONOptions& GeoJSONSource::Impl::getOptions() const {
+    return options;
+}
+
+std::shared_ptr<const GeoJSON> GeoJSONSource::Impl::getGeoJSON() const {
+    return geoJSON;
+}
+
+std::shared_ptr<const GeoJSONFeatureChange> GeoJSONSource::Impl::getChanges() const {
+    return changes;
 }
 
 optional<std::string> GeoJSONSource::Impl::getAttribution() const {
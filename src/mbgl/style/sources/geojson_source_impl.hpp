@@ -3,6 +3,11 @@
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/util/range.hpp>
+#include <mbgl/util/feature.hpp>
+
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace mbgl {
 
@@ -11,26 +16,76 @@ class CanonicalTileID;
 
 namespace style {
 
+// An index of GeoJSON data that slices it into tiles. Building an index and slicing tiles from it
+// is expensive for large data, so both happen on a worker thread; see GeoJSONSourceWorker.
 class GeoJSONData {
 public:
+    static std::unique_ptr<GeoJSONData> create(const GeoJSON&, const GeoJSONOptions&);
+
     virtual ~GeoJSONData() = default;
     virtual mapbox::geometry::feature_collection<int16_t> getTile(const CanonicalTileID&) = 0;
 };
 
+// A change to the features of a GeoJSON source after its data was set. The changes made since then
+// form a chain, from the most recent one back to the first one.
+class GeoJSONFeatureChange {
+public:
+    // An area covered by changed features, in world coordinates (the unit square at zoom level 0).
+    struct Area {
+        double x1;
+        double y1;
+        double x2;
+        double y2;
+    };
+
+    // Features that were added, or that replace the features with the same ID.
+    FeatureCollection updated;
+    // IDs of the features that were removed.
+    std::vector<FeatureIdentifier> removed;
+    // The areas covered by the changed features, both before and after the change.
+    std::vector<Area> areas;
+
+    std::shared_ptr<const GeoJSONFeatureChange> previous;
+    // The number of changes in the chain, up to and including this one.
+    std::size_t length;
+    // The number of features changed in the chain, up to and including this one.
+    std::size_t featureCount;
+
+    // Whether the tile, including a buffer of `buffer` tile units around it, contains any of the
+    // changed areas.
+    bool affects(const CanonicalTileID&, double buffer) const;
+
+    // Returns the data with the chain of changes up to and including this one merged into it.
+    GeoJSON applyTo(const GeoJSON*) const;
+};
+
+// The areas covered by the features of a data set, by feature ID.
+using GeoJSONFeatureAreas = std::map<FeatureIdentifier, GeoJSONFeatureChange::Area>;
+
 class GeoJSONSource::Impl : public Source::Impl {
 public:
     Impl(std::string id, GeoJSONOptions);
-    Impl(const GeoJSONSource::Impl&, const GeoJSON&);
+    Impl(const GeoJSONSource::Impl&, GeoJSON&&);
+    Impl(const GeoJSONSource::Impl&, FeatureCollection updated, std::vector<FeatureIdentifier> removed);
     ~Impl() final;
 
     Range<uint8_t> getZoomRange() const;
-    GeoJSONData* getData() const;
+    const GeoJSONOptions& getOptions() const;
+
+    // The data of the source, or null until data has been set.
+    std::shared_ptr<const GeoJSON> getGeoJSON() const;
+
+    // The changes made to the features since the data was set, or null if there are none.
+    std::shared_ptr<const GeoJSONFeatureChange> getChanges() const;
 
     optional<std::string> getAttribution() const final;
 
 private:
     GeoJSONOptions options;
-    std::unique_ptr<GeoJSONData> data;
+    std::shared_ptr<const GeoJSON> geoJSON;
+    // The areas of the features of `geoJSON`, indexed when its features are first changed.
+    std::shared_ptr<const GeoJSONFeatureAreas> areas;
+    std::shared_ptr<const GeoJSONFeatureChange> changes;
 };
 
 } // namespace style
@@ -0,0 +1,48 @@
+#include <mbgl/text/bidi_cache.hpp>
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/util/traits.hpp>
+
+#include <boost/functional/hash.hpp>
+
+namespace mbgl {
+
+BiDiCache::BiDiCache(std::size_t capacity)
+    : cache(capacity) {
+}
+
+std::size_t BiDiCache::KeyHash::operator()(const Key& key) const {
+    std::size_t seed = 0;
+    boost::hash_combine(seed, underlying_type(key.operation));
+    boost::hash_combine(seed, std::hash<std::u16string>{}(key.text));
+    boost::hash_range(seed, key.lineBreaks.begin(), key.lineBreaks.end());
+    return seed;
+}
+
+bool BiDiCache::KeyEqual::operator()(const Key& lhs, const Key& rhs) const {
+    return lhs.operation == rhs.operation &&
+        lhs.text == rhs.text &&
+        lhs.lineBreaks == rhs.lineBreaks;
+}
+
+std::u16string BiDiCache::applyArabicShaping(const std::u16string& text) {
+    std::vector<std::u16string> lines = cache.get(Key { Operation::ArabicShaping, text, {} }, [&] {
+        return std::vector<std::u16string> { mbgl::applyArabicShaping(text) };
+    });
+    return std::move(lines.front());
+}
+
+std::vector<std::u16string> BiDiCache::processText(BiDi& bidi, const std::u16string& text, std::set<std::size_t> lineBreaks) {
+    return cache.get(Key { Operation::ProcessText, text, lineBreaks }, [&] {
+        return bidi.processText(text, std::move(lineBreaks));
+    });
+}
+
+void BiDiCache::clear() {
+    cache.clear();
+}
+
+BiDiCache::Stats BiDiCache::getStats() const {
+    return cache.getStats();
+}
+
+} // namespace mbgl
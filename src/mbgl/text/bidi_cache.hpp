@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mbgl/util/lru_cache.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+class BiDi;
+
+/*
+    BiDiCache holds the results of `applyArabicShaping` and `BiDi::processText` for recently laid
+    out labels, so that the same street and place names don't go through ICU again in every tile
+    and at every zoom level that shows them.
+
+    Both results only depend on the text and, for `processText`, on the line breaks, which makes
+    them valid for any font stack and glyph URL. The cache holds at most `capacity` results and
+    drops the least recently used ones first. All methods may be called from any thread.
+*/
+class BiDiCache : private util::noncopyable {
+private:
+    enum class Operation : uint8_t {
+        ArabicShaping,
+        ProcessText
+    };
+
+    struct Key {
+        Operation operation;
+        std::u16string text;
+        std::set<std::size_t> lineBreaks;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key&) const;
+    };
+
+    struct KeyEqual {
+        bool operator()(const Key&, const Key&) const;
+    };
+
+    // The lines of each result; Arabic shaping results have a single line.
+    using Cache = LRUCache<Key, std::vector<std::u16string>, KeyHash, KeyEqual>;
+
+public:
+    BiDiCache(std::size_t capacity = 4096);
+
+    // Same as `mbgl::applyArabicShaping`.
+    std::u16string applyArabicShaping(const std::u16string&);
+
+    // Same as `bidi.processText`.
+    std::vector<std::u16string> processText(BiDi& bidi, const std::u16string&, std::set<std::size_t> lineBreaks);
+
+    void clear();
+
+    using Stats = Cache::Stats;
+
+    Stats getStats() const;
+
+private:
+    Cache cache;
+};
+
+} // namespace mbgl
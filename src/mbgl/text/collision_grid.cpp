@@ -0,0 +1,52 @@
+#include <mbgl/text/collision_grid.hpp>
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/math/clamp.hpp>
+
+#include <cassert>
+#include <cmath>
+
+namespace mbgl {
+
+template <class T>
+CollisionGrid<T>::CollisionGrid(const BBox& bounds_, int32_t n_) :
+    bounds(bounds_),
+    n(n_),
+    scaleX(n / (bounds.x2 - bounds.x1)),
+    scaleY(n / (bounds.y2 - bounds.y1)) {
+    assert(n > 0 && bounds.x1 < bounds.x2 && bounds.y1 < bounds.y2);
+    cells.resize(n * n);
+}
+
+template <class T>
+void CollisionGrid<T>::insert(T&& t, const BBox& bbox) {
+    const auto uid = static_cast<uint32_t>(elements.size());
+
+    const CellRange range = cellRange(bbox);
+    for (int32_t y = range.y1; y <= range.y2; ++y) {
+        for (int32_t x = range.x1; x <= range.x2; ++x) {
+            cells[n * y + x].push_back(uid);
+        }
+    }
+
+    elements.push_back(std::move(t));
+    boxes.push_back(bbox);
+}
+
+template <class T>
+typename CollisionGrid<T>::CellRange CollisionGrid<T>::cellRange(const BBox& bbox) const {
+    return CellRange {
+        convertToCellCoord(bbox.x1, bounds.x1, scaleX),
+        convertToCellCoord(bbox.y1, bounds.y1, scaleY),
+        convertToCellCoord(bbox.x2, bounds.x1, scaleX),
+        convertToCellCoord(bbox.y2, bounds.y1, scaleY)
+    };
+}
+
+template <class T>
+int32_t CollisionGrid<T>::convertToCellCoord(float coord, float origin, float scale) const {
+    return util::clamp(std::floor((coord - origin) * scale), 0.0f, n - 1.0f);
+}
+
+template class CollisionGrid<CollisionTreeBox>;
+
+} // namespace mbgl
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <mbgl/math/minmax.hpp>
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace mbgl {
+
+/*
+    CollisionGrid is a uniform grid index for the collision boxes of placed labels. Like
+    `GridIndex`, it keeps its elements in a single vector and stores element indices in the
+    cells they overlap, so that inserting a box never rebalances anything.
+
+    Boxes that extend beyond the bounds of the grid are assigned to the cells along its border.
+    Queries report each intersecting element once, without keeping track of the elements they have
+    seen: an element is only reported by the first cell that both it and the query box cover.
+*/
+template <class T>
+class CollisionGrid {
+public:
+    struct BBox {
+        float x1;
+        float y1;
+        float x2;
+        float y2;
+    };
+
+    // Divides `bounds` into n × n cells.
+    CollisionGrid(const BBox& bounds, int32_t n);
+
+    void insert(T&&, const BBox&);
+
+    // Calls `visitor` for each element whose box intersects or touches the query box, in no
+    // particular order. Stops as soon as `visitor` returns false, and returns false in that case.
+    template <class Visitor>
+    bool query(const BBox&, Visitor&&) const;
+
+    // Calls `visitor` for each element, in insertion order.
+    template <class Visitor>
+    void forEach(Visitor&& visitor) const {
+        for (const T& element : elements) {
+            visitor(element);
+        }
+    }
+
+    bool empty() const { return elements.empty(); }
+    std::size_t size() const { return elements.size(); }
+
+private:
+    struct CellRange {
+        int32_t x1;
+        int32_t y1;
+        int32_t x2;
+        int32_t y2;
+    };
+
+    CellRange cellRange(const BBox&) const;
+    int32_t convertToCellCoord(float coord, float origin, float scale) const;
+
+    const BBox bounds;
+    const int32_t n;
+    const float scaleX;
+    const float scaleY;
+
+    std::vector<T> elements;
+    std::vector<BBox> boxes;
+    std::vector<std::vector<uint32_t>> cells;
+};
+
+template <class T>
+template <class Visitor>
+bool CollisionGrid<T>::query(const BBox& queryBox, Visitor&& visitor) const {
+    const CellRange range = cellRange(queryBox);
+
+    for (int32_t y = range.y1; y <= range.y2; ++y) {
+        for (int32_t x = range.x1; x <= range.x2; ++x) {
+            for (const uint32_t uid : cells[n * y + x]) {
+                const BBox& box = boxes[uid];
+                if (queryBox.x1 > box.x2 || queryBox.y1 > box.y2 ||
+                    queryBox.x2 < box.x1 || queryBox.y2 < box.y1) {
+                    continue;
+                }
+
+                const CellRange elementRange = cellRange(box);
+                if (x != util::max(elementRange.x1, range.x1) ||
+                    y != util::max(elementRange.y1, range.y1)) {
+                    continue;
+                }
+
+                if (!visitor(elements[uid])) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace mbgl
@@ -13,6 +13,16 @@
 
 namespace mbgl {
 
+// Number of grid cells along each side of the rotated tile.
+static constexpr int32_t gridSize = 32;
+
+static Grid::BBox toGridBox(const Box& box) {
+    return Grid::BBox {
+        box.min_corner().get<0>(), box.min_corner().get<1>(),
+        box.max_corner().get<0>(), box.max_corner().get<1>()
+    };
+}
+
 CollisionTile::CollisionTile(PlacementConfig config_) : config(std::move(config_)) {
     // Compute the transformation matrix.
     const float angle_sin = std::sin(config.angle);
@@ -37,6 +47,37 @@ CollisionTile::CollisionTile(PlacementConfig config_) : config(std::move(config_
     yStretch = util::max(
         1.0f, util::division(config.cameraToTileDistance,
                              config.cameraToCenterDistance * std::cos(config.pitch), 1.0f));
+
+    if (config.collisionIndex == CollisionIndexType::Grid) {
+        // Cover the rotated tile, including a buffer for labels that extend beyond its edges.
+        const float lower = -util::EXTENT / 8.0f;
+        const float upper = util::EXTENT - lower;
+        const auto tl = util::matrixMultiply(rotationMatrix, Point<float>(lower, lower));
+        const auto tr = util::matrixMultiply(rotationMatrix, Point<float>(upper, lower));
+        const auto bl = util::matrixMultiply(rotationMatrix, Point<float>(lower, upper));
+        const auto br = util::matrixMultiply(rotationMatrix, Point<float>(upper, upper));
+        const Grid::BBox bounds {
+            util::min(tl.x, tr.x, bl.x, br.x),
+            util::min(tl.y, tr.y, bl.y, br.y),
+            util::max(tl.x, tr.x, bl.x, br.x),
+            util::max(tl.y, tr.y, bl.y, br.y)
+        };
+        grid.emplace(bounds, gridSize);
+        ignoredGrid.emplace(bounds, gridSize);
+    }
+}
+
+template <class Visitor>
+void CollisionTile::queryIntersecting(const Box& box, Visitor&& visitor) const {
+    if (grid) {
+        grid->query(toGridBox(box), visitor);
+    } else {
+        for (auto it = tree.qbegin(bgi::intersects(box)); it != tree.qend(); ++it) {
+            if (!visitor(*it)) {
+                return;
+            }
+        }
+    }
 }
 
 float CollisionTile::findPlacementScale(const Point<float>& anchor, const CollisionBox& box, const float boxMaxScale, const Point<float>& blockingAnchor, const CollisionBox& blocking) {
@@ -101,13 +142,14 @@ float CollisionTile::placeFeature(const CollisionFeature& feature, bool allowOve
         const float boxMaxScale = box.adjustedMaxScale(rotationMatrix, yStretch);
 
         if (!allowOverlap) {
-            for (auto it = tree.qbegin(bgi::intersects(getTreeBox(anchor, box))); it != tree.qend(); ++it) {
-                const CollisionBox& blocking = std::get<1>(*it);
+            queryIntersecting(getTreeBox(anchor, box), [&] (const CollisionTreeBox& treeBox) {
+                const CollisionBox& blocking = std::get<1>(treeBox);
                 Point<float> blockingAnchor = util::matrixMultiply(rotationMatrix, blocking.anchor);
 
                 minPlacementScale = util::max(minPlacementScale, findPlacementScale(anchor, box, boxMaxScale, blockingAnchor, blocking));
-                if (minPlacementScale >= maxScale) return minPlacementScale;
-            }
+                return minPlacementScale < maxScale;
+            });
+            if (minPlacementScale >= maxScale) return minPlacementScale;
         }
 
         if (avoidEdges) {
@@ -141,11 +183,20 @@ void CollisionTile::insertFeature(CollisionFeature& feature, float minPlacementS
     if (minPlacementScale < maxScale) {
         std::vector<CollisionTreeBox> treeBoxes;
         for (auto& box : feature.boxes) {
+            maxBoxOffsetX = util::max(maxBoxOffsetX, std::abs(box.x1), std::abs(box.x2));
+            maxBoxOffsetY = util::max(maxBoxOffsetY, std::abs(box.y1), std::abs(box.y2));
+
             CollisionBox adjustedBox = box;
             box.maxScale = box.adjustedMaxScale(rotationMatrix, yStretch);
             treeBoxes.emplace_back(getTreeBox(util::matrixMultiply(rotationMatrix, box.anchor), box), std::move(adjustedBox), feature.indexedFeature);
         }
-        if (ignorePlacement) {
+        if (grid) {
+            Grid& target = ignorePlacement ? *ignoredGrid : *grid;
+            for (auto& treeBox : treeBoxes) {
+                const Grid::BBox bbox = toGridBox(std::get<0>(treeBox));
+                target.insert(std::move(treeBox), bbox);
+            }
+        } else if (ignorePlacement) {
             ignoredTree.insert(treeBoxes.begin(), treeBoxes.end());
         } else {
             tree.insert(treeBoxes.begin(), treeBoxes.end());
@@ -195,7 +246,8 @@ Box CollisionTile::getTreeBox(const Point<float>& anchor, const CollisionBox& bo
 
 std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const GeometryCoordinates& queryGeometry, float scale) const {
     std::vector<IndexedSubfeature> result;
-    if (queryGeometry.empty() || (tree.empty() && ignoredTree.empty())) {
+    if (queryGeometry.empty() || (tree.empty() && ignoredTree.empty() &&
+                                  (!grid || (grid->empty() && ignoredGrid->empty())))) {
         return result;
     }
 
@@ -258,8 +310,42 @@ std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const Geometr
         }
     };
 
-    queryTree(tree);
-    queryTree(ignoredTree);
+    // The grids index boxes scaled by `perspectiveRatio` around their anchors, but they're
+    // rendered scaled by `1 / perspectiveScale`. Expand the bounding box of the query polygon by
+    // the most that any box edge can move between the two, so that it finds every box the polygon
+    // may intersect; the exact test then only runs on those candidates.
+    Grid::BBox queryBox { 0, 0, 0, 0 };
+    auto queryGrid = [&](const Grid& grid_) {
+        grid_.query(queryBox, [&](const CollisionTreeBox& treeBox) {
+            if (seenFeature(treeBox) && visibleAtScale(treeBox) && intersectsAtScale(treeBox)) {
+                const IndexedSubfeature& feature = std::get<2>(treeBox);
+                sourceLayerFeatures[feature.sourceLayerName].insert(feature.index);
+                result.push_back(feature);
+            }
+            return true;
+        });
+    };
+
+    if (grid) {
+        const float growth = std::abs(1 / perspectiveScale - perspectiveRatio);
+        // One more unit accounts for the rounding of the rendered boxes to integer coordinates.
+        const float marginX = maxBoxOffsetX * growth + 1;
+        const float marginY = maxBoxOffsetY * yStretch * growth + 1;
+        queryBox = { polygon[0].x - marginX, polygon[0].y - marginY,
+                     polygon[0].x + marginX, polygon[0].y + marginY };
+        for (const auto& point : polygon) {
+            queryBox.x1 = util::min(queryBox.x1, point.x - marginX);
+            queryBox.y1 = util::min(queryBox.y1, point.y - marginY);
+            queryBox.x2 = util::max(queryBox.x2, point.x + marginX);
+            queryBox.y2 = util::max(queryBox.y2, point.y + marginY);
+        }
+
+        queryGrid(*grid);
+        queryGrid(*ignoredGrid);
+    } else {
+        queryTree(tree);
+        queryTree(ignoredTree);
+    }
 
     return result;
 }
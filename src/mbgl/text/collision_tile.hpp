@@ -1,8 +1,10 @@
 #pragma once
 
 #include <mbgl/text/collision_feature.hpp>
+#include <mbgl/text/collision_grid.hpp>
 #include <mbgl/text/placement_config.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/optional.hpp>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-function"
@@ -35,6 +37,7 @@ using CollisionPoint = bgm::point<float, 2, bg::cs::cartesian>;
 using Box = bgm::box<CollisionPoint>;
 using CollisionTreeBox = std::tuple<Box, CollisionBox, IndexedSubfeature>;
 using Tree = bgi::rtree<CollisionTreeBox, bgi::linear<16, 4>>;
+using Grid = CollisionGrid<CollisionTreeBox>;
 
 class IndexedSubfeature;
 
@@ -62,9 +65,21 @@ private:
             const Point<float>& blockingAnchor, const CollisionBox& blocking);
     Box getTreeBox(const Point<float>& anchor, const CollisionBox& box, const float scale = 1.0);
 
+    // Calls `visitor` for each placed box that intersects the given box until it returns false.
+    template <class Visitor>
+    void queryIntersecting(const Box&, Visitor&&) const;
+
+    // Labels are indexed in either the trees or the grids, depending on `config.collisionIndex`.
     Tree tree;
     Tree ignoredTree;
-    
+    optional<Grid> grid;
+    optional<Grid> ignoredGrid;
+
+    // The largest horizontal and vertical offsets of the inserted boxes from their anchors, which
+    // bound how far a box may grow beyond its indexed extent at other scales.
+    float maxBoxOffsetX = 0;
+    float maxBoxOffsetY = 0;
+
     float perspectiveRatio;
 };
 
@@ -1,36 +1,73 @@
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/text/glyph_manager_observer.hpp>
-#include <mbgl/text/glyph_pbf.hpp>
+#include <mbgl/text/bidi_cache.hpp>
+#include <mbgl/text/local_glyph_rasterizer.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/actor/scheduler.hpp>
 
 namespace mbgl {
 
 static GlyphManagerObserver nullObserver;
 
-GlyphManager::GlyphManager(FileSource& fileSource_)
+GlyphManager::GlyphManager(FileSource& fileSource_, Scheduler& scheduler)
     : fileSource(fileSource_),
-      observer(&nullObserver) {
+      observer(&nullObserver),
+      shapingCache(std::make_shared<ShapingCache>()),
+      bidiCache(std::make_shared<BiDiCache>()),
+      localGlyphRasterizer(std::make_shared<LocalGlyphRasterizer>()),
+      mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())),
+      worker(scheduler, ActorRef<GlyphManager>(*this, mailbox)) {
 }
 
 GlyphManager::~GlyphManager() = default;
 
+void GlyphManager::setURL(const std::string& url) {
+    if (url != glyphURL) {
+        // Glyphs loaded from another URL may have different metrics.
+        shapingCache->clear();
+    }
+    glyphURL = url;
+}
+
+void GlyphManager::setLocalGlyphRasterizer(std::shared_ptr<LocalGlyphRasterizer> rasterizer) {
+    assert(rasterizer);
+    localGlyphRasterizer = std::move(rasterizer);
+    // Local fonts have different metrics than the downloaded glyphs.
+    shapingCache->clear();
+}
+
 void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphDependencies) {
     auto dependencies = std::make_shared<GlyphDependencies>(std::move(glyphDependencies));
 
     // Figure out which glyph ranges need to be fetched. For each range that does need to
     // be fetched, record an entry mapping the requestor to a shared pointer containing the
     // dependencies. When the shared pointer becomes unique, we know that all the dependencies
-    // for that requestor have been fetched, and can notify it of completion.
+    // for that requestor have been fetched, and can notify it of completion. Glyphs that are
+    // rasterized locally are tracked the same way, one glyph at a time.
     for (const auto& dependency : *dependencies) {
         const FontStack& fontStack = dependency.first;
         Entry& entry = entries[fontStack];
 
         const GlyphIDs& glyphIDs = dependency.second;
         GlyphRangeSet ranges;
+        std::vector<GlyphID> rasterize;
         for (const auto& glyphID : glyphIDs) {
-            ranges.insert(getGlyphRange(glyphID));
+            if (!localGlyphRasterizer->canRasterizeGlyph(fontStack, glyphID)) {
+                ranges.insert(getGlyphRange(glyphID));
+            } else if (entry.glyphs.find(glyphID) == entry.glyphs.end()) {
+                auto& requestors = entry.rasterizing[glyphID];
+                if (requestors.empty()) {
+                    rasterize.push_back(glyphID);
+                }
+                requestors[&requestor] = dependencies;
+            }
+        }
+
+        if (!rasterize.empty()) {
+            worker.invoke(&GlyphManagerWorker::rasterize, fontStack, std::move(rasterize), localGlyphRasterizer);
         }
 
         for (const auto& range : ranges) {
@@ -50,6 +87,21 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
     }
 }
 
+void GlyphManager::prefetchGlyphs(const GlyphRangeDependencies& dependencies) {
+    if (glyphURL.empty()) {
+        return;
+    }
+
+    for (const auto& dependency : dependencies) {
+        const FontStack& fontStack = dependency.first;
+        Entry& entry = entries[fontStack];
+
+        for (const auto& range : dependency.second) {
+            requestRange(entry.ranges[range], fontStack, range);
+        }
+    }
+}
+
 void GlyphManager::requestRange(GlyphRequest& request, const FontStack& fontStack, const GlyphRange& range) {
     if (request.req) {
         return;
@@ -62,6 +114,9 @@ void GlyphManager::requestRange(GlyphRequest& request, const FontStack& fontStac
 
 void GlyphManager::processResponse(const Response& res, const FontStack& fontStack, const GlyphRange& range) {
     if (res.error) {
+        if (dropPrefetch(fontStack, range)) {
+            return;
+        }
         observer->onGlyphsError(fontStack, range, std::make_exception_ptr(std::runtime_error(res.error->message)));
         return;
     }
@@ -70,23 +125,27 @@ void GlyphManager::processResponse(const Response& res, const FontStack& fontSta
         return;
     }
 
-    Entry& entry = entries[fontStack];
-    GlyphRequest& request = entry.ranges[range];
+    if (res.noContent) {
+        onParsed(fontStack, range, {});
+        return;
+    }
 
-    if (!res.noContent) {
-        std::vector<Glyph> glyphs;
+    // Parsing a range takes long enough to cause frame drops, so it happens on a worker thread.
+    // Requestors that arrive in the meantime wait for the range like for an outstanding request.
+    worker.invoke(&GlyphManagerWorker::parse, fontStack, range, res.data);
+}
 
-        try {
-            glyphs = parseGlyphPBF(range, *res.data);
-        } catch (...) {
-            observer->onGlyphsError(fontStack, range, std::current_exception());
-            return;
-        }
+void GlyphManager::onParsed(FontStack fontStack, GlyphRange range, std::map<GlyphID, Immutable<Glyph>>&& glyphs) {
+    Entry& entry = entries[fontStack];
+    GlyphRequest& request = entry.ranges[range];
 
-        for (auto& glyph : glyphs) {
-            entry.glyphs.erase(glyph.id);
-            entry.glyphs.emplace(glyph.id, makeMutable<Glyph>(std::move(glyph)));
+    for (auto& glyph : glyphs) {
+        // Glyphs that are rasterized locally keep their look when a range contains both.
+        if (localGlyphRasterizer->canRasterizeGlyph(fontStack, glyph.first)) {
+            continue;
         }
+        entry.glyphs.erase(glyph.first);
+        entry.glyphs.emplace(glyph.first, std::move(glyph.second));
     }
 
     request.parsed = true;
@@ -104,6 +163,52 @@ void GlyphManager::processResponse(const Response& res, const FontStack& fontSta
     observer->onGlyphsLoaded(fontStack, range);
 }
 
+void GlyphManager::onParseError(FontStack fontStack, GlyphRange range, std::exception_ptr error) {
+    if (dropPrefetch(fontStack, range)) {
+        return;
+    }
+    observer->onGlyphsError(fontStack, range, error);
+}
+
+bool GlyphManager::dropPrefetch(const FontStack& fontStack, const GlyphRange& range) {
+    Entry& entry = entries[fontStack];
+    auto it = entry.ranges.find(range);
+    if (it == entry.ranges.end() || it->second.parsed || !it->second.requestors.empty()) {
+        return false;
+    }
+
+    // Only a prefetch is waiting for this range. Forget about it so that the range is requested
+    // again, and errors are reported, once a tile needs it.
+    entry.ranges.erase(it);
+    return true;
+}
+
+void GlyphManager::onRasterized(FontStack fontStack, std::map<GlyphID, Immutable<Glyph>>&& glyphs) {
+    Entry& entry = entries[fontStack];
+
+    for (auto& glyph : glyphs) {
+        entry.glyphs.erase(glyph.first);
+        entry.glyphs.emplace(glyph.first, std::move(glyph.second));
+    }
+
+    for (const auto& glyph : glyphs) {
+        auto it = entry.rasterizing.find(glyph.first);
+        if (it == entry.rasterizing.end()) {
+            continue;
+        }
+
+        for (auto& pair : it->second) {
+            GlyphRequestor& requestor = *pair.first;
+            const std::shared_ptr<GlyphDependencies>& dependencies = pair.second;
+            if (dependencies.unique()) {
+                notify(requestor, *dependencies);
+            }
+        }
+
+        entry.rasterizing.erase(it);
+    }
+}
+
 void GlyphManager::setObserver(GlyphManagerObserver* observer_) {
     observer = observer_ ? observer_ : &nullObserver;
 }
@@ -136,6 +241,9 @@ void GlyphManager::removeRequestor(GlyphRequestor& requestor) {
         for (auto& range : entry.second.ranges) {
             range.second.requestors.erase(&requestor);
         }
+        for (auto& glyph : entry.second.rasterizing) {
+            glyph.second.erase(&requestor);
+        }
     }
 }
 
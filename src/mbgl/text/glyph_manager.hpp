@@ -3,16 +3,24 @@
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/text/glyph_manager_observer.hpp>
 #include <mbgl/text/glyph_range.hpp>
+#include <mbgl/text/glyph_manager_worker.hpp>
+#include <mbgl/actor/actor.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/font_stack.hpp>
 #include <mbgl/util/immutable.hpp>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
 namespace mbgl {
 
 class FileSource;
+class Scheduler;
+class SharedGlyphAtlas;
+class ShapingCache;
+class BiDiCache;
+class LocalGlyphRasterizer;
 class AsyncRequest;
 class Response;
 
@@ -24,7 +32,8 @@ public:
 
 class GlyphManager : public util::noncopyable {
 public:
-    GlyphManager(FileSource&);
+    // Glyph ranges are parsed on `scheduler`.
+    GlyphManager(FileSource&, Scheduler&);
     ~GlyphManager();
 
     // Workers send a `getGlyphs` message to the main thread once they have determined
@@ -35,13 +44,47 @@ public:
     void getGlyphs(GlyphRequestor&, GlyphDependencies);
     void removeRequestor(GlyphRequestor&);
 
-    void setURL(const std::string& url) {
-        glyphURL = url;
-    }
+    // Requests glyph ranges before any tile asks for them, so that they are likely to be
+    // available by the time tile layout finishes. Ranges that fail to load are dropped without
+    // reporting an error, and requested again once a tile needs them.
+    void prefetchGlyphs(const GlyphRangeDependencies&);
+
+    void setURL(const std::string&);
 
     void setObserver(GlyphManagerObserver*);
 
+    // When set, tiles created afterwards pack their glyphs into the shared atlas instead of
+    // building a glyph atlas of their own.
+    void setSharedAtlas(std::shared_ptr<SharedGlyphAtlas> atlas) {
+        sharedAtlas = std::move(atlas);
+    }
+
+    const std::shared_ptr<SharedGlyphAtlas>& getSharedAtlas() const {
+        return sharedAtlas;
+    }
+
+    // Glyphs that `rasterizer` can draw are rasterized on the worker instead of being downloaded.
+    // Only affects glyphs requested afterwards.
+    void setLocalGlyphRasterizer(std::shared_ptr<LocalGlyphRasterizer> rasterizer);
+
+    // Shared by the workers of all tiles to avoid shaping the same label more than once.
+    const std::shared_ptr<ShapingCache>& getShapingCache() const {
+        return shapingCache;
+    }
+
+    // Shared by the workers of all tiles to avoid running the same label through ICU more than
+    // once. Unlike shapings, the results don't depend on the glyphs.
+    const std::shared_ptr<BiDiCache>& getBiDiCache() const {
+        return bidiCache;
+    }
+
 private:
+    // Invoked by GlyphManagerWorker
+    friend class GlyphManagerWorker;
+    void onParsed(FontStack, GlyphRange, std::map<GlyphID, Immutable<Glyph>>&&);
+    void onParseError(FontStack, GlyphRange, std::exception_ptr);
+    void onRasterized(FontStack, std::map<GlyphID, Immutable<Glyph>>&&);
+
     FileSource& fileSource;
     std::string glyphURL;
 
@@ -54,15 +97,26 @@ private:
     struct Entry {
         std::map<GlyphRange, GlyphRequest> ranges;
         std::map<GlyphID, Immutable<Glyph>> glyphs;
+
+        // Glyphs that are being rasterized locally, with the requestors waiting for them.
+        std::map<GlyphID, std::unordered_map<GlyphRequestor*, std::shared_ptr<GlyphDependencies>>> rasterizing;
     };
 
     std::unordered_map<FontStack, Entry, FontStackHash> entries;
 
     void requestRange(GlyphRequest&, const FontStack&, const GlyphRange&);
     void processResponse(const Response&, const FontStack&, const GlyphRange&);
+    bool dropPrefetch(const FontStack&, const GlyphRange&);
     void notify(GlyphRequestor&, const GlyphDependencies&);
 
     GlyphManagerObserver* observer = nullptr;
+    std::shared_ptr<SharedGlyphAtlas> sharedAtlas;
+    std::shared_ptr<ShapingCache> shapingCache;
+    std::shared_ptr<BiDiCache> bidiCache;
+    std::shared_ptr<LocalGlyphRasterizer> localGlyphRasterizer;
+
+    std::shared_ptr<Mailbox> mailbox;
+    Actor<GlyphManagerWorker> worker;
 };
 
 } // namespace mbgl
@@ -0,0 +1,50 @@
+#include <mbgl/text/glyph_manager_worker.hpp>
+#include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/text/glyph_pbf.hpp>
+#include <mbgl/text/local_glyph_rasterizer.hpp>
+#include <mbgl/text/tiny_sdf.hpp>
+
+namespace mbgl {
+
+GlyphManagerWorker::GlyphManagerWorker(ActorRef<GlyphManagerWorker>, ActorRef<GlyphManager> parent_)
+    : parent(std::move(parent_)) {
+}
+
+void GlyphManagerWorker::parse(FontStack fontStack, GlyphRange range, SharedBuffer data) {
+    try {
+        std::map<GlyphID, Immutable<Glyph>> glyphs;
+        for (auto& glyph : parseGlyphPBF(range, data.data(), data.size())) {
+            const GlyphID id = glyph.id;
+            glyphs.erase(id);
+            glyphs.emplace(id, makeMutable<Glyph>(std::move(glyph)));
+        }
+
+        parent.invoke(&GlyphManager::onParsed, fontStack, range, std::move(glyphs));
+    } catch (...) {
+        parent.invoke(&GlyphManager::onParseError, std::move(fontStack), std::move(range), std::current_exception());
+    }
+}
+
+void GlyphManagerWorker::rasterize(FontStack fontStack, std::vector<GlyphID> glyphIDs, std::shared_ptr<LocalGlyphRasterizer> rasterizer) {
+    std::map<GlyphID, Immutable<Glyph>> glyphs;
+
+    for (const GlyphID glyphID : glyphIDs) {
+        Glyph glyph = rasterizer->rasterizeGlyph(fontStack, glyphID);
+        glyph.id = glyphID;
+
+        // Add the border that the glyphs of downloaded ranges have, and encode the distance to
+        // the outline the same way they do.
+        if (glyph.bitmap.valid()) {
+            const uint32_t border = Glyph::borderSize;
+            AlphaImage padded({ glyph.bitmap.size.width + 2 * border, glyph.bitmap.size.height + 2 * border });
+            AlphaImage::copy(glyph.bitmap, padded, { 0, 0 }, { border, border }, glyph.bitmap.size);
+            glyph.bitmap = util::transformRasterToSDF(padded, 8, 0.25);
+        }
+
+        glyphs.emplace(glyphID, makeMutable<Glyph>(std::move(glyph)));
+    }
+
+    parent.invoke(&GlyphManager::onRasterized, std::move(fontStack), std::move(glyphs));
+}
+
+} // namespace mbgl
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/text/glyph_range.hpp>
+#include <mbgl/util/font_stack.hpp>
+#include <mbgl/util/shared_buffer.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+
+class GlyphManager;
+class LocalGlyphRasterizer;
+
+class GlyphManagerWorker {
+public:
+    GlyphManagerWorker(ActorRef<GlyphManagerWorker>, ActorRef<GlyphManager>);
+
+    void parse(FontStack, GlyphRange, SharedBuffer data);
+    void rasterize(FontStack, std::vector<GlyphID>, std::shared_ptr<LocalGlyphRasterizer>);
+
+private:
+    ActorRef<GlyphManager> parent;
+};
+
+} // namespace mbgl
@@ -8,6 +8,10 @@
 
 namespace mbgl {
 
-std::vector<Glyph> parseGlyphPBF(const GlyphRange&, const std::string& data);
+std::vector<Glyph> parseGlyphPBF(const GlyphRange&, const char* data, std::size_t size);
+
+inline std::vector<Glyph> parseGlyphPBF(const GlyphRange& range, const std::string& data) {
+    return parseGlyphPBF(range, data.data(), data.size());
+}
 
 } // namespace mbgl
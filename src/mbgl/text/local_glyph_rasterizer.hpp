@@ -0,0 +1,39 @@
+#pragma once
+
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <memory>
+#include <string>
+
+namespace mbgl {
+
+/*
+    Draws glyphs from a font installed on the device or bundled with the application, so that
+    CJK ideographs don't need to be downloaded range by range. Only ideographs are drawn
+    locally (see util::i18n::isIdeograph), and only when a font family has been given. Platforms
+    without font rendering never draw anything.
+
+    `rasterizeGlyph` returns a greyscale coverage bitmap of the glyph, without a border, along
+    with its metrics. GlyphManagerWorker pads it and turns it into a signed distance field, so
+    that the result can't be told apart from a glyph of a downloaded range.
+
+    `canRasterizeGlyph` is called on the thread that owns the GlyphManager, and `rasterizeGlyph`
+    on its worker, so implementations must allow them to be called concurrently.
+*/
+class LocalGlyphRasterizer {
+public:
+    // Draws ideographs from `fontFamily`. Without a font family, all glyphs are downloaded.
+    LocalGlyphRasterizer(const optional<std::string>& fontFamily = {});
+    virtual ~LocalGlyphRasterizer();
+
+    // Virtual so that tests can replace the platform's fonts.
+    virtual bool canRasterizeGlyph(const FontStack&, GlyphID) const;
+    virtual Glyph rasterizeGlyph(const FontStack&, GlyphID);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace mbgl
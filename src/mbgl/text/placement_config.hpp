@@ -1,19 +1,34 @@
 #pragma once
 
+#include <mbgl/renderer/mode.hpp>
+#include <mbgl/math/wrap.hpp>
 #include <mbgl/util/constants.hpp>
 
+#include <cmath>
+
 namespace mbgl {
 
+// Builds with WITH_COLLISION_GRID use the grid collision index unless the renderer is told
+// otherwise.
+#if MBGL_USE_COLLISION_GRID
+constexpr CollisionIndexType defaultCollisionIndexType = CollisionIndexType::Grid;
+#else
+constexpr CollisionIndexType defaultCollisionIndexType = CollisionIndexType::RTree;
+#endif
+
 class PlacementConfig {
 public:
-    PlacementConfig(float angle_ = 0, float pitch_ = 0, float cameraToCenterDistance_ = 0, float cameraToTileDistance_ = 0, bool debug_ = false)
-        : angle(angle_), pitch(pitch_), cameraToCenterDistance(cameraToCenterDistance_), cameraToTileDistance(cameraToTileDistance_), debug(debug_) {
+    PlacementConfig(float angle_ = 0, float pitch_ = 0, float cameraToCenterDistance_ = 0, float cameraToTileDistance_ = 0, bool debug_ = false,
+                    CollisionIndexType collisionIndex_ = defaultCollisionIndexType)
+        : angle(angle_), pitch(pitch_), cameraToCenterDistance(cameraToCenterDistance_), cameraToTileDistance(cameraToTileDistance_), debug(debug_),
+          collisionIndex(collisionIndex_) {
     }
 
     bool operator==(const PlacementConfig& rhs) const {
         return angle == rhs.angle &&
             pitch == rhs.pitch &&
             debug == rhs.debug &&
+            collisionIndex == rhs.collisionIndex &&
             ((pitch * util::RAD2DEG < 25) ||
              (cameraToCenterDistance == rhs.cameraToCenterDistance && cameraToTileDistance == rhs.cameraToTileDistance));
     }
@@ -22,12 +37,28 @@ public:
         return !operator==(rhs);
     }
 
+    // Whether a placement made for this config is still a good approximation for the other
+    // config: the map was rotated or tilted by less than a degree, and the tile's distance to the
+    // camera changed by less than five percent.
+    bool isCloseTo(const PlacementConfig& rhs) const {
+        const float maxAngleDelta = util::DEG2RAD;
+        const float maxDistanceRatio = 0.05f;
+        const float angleDelta = util::wrap<float>(angle - rhs.angle, -M_PI, M_PI);
+        return std::abs(angleDelta) < maxAngleDelta &&
+            std::abs(pitch - rhs.pitch) < maxAngleDelta &&
+            std::abs(cameraToTileDistance - rhs.cameraToTileDistance) <= maxDistanceRatio * cameraToTileDistance &&
+            std::abs(cameraToCenterDistance - rhs.cameraToCenterDistance) <= maxDistanceRatio * cameraToCenterDistance &&
+            debug == rhs.debug &&
+            collisionIndex == rhs.collisionIndex;
+    }
+
 public:
     float angle;
     float pitch;
     float cameraToCenterDistance;
     float cameraToTileDistance;
     bool debug;
+    CollisionIndexType collisionIndex;
 };
 
 } // namespace mbgl
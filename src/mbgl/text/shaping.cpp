@@ -3,6 +3,7 @@
 #include <mbgl/layout/symbol_feature.hpp>
 #include <mbgl/math/minmax.hpp>
 #include <mbgl/text/bidi.hpp>
+#include <mbgl/text/bidi_cache.hpp>
 
 #include <boost/algorithm/string.hpp>
 
@@ -332,12 +333,14 @@ const Shaping getShaping(const std::u16string& logicalInput,
                          const float verticalHeight,
                          const WritingModeType writingMode,
                          BiDi& bidi,
-                         const Glyphs& glyphs) {
+                         const Glyphs& glyphs,
+                         BiDiCache* bidiCache) {
     Shaping shaping(translate.x, translate.y, writingMode);
     
-    std::vector<std::u16string> reorderedLines =
-    bidi.processText(logicalInput,
-                     determineLineBreaks(logicalInput, spacing, maxWidth, writingMode, glyphs));
+    std::set<std::size_t> lineBreaks = determineLineBreaks(logicalInput, spacing, maxWidth, writingMode, glyphs);
+    std::vector<std::u16string> reorderedLines = bidiCache
+        ? bidiCache->processText(bidi, logicalInput, std::move(lineBreaks))
+        : bidi.processText(logicalInput, std::move(lineBreaks));
     
     shapeLines(shaping, reorderedLines, spacing, lineHeight, textAnchor,
                textJustify, verticalHeight, writingMode, glyphs);
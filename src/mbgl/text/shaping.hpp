@@ -8,6 +8,7 @@ namespace mbgl {
 
 class SymbolFeature;
 class BiDi;
+class BiDiCache;
 
 class PositionedIcon {
 private:
@@ -55,6 +56,7 @@ const Shaping getShaping(const std::u16string& string,
                          float verticalHeight,
                          const WritingModeType,
                          BiDi& bidi,
-                         const Glyphs& glyphs);
+                         const Glyphs& glyphs,
+                         BiDiCache* bidiCache = nullptr);
 
 } // namespace mbgl
@@ -0,0 +1,68 @@
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/text/shaping.hpp>
+#include <mbgl/util/font_stack.hpp>
+
+#include <boost/functional/hash.hpp>
+
+namespace mbgl {
+
+ShapingCache::ShapingCache(std::size_t capacity)
+    : cache(capacity) {
+}
+
+std::size_t ShapingCache::KeyHash::operator()(const Key& key) const {
+    std::size_t seed = 0;
+    boost::hash_combine(seed, std::hash<std::u16string>{}(key.text));
+    boost::hash_combine(seed, FontStackHash{}(key.fontStack));
+    boost::hash_combine(seed, key.maxWidth);
+    boost::hash_combine(seed, key.lineHeight);
+    boost::hash_combine(seed, underlying_type(key.textAnchor));
+    boost::hash_combine(seed, underlying_type(key.textJustify));
+    boost::hash_combine(seed, key.spacing);
+    boost::hash_combine(seed, key.translate.x);
+    boost::hash_combine(seed, key.translate.y);
+    boost::hash_combine(seed, key.verticalHeight);
+    boost::hash_combine(seed, underlying_type(key.writingMode));
+    return seed;
+}
+
+bool ShapingCache::KeyEqual::operator()(const Key& lhs, const Key& rhs) const {
+    return lhs.text == rhs.text &&
+        lhs.fontStack == rhs.fontStack &&
+        lhs.maxWidth == rhs.maxWidth &&
+        lhs.lineHeight == rhs.lineHeight &&
+        lhs.textAnchor == rhs.textAnchor &&
+        lhs.textJustify == rhs.textJustify &&
+        lhs.spacing == rhs.spacing &&
+        lhs.translate == rhs.translate &&
+        lhs.verticalHeight == rhs.verticalHeight &&
+        lhs.writingMode == rhs.writingMode;
+}
+
+Shaping ShapingCache::getShaping(const Key& key, BiDi& bidi, const Glyphs& glyphs, BiDiCache* bidiCache) {
+    auto shape = [&] {
+        return mbgl::getShaping(key.text, key.maxWidth, key.lineHeight, key.textAnchor,
+                                key.textJustify, key.spacing, key.translate,
+                                key.verticalHeight, key.writingMode, bidi, glyphs, bidiCache);
+    };
+
+    // Glyphs that haven't been loaded yet are left out of the shaping, so it mustn't be reused
+    // once they are available.
+    for (char16_t chr : key.text) {
+        if (glyphs.find(chr) == glyphs.end()) {
+            return shape();
+        }
+    }
+
+    return cache.get(key, shape);
+}
+
+void ShapingCache::clear() {
+    cache.clear();
+}
+
+ShapingCache::Stats ShapingCache::getStats() const {
+    return cache.getStats();
+}
+
+} // namespace mbgl
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/style/types.hpp>
+#include <mbgl/util/geometry.hpp>
+#include <mbgl/util/lru_cache.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <string>
+
+namespace mbgl {
+
+class BiDi;
+class BiDiCache;
+
+/*
+    ShapingCache holds the results of `getShaping` for recently shaped labels. Street names and
+    place labels repeat across neighboring tiles and the overzoomed children of a tile, so workers
+    that lay out those tiles share the cache and shape each distinct label only once.
+
+    Glyph metrics of a font stack don't change once loaded, so the font stack stands in for the
+    glyphs in the key. Labels that are shaped before all of their glyphs are loaded aren't cached.
+    The cache holds at most `capacity` shapings and drops the least recently
+    used ones first. All methods may be called from any thread.
+*/
+class ShapingCache : private util::noncopyable {
+public:
+    struct Key {
+        std::u16string text;
+        FontStack fontStack;
+        float maxWidth;
+        float lineHeight;
+        style::SymbolAnchorType textAnchor;
+        style::TextJustifyType textJustify;
+        float spacing;
+        Point<float> translate;
+        float verticalHeight;
+        WritingModeType writingMode;
+    };
+
+private:
+    struct KeyHash {
+        std::size_t operator()(const Key&) const;
+    };
+
+    struct KeyEqual {
+        bool operator()(const Key&, const Key&) const;
+    };
+
+    using Cache = LRUCache<Key, Shaping, KeyHash, KeyEqual>;
+
+public:
+    ShapingCache(std::size_t capacity = 4096);
+
+    // Returns the cached shaping for the key, or shapes the text with the given glyphs and adds
+    // the result to the cache if none of the glyphs are missing.
+    Shaping getShaping(const Key&, BiDi&, const Glyphs&, BiDiCache* = nullptr);
+
+    // Drops all cached shapings, e.g. when the glyphs of the font stacks change.
+    void clear();
+
+    using Stats = Cache::Stats;
+
+    Stats getStats() const;
+
+private:
+    Cache cache;
+};
+
+} // namespace mbgl
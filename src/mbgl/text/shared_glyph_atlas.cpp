@@ -0,0 +1,144 @@
+#include <mbgl/text/shared_glyph_atlas.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+static constexpr uint16_t padding = 1;
+
+SharedGlyphAtlas::SharedGlyphAtlas(Size initialSize, Size maximumSize)
+    : atlas(initialSize, maximumSize, [this] (ShelfAtlas<AlphaImage>::Entry& entry) {
+          evicted(static_cast<Entry&>(entry));
+      }) {
+}
+
+SharedGlyphAtlas::~SharedGlyphAtlas() = default;
+
+SharedGlyphAtlas::Reference::Reference(std::shared_ptr<SharedGlyphAtlas> atlas_)
+    : atlas(std::move(atlas_)) {
+}
+
+SharedGlyphAtlas::Reference::~Reference() {
+    atlas->release(entries);
+}
+
+std::unique_ptr<SharedGlyphAtlas::Reference> SharedGlyphAtlas::addGlyphs(const GlyphMap& glyphs, GlyphPositions& positions) {
+    std::unique_ptr<Reference> reference(new Reference(shared_from_this()));
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const auto& glyphMapEntry : glyphs) {
+        const FontStack& fontStack = glyphMapEntry.first;
+        GlyphPositionMap& fontStackPositions = positions[fontStack];
+
+        for (const auto& glyphEntry : glyphMapEntry.second) {
+            if (!glyphEntry.second || !(*glyphEntry.second)->bitmap.valid()) {
+                continue;
+            }
+
+            Entry* entry = addGlyph(fontStack, **glyphEntry.second);
+            if (!entry) {
+                continue;
+            }
+
+            if (entry->references++ == 0) {
+                atlas.reference(*entry);
+                referencedGlyphs++;
+            }
+
+            reference->entries.push_back(entry);
+            fontStackPositions.emplace(entry->id, entry->position);
+        }
+    }
+
+    return reference;
+}
+
+SharedGlyphAtlas::Entry* SharedGlyphAtlas::addGlyph(const FontStack& fontStack, const Glyph& glyph) {
+    auto& fontStackEntries = entries[fontStack];
+
+    auto it = fontStackEntries.find(glyph.id);
+    if (it != fontStackEntries.end()) {
+        return &it->second;
+    }
+
+    const uint16_t width = glyph.bitmap.size.width + 2 * padding;
+    const uint16_t height = glyph.bitmap.size.height + 2 * padding;
+
+    mapbox::Bin* bin = atlas.allocate(width, height);
+    if (!bin) {
+        Log::Warning(Event::OpenGL, "Glyph %u doesn't fit in the shared glyph atlas", uint32_t(glyph.id));
+        return nullptr;
+    }
+
+    atlas.copy(glyph.bitmap, *bin, padding);
+
+    Entry& entry = fontStackEntries[glyph.id];
+    entry.fontStack = fontStack;
+    entry.id = glyph.id;
+    entry.bin = bin;
+    entry.position = GlyphPosition {
+        Rect<uint16_t> {
+            static_cast<uint16_t>(bin->x),
+            static_cast<uint16_t>(bin->y),
+            static_cast<uint16_t>(bin->w),
+            static_cast<uint16_t>(bin->h)
+        },
+        glyph.metrics
+    };
+    return &entry;
+}
+
+void SharedGlyphAtlas::evicted(Entry& entry) {
+    // Empty font stack maps are kept, since `addGlyph` may be adding to the same one.
+    const GlyphID id = entry.id;
+    entries.at(entry.fontStack).erase(id);
+
+    evictedGlyphs++;
+}
+
+void SharedGlyphAtlas::release(const std::vector<Entry*>& released) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (Entry* entry : released) {
+        assert(entry->references > 0);
+        if (--entry->references == 0) {
+            atlas.release(*entry);
+            referencedGlyphs--;
+        }
+    }
+}
+
+void SharedGlyphAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
+    std::lock_guard<std::mutex> lock(mutex);
+    uploadedBytes += atlas.upload(context, texture, unit);
+}
+
+Size SharedGlyphAtlas::bind(gl::Context& context, gl::TextureUnit unit) {
+    assert(texture);
+    context.bindTexture(*texture, unit, gl::TextureFilter::Linear);
+    return texture->size;
+}
+
+SharedGlyphAtlas::Stats SharedGlyphAtlas::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Stats stats;
+    for (const auto& fontStackEntries : entries) {
+        stats.glyphs += fontStackEntries.second.size();
+    }
+    stats.referencedGlyphs = referencedGlyphs;
+    stats.evictedGlyphs = evictedGlyphs;
+    stats.memoryBytes = atlas.getImage().bytes();
+    stats.uploadedBytes = uploadedBytes;
+    return stats;
+}
+
+AlphaImage SharedGlyphAtlas::getAtlasImage() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return atlas.getImage().clone();
+}
+
+} // namespace mbgl
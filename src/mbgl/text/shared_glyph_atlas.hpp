@@ -0,0 +1,107 @@
+#pragma once
+
+#include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/renderer/shelf_atlas.hpp>
+#include <mbgl/gl/texture.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mbgl {
+
+namespace gl {
+class Context;
+} // namespace gl
+
+/*
+    SharedGlyphAtlas is a renderer-wide alternative to the per-tile atlases built by
+    `makeGlyphAtlas`. Every (font stack, glyph) pair is packed into a single texture at most once,
+    and tiles hold a `Reference` to the glyphs they use for as long as their buckets refer to the
+    atlas positions.
+
+    When a glyph is no longer referenced by any tile, its region stays in the atlas so that tiles
+    loaded later can reuse it. Once the atlas has grown to its maximum size and a new glyph doesn't
+    fit, the least recently released regions are evicted to make room.
+
+    Only the area that changed since the previous upload is sent to the GPU; the whole texture is
+    uploaded only after the atlas grew.
+
+    `addGlyphs` may be called from worker threads; `upload` and `bind` must be called on the
+    render thread.
+*/
+class SharedGlyphAtlas : public std::enable_shared_from_this<SharedGlyphAtlas>,
+                         private util::noncopyable {
+private:
+    struct Entry;
+
+public:
+    SharedGlyphAtlas(Size initialSize = { 256, 256 }, Size maximumSize = { 2048, 2048 });
+    ~SharedGlyphAtlas();
+
+    // Keeps the atlas regions of a set of glyphs alive. Released when destroyed.
+    class Reference : private util::noncopyable {
+    public:
+        ~Reference();
+
+    private:
+        friend class SharedGlyphAtlas;
+        Reference(std::shared_ptr<SharedGlyphAtlas>);
+
+        std::shared_ptr<SharedGlyphAtlas> atlas;
+        std::vector<Entry*> entries;
+    };
+
+    // Packs all glyphs with a bitmap that aren't in the atlas yet and returns a reference to the
+    // regions of all of them. The positions of the glyphs are added to `positions`; glyphs that
+    // don't fit in the atlas are omitted.
+    std::unique_ptr<Reference> addGlyphs(const GlyphMap&, GlyphPositions& positions);
+
+    void upload(gl::Context&, gl::TextureUnit);
+
+    // Binds the atlas texture and returns its size, which is the size that glyph positions of
+    // uploaded glyphs are relative to.
+    Size bind(gl::Context&, gl::TextureUnit);
+
+    struct Stats {
+        // Number of glyphs in the atlas, including unreferenced ones that weren't evicted yet.
+        std::size_t glyphs = 0;
+        std::size_t referencedGlyphs = 0;
+        std::size_t evictedGlyphs = 0;
+        // Size of the CPU-side atlas image, which equals the size of the texture.
+        std::size_t memoryBytes = 0;
+        // Total number of bytes sent to the GPU.
+        uint64_t uploadedBytes = 0;
+    };
+
+    Stats getStats() const;
+
+    // Only for use in tests.
+    AlphaImage getAtlasImage() const;
+
+private:
+    struct Entry : ShelfAtlas<AlphaImage>::Entry {
+        FontStack fontStack;
+        GlyphID id;
+        GlyphPosition position;
+        uint32_t references = 0;
+    };
+
+    Entry* addGlyph(const FontStack&, const Glyph&);
+    void evicted(Entry&);
+    void release(const std::vector<Entry*>&);
+
+    mutable std::mutex mutex;
+    ShelfAtlas<AlphaImage> atlas;
+    std::map<FontStack, std::map<GlyphID, Entry>> entries;
+
+    optional<gl::Texture> texture;
+
+    std::size_t referencedGlyphs = 0;
+    std::size_t evictedGlyphs = 0;
+    uint64_t uploadedBytes = 0;
+};
+
+} // namespace mbgl
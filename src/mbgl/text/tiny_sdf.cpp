@@ -0,0 +1,106 @@
+#include <mbgl/text/tiny_sdf.hpp>
+#include <mbgl/math/clamp.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+constexpr double INF = 1e20;
+
+// Squared distance transform of `length` samples of `grid`, starting at `offset` and `stride`
+// elements apart. `f`, `d`, `v` and `z` are scratch space with room for at least `length` + 1
+// elements.
+void edt1d(std::vector<double>& grid, std::size_t offset, std::size_t stride, std::size_t length,
+           std::vector<double>& f, std::vector<double>& d, std::vector<std::size_t>& v, std::vector<double>& z) {
+    for (std::size_t q = 0; q < length; q++) {
+        f[q] = grid[offset + q * stride];
+    }
+
+    auto intersection = [&] (std::size_t q, std::size_t r) {
+        return ((f[q] + q * q) - (f[r] + r * r)) / (2.0 * q - 2.0 * r);
+    };
+
+    v[0] = 0;
+    z[0] = -INF;
+    z[1] = INF;
+
+    for (std::size_t q = 1, k = 0; q < length; q++) {
+        double s = intersection(q, v[k]);
+        // z[0] is -INF, so k never drops below zero.
+        while (s <= z[k]) {
+            k--;
+            s = intersection(q, v[k]);
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = INF;
+    }
+
+    for (std::size_t q = 0, k = 0; q < length; q++) {
+        while (z[k + 1] < q) {
+            k++;
+        }
+        const double distance = double(q) - double(v[k]);
+        d[q] = distance * distance + f[v[k]];
+    }
+
+    for (std::size_t q = 0; q < length; q++) {
+        grid[offset + q * stride] = d[q];
+    }
+}
+
+// Two-dimensional squared Euclidean distance transform, computed in place.
+void edt(std::vector<double>& grid, std::size_t width, std::size_t height) {
+    const std::size_t length = std::max(width, height);
+    std::vector<double> f(length);
+    std::vector<double> d(length);
+    std::vector<std::size_t> v(length);
+    std::vector<double> z(length + 1);
+
+    for (std::size_t x = 0; x < width; x++) {
+        edt1d(grid, x, width, height, f, d, v, z);
+    }
+    for (std::size_t y = 0; y < height; y++) {
+        edt1d(grid, y * width, 1, width, f, d, v, z);
+    }
+}
+
+} // namespace
+
+AlphaImage transformRasterToSDF(const AlphaImage& raster, double radius, double cutoff) {
+    const std::size_t width = raster.size.width;
+    const std::size_t height = raster.size.height;
+    const std::size_t count = width * height;
+    if (count == 0) {
+        return AlphaImage(raster.size);
+    }
+
+    std::vector<double> gridOuter(count);
+    std::vector<double> gridInner(count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        const double a = raster.data[i] / 255.0;
+        gridOuter[i] = a == 1 ? 0 : a == 0 ? INF : std::pow(std::max(0.0, 0.5 - a), 2);
+        gridInner[i] = a == 1 ? INF : a == 0 ? 0 : std::pow(std::max(0.0, a - 0.5), 2);
+    }
+
+    edt(gridOuter, width, height);
+    edt(gridInner, width, height);
+
+    AlphaImage sdf(raster.size);
+    for (std::size_t i = 0; i < count; i++) {
+        const double distance = std::sqrt(gridOuter[i]) - std::sqrt(gridInner[i]);
+        sdf.data[i] = util::clamp(std::round(255 - 255 * (distance / radius + cutoff)), 0.0, 255.0);
+    }
+
+    return sdf;
+}
+
+} // namespace util
+} // namespace mbgl
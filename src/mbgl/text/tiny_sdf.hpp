@@ -0,0 +1,20 @@
+#pragma once
+
+#include <mbgl/util/image.hpp>
+
+namespace mbgl {
+namespace util {
+
+/*
+    Turns a greyscale rasterization of a glyph into a signed distance field, the way TinySDF
+    (https://github.com/mapbox/tiny-sdf) does in the browser: the Felzenszwalb/Huttenlocher
+    Euclidean distance transform runs once over the outside and once over the inside of the
+    shape, and the difference between both distances is stored as one byte per pixel.
+
+    `radius` is the distance in pixels at which the field saturates; `cutoff` is the fraction of
+    the byte range that encodes distances inside the shape.
+*/
+AlphaImage transformRasterToSDF(const AlphaImage& raster, double radius, double cutoff);
+
+} // namespace util
+} // namespace mbgl
@@ -1,8 +1,7 @@
 #include <mbgl/tile/geojson_tile.hpp>
 #include <mbgl/tile/geojson_tile_data.hpp>
-#include <mbgl/renderer/query.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
-#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/renderer/sources/geojson_source_worker.hpp>
 
 namespace mbgl {
 
@@ -14,30 +13,28 @@ GeoJSONTile::GeoJSONTile(const OverscaledTileID& overscaledTileID,
     updateData(std::move(features));
 }
 
+GeoJSONTile::GeoJSONTile(const OverscaledTileID& overscaledTileID,
+                         std::string sourceID_,
+                         const TileParameters& parameters)
+    : GeometryTile(overscaledTileID, sourceID_, parameters) {
+}
+
 void GeoJSONTile::updateData(mapbox::geometry::feature_collection<int16_t> features) {
     setData(std::make_unique<GeoJSONTileData>(std::move(features)));
 }
+
+void GeoJSONTile::requestData(ActorRef<GeoJSONSourceWorker> worker) {
+    awaitData();
+    worker.invoke(&GeoJSONSourceWorker::getTile, id.canonical, ActorRef<GeoJSONTile>(*this, getMailbox()));
+}
     
 void GeoJSONTile::querySourceFeatures(
     std::vector<Feature>& result,
-    const SourceQueryOptions& options) {
-    
-    // Ignore the sourceLayer, there is only one
-    if (auto tileData = getData()) {
-        if (auto layer = tileData->getLayer({})) {
-            auto featureCount = layer->featureCount();
-            for (std::size_t i = 0; i < featureCount; i++) {
-                auto feature = layer->getFeature(i);
+    const SourceQueryOptions& options,
+    SourceFeatureIDs& returned) {
 
-                // Apply filter, if any
-                if (options.filter && !(*options.filter)(*feature)) {
-                    continue;
-                }
-
-                result.push_back(convertFeature(*feature, id.canonical));
-            }
-        }
-    }
+    // Ignore the sourceLayer, there is only one
+    querySourceLayer(result, {}, options, returned);
 }
 
 } // namespace mbgl
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/actor/actor_ref.hpp>
 #include <mbgl/util/feature.hpp>
 
 namespace mbgl {
 
 class TileParameters;
+class GeoJSONSourceWorker;
 
 class GeoJSONTile : public GeometryTile {
 public:
@@ -14,11 +16,21 @@ public:
                 const TileParameters&,
                 mapbox::geometry::feature_collection<int16_t>);
 
+    // Creates a tile without features; it isn't loaded until they arrive through `updateData`.
+    GeoJSONTile(const OverscaledTileID&,
+                std::string sourceID,
+                const TileParameters&);
+
     void updateData(mapbox::geometry::feature_collection<int16_t>);
+
+    // Asks the worker that indexes the source data for the features of this tile. Until they
+    // arrive, the tile keeps its current features, but is pending.
+    void requestData(ActorRef<GeoJSONSourceWorker>);
     
     void querySourceFeatures(
         std::vector<Feature>& result,
-        const SourceQueryOptions&) override;
+        const SourceQueryOptions&,
+        SourceFeatureIDs& returned) override;
 };
 
 } // namespace mbgl
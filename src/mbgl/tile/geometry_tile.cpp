@@ -19,9 +19,11 @@
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
 #include <mbgl/actor/scheduler.hpp>
 
 #include <iostream>
+#include <map>
 
 namespace mbgl {
 
@@ -54,9 +56,15 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_,
              id_,
              obsolete,
              parameters.mode,
-             parameters.pixelRatio),
+             parameters.pixelRatio,
+             parameters.glyphManager.getSharedAtlas(),
+             parameters.imageManager.getSharedAtlas(),
+             parameters.glyphManager.getShapingCache(),
+             parameters.glyphManager.getBiDiCache()),
       glyphManager(parameters.glyphManager),
       imageManager(parameters.imageManager),
+      sharedGlyphAtlas(parameters.glyphManager.getSharedAtlas()),
+      sharedImageAtlas(parameters.imageManager.getSharedAtlas()),
       lastYStretch(1.0f),
       mode(parameters.mode) {
 }
@@ -89,11 +97,25 @@ void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
     worker.invoke(&GeometryTileWorker::setData, std::move(data_), correlationID);
 }
 
-void GeometryTile::setPlacementConfig(const PlacementConfig& desiredConfig) {
+void GeometryTile::awaitData() {
+    pending = true;
+    ++correlationID;
+}
+
+void GeometryTile::setPlacementConfig(const PlacementConfig& desiredConfig, bool cameraIsChanging) {
     if (requestedConfig == desiredConfig) {
         return;
     }
 
+    // During camera animations and gestures, this is called for every frame. Placing all symbols
+    // again for every frame would flood the worker pool, so keep using the current placement
+    // while it's still close enough, and have at most one placement in flight. Once the camera
+    // stops, symbols are placed for the exact config.
+    if (cameraIsChanging && mode == MapMode::Continuous && requestedConfig &&
+        (placementInFlight || requestedConfig->isCloseTo(desiredConfig))) {
+        return;
+    }
+
     // Mark the tile as pending again if it was complete before to prevent signaling a complete
     // state despite pending parse operations.
     pending = true;
@@ -105,6 +127,7 @@ void GeometryTile::setPlacementConfig(const PlacementConfig& desiredConfig) {
 
 void GeometryTile::invokePlacement() {
     if (requestedConfig) {
+        placementInFlight = true;
         worker.invoke(&GeometryTileWorker::setPlacementConfig, *requestedConfig, correlationID);
     }
 }
@@ -151,14 +174,22 @@ void GeometryTile::onPlacement(PlacementResult result, const uint64_t resultCorr
     if (resultCorrelationID == correlationID) {
         pending = false;
     }
+    placementInFlight = false;
     symbolBuckets = std::move(result.symbolBuckets);
     collisionTile = std::move(result.collisionTile);
     if (result.glyphAtlasImage) {
         glyphAtlasImage = std::move(*result.glyphAtlasImage);
     }
+    if (result.glyphAtlasReference) {
+        glyphAtlasReference = std::move(result.glyphAtlasReference);
+    }
     if (result.iconAtlasImage) {
         iconAtlasImage = std::move(*result.iconAtlasImage);
     }
+    if (result.iconAtlasReference) {
+        iconAtlasReference = std::move(result.iconAtlasReference);
+        iconAtlasRelayoutRequested = false;
+    }
     if (collisionTile.get()) {
         lastYStretch = collisionTile->yStretch;
     }
@@ -170,6 +201,7 @@ void GeometryTile::onError(std::exception_ptr err, const uint64_t resultCorrelat
     if (resultCorrelationID == correlationID) {
         pending = false;
     }
+    placementInFlight = false;
     observer->onTileError(*this, err);
 }
     
@@ -209,12 +241,60 @@ void GeometryTile::upload(gl::Context& context) {
         glyphAtlasImage = {};
     }
 
+    if (sharedGlyphAtlas) {
+        // Uploads the changes made by all tiles since the last upload; a no-op for all but the
+        // first tile in a frame.
+        sharedGlyphAtlas->upload(context, 0);
+    }
+
+    if (sharedImageAtlas) {
+        sharedImageAtlas->upload(context, 0);
+
+        if (iconAtlasReference && !iconAtlasRelayoutRequested &&
+            iconAtlasReference->getGeneration() != sharedImageAtlas->getGeneration() &&
+            iconAtlasReference->isAffectedByRepack()) {
+            // The atlas was repacked since our symbols were laid out.
+            iconAtlasRelayoutRequested = true;
+            pending = true;
+            ++correlationID;
+            worker.invoke(&GeometryTileWorker::onImageAtlasRepacked, correlationID);
+        }
+    }
+
     if (iconAtlasImage) {
         iconAtlasTexture = context.createTexture(*iconAtlasImage, 0);
         iconAtlasImage = {};
     }
 }
 
+Size GeometryTile::bindGlyphAtlas(gl::Context& context) {
+    if (sharedGlyphAtlas) {
+        return sharedGlyphAtlas->bind(context, 0);
+    }
+
+    assert(glyphAtlasTexture);
+    context.bindTexture(*glyphAtlasTexture, 0, gl::TextureFilter::Linear);
+    return glyphAtlasTexture->size;
+}
+
+bool GeometryTile::hasIconAtlas() const {
+    if (sharedImageAtlas) {
+        return iconAtlasReference && sharedImageAtlas->hasTexture(iconAtlasReference->getGeneration());
+    }
+    return bool(iconAtlasTexture);
+}
+
+Size GeometryTile::bindIconAtlas(gl::Context& context, gl::TextureFilter filter) {
+    if (sharedImageAtlas) {
+        assert(iconAtlasReference);
+        return sharedImageAtlas->bind(context, 0, filter, iconAtlasReference->getGeneration());
+    }
+
+    assert(iconAtlasTexture);
+    context.bindTexture(*iconAtlasTexture, 0, filter);
+    return iconAtlasTexture->size;
+}
+
 Bucket* GeometryTile::getBucket(const Layer::Impl& layer) const {
     const auto& buckets = layer.type == LayerType::Symbol ? symbolBuckets : nonSymbolBuckets;
     const auto it = buckets.find(layer.id);
@@ -226,15 +306,7 @@ Bucket* GeometryTile::getBucket(const Layer::Impl& layer) const {
     return it->second.get();
 }
 
-void GeometryTile::queryRenderedFeatures(
-    std::unordered_map<std::string, std::vector<Feature>>& result,
-    const GeometryCoordinates& queryGeometry,
-    const TransformState& transformState,
-    const std::vector<const RenderLayer*>& layers,
-    const RenderedQueryOptions& options) {
-
-    if (!featureIndex || !data) return;
-
+float GeometryTile::getQueryRadius(const std::vector<const RenderLayer*>& layers) const {
     // Determine the additional radius needed factoring in property functions
     float additionalRadius = 0;
     for (const RenderLayer* layer : layers) {
@@ -243,6 +315,17 @@ void GeometryTile::queryRenderedFeatures(
             additionalRadius = std::max(additionalRadius, bucket->getQueryRadius(*layer));
         }
     }
+    return additionalRadius;
+}
+
+void GeometryTile::queryRenderedFeatures(
+    std::unordered_map<std::string, std::vector<Feature>>& result,
+    const GeometryCoordinates& queryGeometry,
+    const TransformState& transformState,
+    const std::vector<const RenderLayer*>& layers,
+    const RenderedQueryOptions& options) {
+
+    if (!featureIndex || !data) return;
 
     featureIndex->query(result,
                         queryGeometry,
@@ -254,42 +337,135 @@ void GeometryTile::queryRenderedFeatures(
                         id.canonical,
                         layers,
                         collisionTile.get(),
+                        getQueryRadius(layers));
+}
+
+void GeometryTile::queryRenderedFeatureBatch(
+    QueryBatch& batch,
+    const TileQueryGeometries& queryGeometries,
+    const TransformState& transformState,
+    const std::vector<const RenderLayer*>& layers,
+    const RenderedQueryOptions& options) {
+
+    if (!featureIndex || !data) return;
+
+    const float additionalRadius = getQueryRadius(layers);
+
+    // Position of each feature in the batch, by source layer and feature index. The features
+    // are added without decoding them; they share the source layers they were found in.
+    std::map<std::pair<std::string, std::size_t>, std::size_t> added;
+    std::unordered_map<std::string, std::shared_ptr<const GeometryTileLayer>> sourceLayers;
+
+    std::vector<GeometryCoordinates> geometries;
+    geometries.reserve(queryGeometries.size());
+    for (const auto& queryGeometry : queryGeometries) {
+        geometries.push_back(queryGeometry.second);
+    }
+
+    auto hit = [&] (std::size_t query, const std::string& layerID, const IndexedSubfeature& indexedFeature, const GeometryTileFeature&) {
+        auto it = added.emplace(std::make_pair(indexedFeature.sourceLayerName, indexedFeature.index),
+                                batch.features.size());
+        if (it.second) {
+            std::shared_ptr<const GeometryTileLayer>& sourceLayer = sourceLayers[indexedFeature.sourceLayerName];
+            if (!sourceLayer) {
+                sourceLayer = data->getLayer(indexedFeature.sourceLayerName);
+            }
+            batch.features.emplace_back(sourceLayer, indexedFeature.index, id.canonical);
+        }
+        batch.hits.push_back({ queryGeometries[query].first, it.first->second, &layerID });
+    };
+
+    featureIndex->query(hit,
+                        geometries,
+                        transformState.getAngle(),
+                        util::tileSize * id.overscaleFactor(),
+                        std::pow(2, transformState.getZoom() - id.overscaledZ),
+                        options,
+                        *data,
+                        id.canonical,
+                        layers,
+                        collisionTile.get(),
                         additionalRadius);
 }
 
 void GeometryTile::querySourceFeatures(
     std::vector<Feature>& result,
-    const SourceQueryOptions& options) {
+    const SourceQueryOptions& options,
+    SourceFeatureIDs& returned) {
 
-    // Data not yet available
-    if (!data) {
-        return;
-    }
-    
     // No source layers, specified, nothing to do
     if (!options.sourceLayers) {
         Log::Warning(Event::General, "At least one sourceLayer required");
         return;
     }
 
-    for (auto sourceLayer : *options.sourceLayers) {
+    for (const auto& sourceLayer : *options.sourceLayers) {
         // Go throught all sourceLayers, if any
         // to gather all the features
-        auto layer = data->getLayer(sourceLayer);
-        
-        if (layer) {
-            auto featureCount = layer->featureCount();
-            for (std::size_t i = 0; i < featureCount; i++) {
-                auto feature = layer->getFeature(i);
-
-                // Apply filter, if any
-                if (options.filter && !(*options.filter)(*feature)) {
-                    continue;
-                }
-
-                result.push_back(convertFeature(*feature, id.canonical));
+        querySourceLayer(result, sourceLayer, options, returned);
+    }
+}
+
+void GeometryTile::querySourceLayer(
+    std::vector<Feature>& result,
+    const std::string& sourceLayerName,
+    const SourceQueryOptions& options,
+    SourceFeatureIDs& returned) {
+
+    // Data not yet available
+    if (!data) {
+        return;
+    }
+
+    auto layer = data->getLayer(sourceLayerName);
+    if (!layer) {
+        return;
+    }
+
+    std::set<FeatureIdentifier>& returnedIDs = returned[sourceLayerName];
+
+    auto addFeature = [&] (std::size_t i) {
+        auto feature = layer->getFeature(i);
+
+        // Apply filter, if any
+        if (options.filter && !(*options.filter)(*feature)) {
+            return;
+        }
+
+        // Skip features that another tile has returned already
+        if (auto featureID = feature->getID()) {
+            if (!returnedIDs.insert(*featureID).second) {
+                return;
             }
         }
+
+        result.push_back(convertFeature(*feature, id.canonical));
+    };
+
+    if (options.bounds) {
+        // Only look at the features that the index finds in the bounds, once layout has built it.
+        if (!featureIndex) {
+            return;
+        }
+
+        const UnwrappedTileID tileID { 0, id.canonical };
+        const GeometryCoordinate min = TileCoordinate::toGeometryCoordinate(
+            tileID, TileCoordinate::fromLatLng(0, options.bounds->northwest()).p);
+        const GeometryCoordinate max = TileCoordinate::toGeometryCoordinate(
+            tileID, TileCoordinate::fromLatLng(0, options.bounds->southeast()).p);
+
+        if (min.x > util::EXTENT || min.y > util::EXTENT || max.x < 0 || max.y < 0) {
+            return;
+        }
+
+        for (const std::size_t i : featureIndex->querySourceLayer(sourceLayerName, *layer, { min, max })) {
+            addFeature(i);
+        }
+    } else {
+        const std::size_t featureCount = layer->featureCount();
+        for (std::size_t i = 0; i < featureCount; i++) {
+            addFeature(i);
+        }
     }
 }
 
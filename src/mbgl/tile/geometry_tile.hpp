@@ -4,6 +4,8 @@
 #include <mbgl/tile/geometry_tile_worker.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/text/shared_glyph_atlas.hpp>
+#include <mbgl/renderer/shared_image_atlas.hpp>
 #include <mbgl/text/placement_config.hpp>
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/util/feature.hpp>
@@ -36,7 +38,7 @@ public:
     void setError(std::exception_ptr);
     void setData(std::unique_ptr<const GeometryTileData>);
 
-    void setPlacementConfig(const PlacementConfig&) override;
+    void setPlacementConfig(const PlacementConfig&, bool cameraIsChanging = false) override;
     void setLayers(const std::vector<Immutable<style::Layer::Impl>>&) override;
     
     void onGlyphsAvailable(GlyphMap) override;
@@ -49,7 +51,8 @@ public:
     Bucket* getBucket(const style::Layer::Impl&) const override;
 
     Size bindGlyphAtlas(gl::Context&);
-    Size bindIconAtlas(gl::Context&);
+    bool hasIconAtlas() const;
+    Size bindIconAtlas(gl::Context&, gl::TextureFilter);
 
     void queryRenderedFeatures(
             std::unordered_map<std::string, std::vector<Feature>>& result,
@@ -58,9 +61,17 @@ public:
             const std::vector<const RenderLayer*>& layers,
             const RenderedQueryOptions& options) override;
 
+    void queryRenderedFeatureBatch(
+            QueryBatch&,
+            const TileQueryGeometries&,
+            const TransformState&,
+            const std::vector<const RenderLayer*>& layers,
+            const RenderedQueryOptions& options) override;
+
     void querySourceFeatures(
         std::vector<Feature>& result,
-        const SourceQueryOptions&) override;
+        const SourceQueryOptions&,
+        SourceFeatureIDs& returned) override;
 
     void cancel() override;
 
@@ -84,16 +95,22 @@ public:
         std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
         std::unique_ptr<CollisionTile> collisionTile;
         optional<AlphaImage> glyphAtlasImage;
+        std::unique_ptr<SharedGlyphAtlas::Reference> glyphAtlasReference;
         optional<PremultipliedImage> iconAtlasImage;
+        std::unique_ptr<SharedImageAtlas::Reference> iconAtlasReference;
 
         PlacementResult(std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets_,
                         std::unique_ptr<CollisionTile> collisionTile_,
                         optional<AlphaImage> glyphAtlasImage_,
-                        optional<PremultipliedImage> iconAtlasImage_)
+                        std::unique_ptr<SharedGlyphAtlas::Reference> glyphAtlasReference_,
+                        optional<PremultipliedImage> iconAtlasImage_,
+                        std::unique_ptr<SharedImageAtlas::Reference> iconAtlasReference_)
             : symbolBuckets(std::move(symbolBuckets_)),
               collisionTile(std::move(collisionTile_)),
               glyphAtlasImage(std::move(glyphAtlasImage_)),
-              iconAtlasImage(std::move(iconAtlasImage_)) {}
+              glyphAtlasReference(std::move(glyphAtlasReference_)),
+              iconAtlasImage(std::move(iconAtlasImage_)),
+              iconAtlasReference(std::move(iconAtlasReference_)) {}
     };
     void onPlacement(PlacementResult, uint64_t correlationID);
 
@@ -106,10 +123,29 @@ protected:
         return data.get();
     }
 
+    // The mailbox through which other actors send messages to this tile.
+    std::weak_ptr<Mailbox> getMailbox() const {
+        return mailbox;
+    }
+
+    // Marks the tile as pending until new data has been set and laid out. Results of layouts and
+    // placements still in flight for the previous data no longer complete the tile.
+    void awaitData();
+
+    void querySourceLayer(
+        std::vector<Feature>& result,
+        const std::string& sourceLayerName,
+        const SourceQueryOptions&,
+        SourceFeatureIDs& returned);
+
 private:
     void markObsolete();
     void invokePlacement();
 
+    // The distance around a query geometry, in pixels, within which the given layers draw
+    // features that may be hit.
+    float getQueryRadius(const std::vector<const RenderLayer*>&) const;
+
     const std::string sourceID;
 
     // Used to signal the worker that it should abandon parsing this tile as soon as possible.
@@ -120,16 +156,25 @@ private:
 
     GlyphManager& glyphManager;
     ImageManager& imageManager;
+    const std::shared_ptr<SharedGlyphAtlas> sharedGlyphAtlas;
+    const std::shared_ptr<SharedImageAtlas> sharedImageAtlas;
 
     uint64_t correlationID = 0;
     optional<PlacementConfig> requestedConfig;
+    // Whether the worker hasn't responded to the last placement request yet.
+    bool placementInFlight = false;
 
     std::unordered_map<std::string, std::shared_ptr<Bucket>> nonSymbolBuckets;
     std::unique_ptr<FeatureIndex> featureIndex;
     std::unique_ptr<const GeometryTileData> data;
 
     optional<AlphaImage> glyphAtlasImage;
+    // Keeps the regions of the shared glyph atlas that the symbol buckets refer to.
+    std::unique_ptr<SharedGlyphAtlas::Reference> glyphAtlasReference;
     optional<PremultipliedImage> iconAtlasImage;
+    // Keeps the regions of the shared icon atlas that the symbol buckets refer to.
+    std::unique_ptr<SharedImageAtlas::Reference> iconAtlasReference;
+    bool iconAtlasRelayoutRequested = false;
 
     std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
     std::unique_ptr<CollisionTile> collisionTile;
@@ -75,6 +75,9 @@ std::vector<GeometryCollection> classifyRings(const GeometryCollection&);
 // Truncate polygon to the largest `maxHoles` inner rings by area.
 void limitHoles(GeometryCollection&, uint32_t maxHoles);
 
+// convert the geometry of a GeometryTileFeature to lat/lng
+Feature::geometry_type convertGeometry(const GeometryTileFeature&, const CanonicalTileID&);
+
 // convert from GeometryTileFeature to Feature (eventually we should eliminate GeometryTileFeature)
 Feature convertFeature(const GeometryTileFeature&, const CanonicalTileID&);
 
@@ -26,13 +26,21 @@ GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        OverscaledTileID id_,
                                        const std::atomic<bool>& obsolete_,
                                        const MapMode mode_,
-                                       const float pixelRatio_)
+                                       const float pixelRatio_,
+                                       std::shared_ptr<SharedGlyphAtlas> sharedGlyphAtlas_,
+                                       std::shared_ptr<SharedImageAtlas> sharedImageAtlas_,
+                                       std::shared_ptr<ShapingCache> shapingCache_,
+                                       std::shared_ptr<BiDiCache> bidiCache_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
       id(std::move(id_)),
       obsolete(obsolete_),
       mode(mode_),
-      pixelRatio(pixelRatio_) {
+      pixelRatio(pixelRatio_),
+      sharedGlyphAtlas(std::move(sharedGlyphAtlas_)),
+      sharedImageAtlas(std::move(sharedImageAtlas_)),
+      shapingCache(std::move(shapingCache_)),
+      bidiCache(std::move(bidiCache_)) {
 }
 
 GeometryTileWorker::~GeometryTileWorker() = default;
@@ -140,6 +148,31 @@ void GeometryTileWorker::setPlacementConfig(PlacementConfig placementConfig_, ui
     }
 }
 
+// Repacking moved the icons in the shared atlas, so the symbol layouts have to be recreated with
+// the new icon positions.
+void GeometryTileWorker::onImageAtlasRepacked(uint64_t correlationID_) {
+    try {
+        correlationID = correlationID_;
+
+        switch (state) {
+        case Idle:
+            redoLayout();
+            coalesce();
+            break;
+
+        case Coalescing:
+        case NeedPlacement:
+            state = NeedLayout;
+            break;
+
+        case NeedLayout:
+            break;
+        }
+    } catch (...) {
+        parent.invoke(&GeometryTile::onError, std::current_exception(), correlationID);
+    }
+}
+
 void GeometryTileWorker::symbolDependenciesChanged() {
     try {
         switch (state) {
@@ -279,7 +312,7 @@ void GeometryTileWorker::redoLayout() {
     std::unordered_map<std::string, std::unique_ptr<SymbolLayout>> symbolLayoutMap;
     std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets;
     auto featureIndex = std::make_unique<FeatureIndex>();
-    BucketParameters parameters { id, mode, pixelRatio };
+    BucketParameters parameters { id, mode, pixelRatio, bidiCache.get() };
 
     GlyphDependencies glyphDependencies;
     ImageDependencies imageDependencies;
@@ -353,6 +386,8 @@ void GeometryTileWorker::redoLayout() {
     requestNewGlyphs(glyphDependencies);
     requestNewImages(imageDependencies);
 
+    featureIndex->finish();
+
     parent.invoke(&GeometryTile::onLayout, GeometryTile::LayoutResult {
         std::move(buckets),
         std::move(featureIndex),
@@ -377,14 +412,26 @@ void GeometryTileWorker::attemptPlacement() {
     }
     
     optional<AlphaImage> glyphAtlasImage;
+    std::unique_ptr<SharedGlyphAtlas::Reference> glyphAtlasReference;
     optional<PremultipliedImage> iconAtlasImage;
+    std::unique_ptr<SharedImageAtlas::Reference> iconAtlasReference;
 
     if (symbolLayoutsNeedPreparation) {
-        GlyphAtlas glyphAtlas = makeGlyphAtlas(glyphMap);
-        ImageAtlas imageAtlas = makeImageAtlas(imageMap);
+        GlyphAtlas glyphAtlas;
+        if (sharedGlyphAtlas) {
+            glyphAtlasReference = sharedGlyphAtlas->addGlyphs(glyphMap, glyphAtlas.positions);
+        } else {
+            glyphAtlas = makeGlyphAtlas(glyphMap);
+            glyphAtlasImage = std::move(glyphAtlas.image);
+        }
 
-        glyphAtlasImage = std::move(glyphAtlas.image);
-        iconAtlasImage = std::move(imageAtlas.image);
+        ImageAtlas imageAtlas;
+        if (sharedImageAtlas) {
+            iconAtlasReference = sharedImageAtlas->addImages(imageMap, imageAtlas.positions);
+        } else {
+            imageAtlas = makeImageAtlas(imageMap);
+            iconAtlasImage = std::move(imageAtlas.image);
+        }
 
         for (auto& symbolLayout : symbolLayouts) {
             if (obsolete) {
@@ -392,7 +439,8 @@ void GeometryTileWorker::attemptPlacement() {
             }
 
             symbolLayout->prepare(glyphMap, glyphAtlas.positions,
-                                  imageMap, imageAtlas.positions);
+                                  imageMap, imageAtlas.positions,
+                                  shapingCache.get());
         }
 
         symbolLayoutsNeedPreparation = false;
@@ -420,7 +468,9 @@ void GeometryTileWorker::attemptPlacement() {
         std::move(buckets),
         std::move(collisionTile),
         std::move(glyphAtlasImage),
+        std::move(glyphAtlasReference),
         std::move(iconAtlasImage),
+        std::move(iconAtlasReference),
     }, correlationID);
 }
 
@@ -5,6 +5,8 @@
 #include <mbgl/style/image_impl.hpp>
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/text/placement_config.hpp>
+#include <mbgl/text/shared_glyph_atlas.hpp>
+#include <mbgl/renderer/shared_image_atlas.hpp>
 #include <mbgl/actor/actor_ref.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/immutable.hpp>
@@ -18,6 +20,8 @@ namespace mbgl {
 class GeometryTile;
 class GeometryTileData;
 class SymbolLayout;
+class ShapingCache;
+class BiDiCache;
 
 namespace style {
 class Layer;
@@ -30,12 +34,17 @@ public:
                        OverscaledTileID,
                        const std::atomic<bool>&,
                        const MapMode,
-                       const float pixelRatio);
+                       const float pixelRatio,
+                       std::shared_ptr<SharedGlyphAtlas>,
+                       std::shared_ptr<SharedImageAtlas>,
+                       std::shared_ptr<ShapingCache>,
+                       std::shared_ptr<BiDiCache>);
     ~GeometryTileWorker();
 
     void setLayers(std::vector<Immutable<style::Layer::Impl>>, uint64_t correlationID);
     void setData(std::unique_ptr<const GeometryTileData>, uint64_t correlationID);
     void setPlacementConfig(PlacementConfig, uint64_t correlationID);
+    void onImageAtlasRepacked(uint64_t correlationID);
     
     void onGlyphsAvailable(GlyphMap glyphs);
     void onImagesAvailable(ImageMap images, uint64_t imageCorrelationID);
@@ -60,6 +69,10 @@ private:
     const std::atomic<bool>& obsolete;
     const MapMode mode;
     const float pixelRatio;
+    const std::shared_ptr<SharedGlyphAtlas> sharedGlyphAtlas;
+    const std::shared_ptr<SharedImageAtlas> sharedImageAtlas;
+    const std::shared_ptr<ShapingCache> shapingCache;
+    const std::shared_ptr<BiDiCache> bidiCache;
 
     enum State {
         Idle,
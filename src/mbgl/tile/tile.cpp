@@ -36,8 +36,16 @@ void Tile::queryRenderedFeatures(
         const std::vector<const RenderLayer*>&,
         const RenderedQueryOptions&) {}
 
+void Tile::queryRenderedFeatureBatch(
+        QueryBatch&,
+        const TileQueryGeometries&,
+        const TransformState&,
+        const std::vector<const RenderLayer*>&,
+        const RenderedQueryOptions&) {}
+
 void Tile::querySourceFeatures(
         std::vector<Feature>&,
-        const SourceQueryOptions&) {}
+        const SourceQueryOptions&,
+        SourceFeatureIDs&) {}
 
 } // namespace mbgl
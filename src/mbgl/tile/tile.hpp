@@ -9,6 +9,7 @@
 #include <mbgl/tile/tile_necessity.hpp>
 #include <mbgl/renderer/tile_mask.hpp>
 #include <mbgl/renderer/bucket.hpp>
+#include <mbgl/renderer/query_batch.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/style/layer_impl.hpp>
@@ -16,6 +17,7 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <set>
 #include <unordered_map>
 
 namespace mbgl {
@@ -32,6 +34,9 @@ namespace gl {
 class Context;
 } // namespace gl
 
+// The IDs of the features that a source query has returned so far, by source layer.
+using SourceFeatureIDs = std::unordered_map<std::string, std::set<FeatureIdentifier>>;
+
 class Tile : private util::noncopyable {
 public:
     Tile(OverscaledTileID);
@@ -47,7 +52,8 @@ public:
     virtual void upload(gl::Context&) = 0;
     virtual Bucket* getBucket(const style::Layer::Impl&) const = 0;
 
-    virtual void setPlacementConfig(const PlacementConfig&) {}
+    // While the camera is changing, tiles may keep a placement made for a similar config.
+    virtual void setPlacementConfig(const PlacementConfig&, bool /* cameraIsChanging */ = false) {}
     virtual void setLayers(const std::vector<Immutable<style::Layer::Impl>>&) {}
     virtual void setMask(TileMask&&) {}
 
@@ -58,9 +64,20 @@ public:
             const std::vector<const RenderLayer*>&,
             const RenderedQueryOptions& options);
 
+    // Answers all queries of a batch that overlap this tile.
+    virtual void queryRenderedFeatureBatch(
+            QueryBatch&,
+            const TileQueryGeometries&,
+            const TransformState&,
+            const std::vector<const RenderLayer*>&,
+            const RenderedQueryOptions& options);
+
+    // Features with an ID that are in `returned` already are left out, so that features that
+    // span several tiles are returned once.
     virtual void querySourceFeatures(
             std::vector<Feature>& result,
-            const SourceQueryOptions&);
+            const SourceQueryOptions&,
+            SourceFeatureIDs& returned);
 
     void setTriedCache();
 
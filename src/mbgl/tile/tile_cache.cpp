@@ -58,6 +58,17 @@ bool TileCache::has(const OverscaledTileID& key) {
     return tiles.find(key) != tiles.end();
 }
 
+void TileCache::removeIf(std::function<bool (const OverscaledTileID&)> predicate) {
+    for (auto it = orderedKeys.begin(); it != orderedKeys.end();) {
+        if (predicate(*it)) {
+            tiles.erase(*it);
+            it = orderedKeys.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void TileCache::clear() {
     orderedKeys.clear();
     tiles.clear();
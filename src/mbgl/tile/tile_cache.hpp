@@ -2,6 +2,7 @@
 
 #include <mbgl/tile/tile_id.hpp>
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <map>
@@ -19,6 +20,8 @@ public:
     void add(const OverscaledTileID& key, std::unique_ptr<Tile> data);
     std::unique_ptr<Tile> get(const OverscaledTileID& key);
     bool has(const OverscaledTileID& key);
+    // Removes the tiles whose IDs match the predicate.
+    void removeIf(std::function<bool (const OverscaledTileID&)>);
     void clear();
 
 private:
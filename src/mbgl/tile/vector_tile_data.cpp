@@ -3,6 +3,30 @@
 
 namespace mbgl {
 
+namespace {
+
+// Equivalent to mapbox::vector_tile::buffer, which only accepts a std::string. Reading the layers
+// straight from the buffer lets tile data stay in whatever storage the FileSource handed us (e.g.
+// a memory-mapped archive) without copying it into a string first.
+template <class Fn>
+void eachLayer(const SharedBuffer& data, Fn&& fn) {
+    protozero::pbf_reader tileReader(data.data(), data.size());
+    while (tileReader.next(3 /* layers */)) {
+        const protozero::data_view layerView = tileReader.get_view();
+        protozero::pbf_reader layerReader(layerView);
+        optional<std::string> name;
+        while (layerReader.next(1 /* name */)) {
+            name = layerReader.get_string();
+        }
+        if (!name) {
+            throw std::runtime_error("Layer missing name");
+        }
+        fn(std::move(*name), layerView);
+    }
+}
+
+} // namespace
+
 VectorTileFeature::VectorTileFeature(const mapbox::vector_tile::layer& layer,
                                      const protozero::data_view& view)
     : feature(view, layer) {
@@ -43,7 +67,7 @@ GeometryCollection VectorTileFeature::getGeometries() const {
     }
 }
 
-VectorTileLayer::VectorTileLayer(std::shared_ptr<const std::string> data_,
+VectorTileLayer::VectorTileLayer(SharedBuffer data_,
                                  const protozero::data_view& view)
     : data(std::move(data_)), layer(view) {
 }
@@ -60,7 +84,7 @@ std::string VectorTileLayer::getName() const {
     return layer.getName();
 }
 
-VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_) : data(std::move(data_)) {
+VectorTileData::VectorTileData(SharedBuffer data_) : data(std::move(data_)) {
 }
 
 std::unique_ptr<GeometryTileData> VectorTileData::clone() const {
@@ -71,7 +95,9 @@ std::unique_ptr<GeometryTileLayer> VectorTileData::getLayer(const std::string& n
     if (!parsed) {
         // We're parsing this lazily so that we can construct VectorTileData objects on the main
         // thread without incurring the overhead of parsing immediately.
-        layers = mapbox::vector_tile::buffer(*data).getLayers();
+        eachLayer(data, [&](std::string layerName, const protozero::data_view& view) {
+            layers.emplace(std::move(layerName), view);
+        });
         parsed = true;
     }
 
@@ -83,7 +109,11 @@ std::unique_ptr<GeometryTileLayer> VectorTileData::getLayer(const std::string& n
 }
 
 std::vector<std::string> VectorTileData::layerNames() const {
-    return mapbox::vector_tile::buffer(*data).layerNames();
+    std::vector<std::string> names;
+    eachLayer(data, [&](std::string layerName, const protozero::data_view&) {
+        names.push_back(std::move(layerName));
+    });
+    return names;
 }
 
 } // namespace mbgl
@@ -1,4 +1,5 @@
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/shared_buffer.hpp>
 
 #include <mapbox/vector_tile.hpp>
 #include <protozero/pbf_reader.hpp>
@@ -25,20 +26,20 @@ private:
 
 class VectorTileLayer : public GeometryTileLayer {
 public:
-    VectorTileLayer(std::shared_ptr<const std::string> data, const protozero::data_view&);
+    VectorTileLayer(SharedBuffer data, const protozero::data_view&);
 
     std::size_t featureCount() const override;
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override;
     std::string getName() const override;
 
 private:
-    std::shared_ptr<const std::string> data;
+    SharedBuffer data;
     mapbox::vector_tile::layer layer;
 };
 
 class VectorTileData : public GeometryTileData {
 public:
-    VectorTileData(std::shared_ptr<const std::string> data);
+    VectorTileData(SharedBuffer data);
 
     std::unique_ptr<GeometryTileData> clone() const override;
     std::unique_ptr<GeometryTileLayer> getLayer(const std::string& name) const override;
@@ -46,7 +47,7 @@ public:
     std::vector<std::string> layerNames() const;
 
 private:
-    std::shared_ptr<const std::string> data;
+    SharedBuffer data;
     mutable bool parsed = false;
     mutable std::map<std::string, const protozero::data_view> layers;
 };
@@ -2,6 +2,7 @@
 
 #include <zlib.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <stdexcept>
@@ -27,7 +28,7 @@ namespace util {
 // cause a link error.
 #undef compress
 
-std::string compress(const std::string &raw) {
+std::string compress(const char* raw, std::size_t size) {
     z_stream deflate_stream;
     memset(&deflate_stream, 0, sizeof(deflate_stream));
 
@@ -36,8 +37,8 @@ std::string compress(const std::string &raw) {
         throw std::runtime_error("failed to initialize deflate");
     }
 
-    deflate_stream.next_in = (Bytef *)raw.data();
-    deflate_stream.avail_in = uInt(raw.size());
+    deflate_stream.next_in = (Bytef *)raw;
+    deflate_stream.avail_in = uInt(size);
 
     std::string result;
     char out[16384];
@@ -62,30 +63,35 @@ std::string compress(const std::string &raw) {
     return result;
 }
 
-std::string decompress(const std::string &raw) {
+std::string decompress(const char* raw, std::size_t size) {
     z_stream inflate_stream;
     memset(&inflate_stream, 0, sizeof(inflate_stream));
 
     // TODO: reuse z_streams
-    if (inflateInit(&inflate_stream) != Z_OK) {
+    // Adding 32 to the window bits enables automatic zlib/gzip header detection.
+    if (inflateInit2(&inflate_stream, MAX_WBITS + 32) != Z_OK) {
         throw std::runtime_error("failed to initialize inflate");
     }
 
-    inflate_stream.next_in = (Bytef *)raw.data();
-    inflate_stream.avail_in = uInt(raw.size());
+    inflate_stream.next_in = (Bytef *)raw;
+    inflate_stream.avail_in = uInt(size);
 
+    // Reserve room for the typical compression ratio, and append each inflated block to the
+    // result. Growing the result with resize() would zero-fill memory that inflate overwrites.
+    char out[16384];
     std::string result;
-    char out[15384];
+    result.reserve(std::max(size * 4, sizeof(out)));
 
     int code;
     do {
         inflate_stream.next_out = reinterpret_cast<Bytef *>(out);
         inflate_stream.avail_out = sizeof(out);
         code = inflate(&inflate_stream, 0);
-        // result.append(out, sizeof(out) - inflate_stream.avail_out);
-        if (result.size() < inflate_stream.total_out) {
-            result.append(out, inflate_stream.total_out - result.size());
+        const std::size_t inflated = sizeof(out) - inflate_stream.avail_out;
+        if (result.capacity() - result.size() < inflated) {
+            result.reserve(result.capacity() * 2);
         }
+        result.append(out, inflated);
     } while (code == Z_OK);
 
     inflateEnd(&inflate_stream);
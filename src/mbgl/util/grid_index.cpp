@@ -2,7 +2,7 @@
 #include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/math/minmax.hpp>
 
-#include <unordered_set>
+#include <cmath>
 
 namespace mbgl {
 
@@ -15,66 +15,69 @@ GridIndex<T>::GridIndex(int32_t extent_, int32_t n_, int32_t padding_) :
     d(n + 2 * padding),
     scale(double(n) / double(extent)),
     min(-double(padding) / n * extent),
-    max(extent + double(padding) / n * extent)
+    max(extent + double(padding) / n * extent),
+    cellOffsets(d * d + 1, 0)
     {
-        cells.resize(d * d);
     }
 
 template <class T>
 void GridIndex<T>::insert(T&& t, const BBox& bbox) {
-    size_t uid = elements.size();
-
-    auto cx1 = convertToCellCoord(bbox.min.x);
-    auto cy1 = convertToCellCoord(bbox.min.y);
-    auto cx2 = convertToCellCoord(bbox.max.x);
-    auto cy2 = convertToCellCoord(bbox.max.y);
-
-    int32_t x, y, cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = d * y + x;
-            cells[cellIndex].push_back(uid);
-        }
+    // Inserting empties the cells until the next call to `finish`.
+    if (finished) {
+        cellOffsets.assign(d * d + 1, 0);
+        cellElements.clear();
+        finished = false;
     }
 
-    elements.emplace_back(t, bbox);
+    elements.push_back(std::move(t));
+    boxes.push_back(bbox);
 }
 
 template <class T>
-std::vector<T> GridIndex<T>::query(const BBox& queryBBox) const {
-    std::vector<T> result;
-    std::unordered_set<size_t> seenUids;
-
-    auto cx1 = convertToCellCoord(queryBBox.min.x);
-    auto cy1 = convertToCellCoord(queryBBox.min.y);
-    auto cx2 = convertToCellCoord(queryBBox.max.x);
-    auto cy2 = convertToCellCoord(queryBBox.max.y);
-
-    int32_t x, y, cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = d * y + x;
-            for (auto uid : cells[cellIndex]) {
-                if (seenUids.count(uid) == 0) {
-                    seenUids.insert(uid);
+void GridIndex<T>::finish() {
+    // Count the elements of each cell, turn the counts into offsets, and then fill in the
+    // elements, keeping them in insertion order within each cell.
+    cellOffsets.assign(d * d + 1, 0);
+
+    std::vector<CellRange> ranges;
+    ranges.reserve(boxes.size());
+    for (const BBox& bbox : boxes) {
+        const CellRange range = cellRange(bbox);
+        for (int32_t y = range.y1; y <= range.y2; ++y) {
+            for (int32_t x = range.x1; x <= range.x2; ++x) {
+                cellOffsets[d * y + x + 1]++;
+            }
+        }
+        ranges.push_back(range);
+    }
 
-                    auto& pair = elements.at(uid);
-                    auto& bbox = pair.second;
-                    if (queryBBox.min.x <= bbox.max.x &&
-                        queryBBox.min.y <= bbox.max.y &&
-                        queryBBox.max.x >= bbox.min.x &&
-                        queryBBox.max.y >= bbox.min.y) {
+    for (std::size_t i = 1; i < cellOffsets.size(); ++i) {
+        cellOffsets[i] += cellOffsets[i - 1];
+    }
 
-                        result.push_back(pair.first);
-                    }
-                }
+    cellElements.resize(cellOffsets.back());
+    std::vector<uint32_t> next(cellOffsets.begin(), cellOffsets.end() - 1);
+    for (uint32_t uid = 0; uid < ranges.size(); ++uid) {
+        const CellRange& range = ranges[uid];
+        for (int32_t y = range.y1; y <= range.y2; ++y) {
+            for (int32_t x = range.x1; x <= range.x2; ++x) {
+                cellElements[next[d * y + x]++] = uid;
             }
         }
     }
 
-    return result;
+    finished = true;
 }
 
+template <class T>
+typename GridIndex<T>::CellRange GridIndex<T>::cellRange(const BBox& bbox) const {
+    return CellRange {
+        convertToCellCoord(bbox.min.x),
+        convertToCellCoord(bbox.min.y),
+        convertToCellCoord(bbox.max.x),
+        convertToCellCoord(bbox.max.y)
+    };
+}
 
 template <class T>
 int32_t GridIndex<T>::convertToCellCoord(int32_t x) const {
@@ -82,4 +85,6 @@ int32_t GridIndex<T>::convertToCellCoord(int32_t x) const {
 }
 
 template class GridIndex<IndexedSubfeature>;
+template class GridIndex<std::size_t>;
+
 } // namespace mbgl
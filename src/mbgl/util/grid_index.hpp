@@ -1,14 +1,26 @@
 #pragma once
 
+#include <mbgl/math/minmax.hpp>
+
 #include <mapbox/geometry/point.hpp>
 #include <mapbox/geometry/box.hpp>
 
+#include <cassert>
 #include <cstdint>
 #include <cstddef>
 #include <vector>
 
 namespace mbgl {
 
+/*
+    GridIndex is a uniform grid index for the bounding boxes of the features of a tile. Elements
+    are inserted while the tile is laid out; `finish` then lays the cells out compactly, as one
+    array of element indices ordered by cell plus the offset of each cell into that array.
+
+    Queries don't allocate: like `CollisionGrid`, they report an element only from the first
+    cell that both the element and the query box cover, instead of keeping track of the elements
+    they have already seen. That also allows queries to run concurrently.
+*/
 template <class T>
 class GridIndex {
 public:
@@ -17,9 +29,31 @@ public:
     using BBox = mapbox::geometry::box<int16_t>;
 
     void insert(T&& t, const BBox&);
-    std::vector<T> query(const BBox&) const;
+
+    // Builds the cells from the inserted elements. Must be called after the last insertion;
+    // until then, queries report no elements.
+    void finish();
+
+    // Calls `visitor` for each element whose box intersects or touches the query box, in no
+    // particular order. Stops as soon as `visitor` returns false, and returns false in that case.
+    template <class Visitor>
+    bool query(const BBox&, Visitor&&) const;
+
+    // Like `query`, but also passes the box each element was inserted with to `visitor`.
+    template <class Visitor>
+    bool queryWithBoxes(const BBox&, Visitor&&) const;
+
+    std::size_t size() const { return elements.size(); }
 
 private:
+    struct CellRange {
+        int32_t x1;
+        int32_t y1;
+        int32_t x2;
+        int32_t y2;
+    };
+
+    CellRange cellRange(const BBox&) const;
     int32_t convertToCellCoord(int32_t x) const;
 
     const int32_t extent;
@@ -30,9 +64,59 @@ private:
     const int32_t min;
     const int32_t max;
 
-    std::vector<std::pair<T, BBox>> elements;
-    std::vector<std::vector<size_t>> cells;
+    std::vector<T> elements;
+    std::vector<BBox> boxes;
 
+    // The elements of cell `i` are cellElements[cellOffsets[i]] to cellElements[cellOffsets[i + 1]].
+    std::vector<uint32_t> cellOffsets;
+    std::vector<uint32_t> cellElements;
+
+    // Whether the cells hold the elements inserted so far.
+    bool finished = false;
 };
 
+template <class T>
+template <class Visitor>
+bool GridIndex<T>::query(const BBox& queryBBox, Visitor&& visitor) const {
+    return queryWithBoxes(queryBBox, [&] (const T& t, const BBox&) {
+        return visitor(t);
+    });
+}
+
+template <class T>
+template <class Visitor>
+bool GridIndex<T>::queryWithBoxes(const BBox& queryBBox, Visitor&& visitor) const {
+    assert(cellOffsets.size() == std::size_t(d * d + 1));
+
+    const CellRange range = cellRange(queryBBox);
+
+    for (int32_t y = range.y1; y <= range.y2; ++y) {
+        for (int32_t x = range.x1; x <= range.x2; ++x) {
+            const int32_t cellIndex = d * y + x;
+            for (uint32_t i = cellOffsets[cellIndex]; i < cellOffsets[cellIndex + 1]; ++i) {
+                const uint32_t uid = cellElements[i];
+                const BBox& bbox = boxes[uid];
+                if (queryBBox.min.x > bbox.max.x ||
+                    queryBBox.min.y > bbox.max.y ||
+                    queryBBox.max.x < bbox.min.x ||
+                    queryBBox.max.y < bbox.min.y) {
+                    continue;
+                }
+
+                const CellRange elementRange = cellRange(bbox);
+                if (x != util::max(elementRange.x1, range.x1) ||
+                    y != util::max(elementRange.y1, range.y1)) {
+                    continue;
+                }
+
+                if (!visitor(elements[uid], bbox)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
 } // namespace mbgl
@@ -392,6 +392,12 @@ bool allowsIdeographicBreaking(char16_t chr) {
     //        || isInCJKCompatibilityIdeographsSupplement(chr));
 }
 
+bool isIdeograph(char16_t chr) {
+    return (isInCJKUnifiedIdeographs(chr) || isInCJKUnifiedIdeographsExtensionA(chr) ||
+            isInCJKCompatibilityIdeographs(chr) || isInHiragana(chr) || isInKatakana(chr) ||
+            isInHangulSyllables(chr));
+}
+
 bool allowsVerticalWritingMode(const std::u16string& string) {
     for (char32_t chr : string) {
         if (hasUprightVerticalOrientation(chr)) {
@@ -23,6 +23,12 @@ bool allowsIdeographicBreaking(const std::u16string& string);
     by the given Unicode codepoint due to ideographic breaking. */
 bool allowsIdeographicBreaking(char16_t chr);
 
+/** Returns true if the given Unicode codepoint identifies a CJK ideograph,
+    kana or Hangul syllable. These characters all share the same square
+    metrics, so they can be drawn from a local font in place of the glyphs
+    served with a style. */
+bool isIdeograph(char16_t chr);
+
 /** Returns whether any substring of the given string can be drawn as vertical
     text with upright glyphs. */
 bool allowsVerticalWritingMode(const std::u16string& string);
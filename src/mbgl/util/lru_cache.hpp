@@ -0,0 +1,112 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace mbgl {
+
+/*
+    LRUCache is a thread-safe cache of computed values that holds at most `capacity` values and
+    drops the least recently used ones first.
+
+    Values are computed without holding the lock, so that threads looking up other keys aren't
+    blocked. Two threads may end up computing the same value concurrently, in which case the
+    first result is kept.
+*/
+template <class Key, class Value, class Hash = std::hash<Key>, class Equal = std::equal_to<Key>>
+class LRUCache : private util::noncopyable {
+public:
+    LRUCache(std::size_t capacity_)
+        : capacity(capacity_) {
+        assert(capacity > 0);
+    }
+
+    // Returns the cached value for the key, or calls `compute` and adds the value it returns.
+    template <class Compute>
+    Value get(Key key, Compute&& compute) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = entries.find(key);
+            if (it != entries.end()) {
+                lru.splice(lru.begin(), lru, it->second.lru);
+                hits++;
+                return it->second.value;
+            }
+            misses++;
+        }
+
+        Value value = compute();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto result = entries.emplace(std::move(key), Entry { value, {} });
+        if (!result.second) {
+            return value;
+        }
+
+        result.first->second.lru = lru.insert(lru.begin(), &result.first->first);
+
+        while (entries.size() > capacity) {
+            const Key* oldest = lru.back();
+            lru.pop_back();
+            entries.erase(entries.find(*oldest));
+            evictions++;
+        }
+
+        return value;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+        lru.clear();
+    }
+
+    struct Stats {
+        std::size_t entries = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+
+        double hitRate() const {
+            return hits + misses ? double(hits) / (hits + misses) : 0;
+        }
+    };
+
+    Stats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        Stats stats;
+        stats.entries = entries.size();
+        stats.hits = hits;
+        stats.misses = misses;
+        stats.evictions = evictions;
+        return stats;
+    }
+
+private:
+    struct Entry {
+        Value value;
+        // Position in `lru`.
+        typename std::list<const Key*>::iterator lru;
+    };
+
+    const std::size_t capacity;
+
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Entry, Hash, Equal> entries;
+
+    // Keys of `entries`, most recently used first.
+    std::list<const Key*> lru;
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+} // namespace mbgl
@@ -0,0 +1,79 @@
+#include <mbgl/util/parallel.hpp>
+#include <mbgl/actor/actor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+class JobQueue {
+public:
+    JobQueue(std::vector<std::function<void()>>& jobs_) : jobs(jobs_) {}
+
+    // Runs jobs until there are none left to claim.
+    void drain() {
+        for (std::size_t i = next++; i < jobs.size(); i = next++) {
+            jobs[i]();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (++finished == jobs.size()) {
+                finishedCondition.notify_all();
+            }
+        }
+    }
+
+    // Blocks until jobs claimed by other threads have finished as well.
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        finishedCondition.wait(lock, [&] { return finished == jobs.size(); });
+    }
+
+private:
+    std::vector<std::function<void()>>& jobs;
+    std::atomic<std::size_t> next { 0 };
+
+    std::mutex mutex;
+    std::condition_variable finishedCondition;
+    std::size_t finished = 0;
+};
+
+class Helper {
+public:
+    Helper(JobQueue& queue_) : queue(queue_) {}
+
+    void run() {
+        queue.drain();
+    }
+
+private:
+    JobQueue& queue;
+};
+
+} // namespace
+
+void runInParallel(Scheduler& scheduler, std::vector<std::function<void()>>& jobs, std::size_t maxHelpers) {
+    if (jobs.empty()) {
+        return;
+    }
+
+    JobQueue queue(jobs);
+
+    // Destroying the helpers closes their mailboxes, which waits for running helpers to return and
+    // discards those that the scheduler hasn't started yet, before the queue goes away.
+    std::vector<std::unique_ptr<Actor<Helper>>> helpers;
+    for (std::size_t i = 0; i < std::min(maxHelpers, jobs.size() - 1); i++) {
+        helpers.push_back(std::make_unique<Actor<Helper>>(scheduler, queue));
+        helpers.back()->invoke(&Helper::run);
+    }
+
+    queue.drain();
+    queue.wait();
+}
+
+} // namespace util
+} // namespace mbgl
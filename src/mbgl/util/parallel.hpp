@@ -0,0 +1,19 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace mbgl {
+
+class Scheduler;
+
+namespace util {
+
+// Runs all `jobs`, in no particular order, on the calling thread and on up to `maxHelpers` threads
+// of `scheduler`, and returns once all of them have finished. The calling thread claims jobs
+// too, so this never waits for the scheduler to get around to the helpers: jobs that no helper
+// has picked up are run by the calling thread.
+void runInParallel(Scheduler&, std::vector<std::function<void()>>& jobs, std::size_t maxHelpers);
+
+} // namespace util
+} // namespace mbgl
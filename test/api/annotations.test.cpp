@@ -12,6 +12,8 @@
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/gl/headless_frontend.hpp>
 
+#include <set>
+
 using namespace mbgl;
 
 namespace {
@@ -160,6 +162,49 @@ TEST(Annotations, AddMultiple) {
     test.checkRendering("add_multiple");
 }
 
+TEST(Annotations, AddMultipleBatch) {
+    AnnotationTest test;
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+    test.map.addAnnotationImage(namedMarker("default_marker"));
+    AnnotationIDs ids = test.map.addAnnotations({
+        SymbolAnnotation { Point<double> { -10, 0 }, "default_marker" },
+        SymbolAnnotation { Point<double> { 10, 0 }, "default_marker" },
+    });
+    ASSERT_EQ(ids.size(), 2u);
+    EXPECT_EQ(ids[0] + 1, ids[1]);
+
+    test.checkRendering("add_multiple");
+}
+
+TEST(Annotations, RemoveBatch) {
+    AnnotationTest test;
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+    test.map.addAnnotationImage(namedMarker("default_marker"));
+    AnnotationID point = test.map.addAnnotation(SymbolAnnotation { Point<double> { 0, 0 }, "default_marker" });
+
+    // Large batches bulk-load the symbol tree, which must keep the annotations added before.
+    std::vector<Annotation> annotations;
+    for (int i = 0; i < 1000; ++i) {
+        annotations.push_back(SymbolAnnotation { Point<double> { 20 + i / 100.0, 20 }, "default_marker" });
+    }
+    annotations.push_back(LineAnnotation { LineString<double> {{ { -20, -20 }, { -10, -10 } }} });
+    AnnotationIDs ids = test.map.addAnnotations(annotations);
+
+    test.frontend.render(test.map);
+
+    // Removing the batch packs the tree again with the symbol that remains.
+    test.map.removeAnnotations(ids);
+    test.frontend.render(test.map);
+    auto features = test.frontend.getRenderer()->queryRenderedFeatures(test.map.pixelForLatLng({ 0, 0 }));
+    ASSERT_EQ(features.size(), 1u);
+    EXPECT_EQ(*features[0].id, uint64_t(point));
+
+    test.map.removeAnnotations({ point });
+    test.checkRendering("remove_point");
+}
+
 TEST(Annotations, NonImmediateAdd) {
     AnnotationTest test;
 
@@ -356,6 +401,86 @@ TEST(Annotations, QueryRenderedFeatures) {
     EXPECT_EQ(*features2[0].id, uint64_t(1));
 }
 
+TEST(Annotations, UpdateAnnotationsAcrossTiles) {
+    AnnotationTest test;
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+    test.map.addAnnotationImage(namedMarker("default_marker"));
+    test.map.setLatLngZoom({ 0, 0 }, 1);
+
+    // Each annotation starts out in a different tile.
+    AnnotationID moved = test.map.addAnnotation(SymbolAnnotation { Point<double> { 10, 10 }, "default_marker" });
+    AnnotationID kept = test.map.addAnnotation(SymbolAnnotation { Point<double> { -10, -10 }, "default_marker" });
+    AnnotationID line = test.map.addAnnotation(LineAnnotation { LineString<double> {{ { -30, 10 }, { -10, 30 } }}, 1.0f, 5.0f, { Color::red() } });
+    test.frontend.render(test.map);
+
+    auto query = [&] (const LatLng& latLng) {
+        return test.frontend.getRenderer()->queryRenderedFeatures(test.map.pixelForLatLng(latLng));
+    };
+    ASSERT_EQ(query({ 10, 10 }).size(), 1u);
+    ASSERT_EQ(query({ 20, -20 }).size(), 1u);
+
+    // Only the tiles that held or now hold a changed annotation are regenerated (which
+    // AnnotationTile.UpdateRegeneratesOnlyAffectedTiles checks), but all of them reflect the
+    // changes.
+    test.map.updateAnnotation(moved, SymbolAnnotation { Point<double> { 10, -10 }, "default_marker" });
+    test.map.removeAnnotation(line);
+    test.frontend.render(test.map);
+
+    EXPECT_TRUE(query({ 10, 10 }).empty());
+    EXPECT_TRUE(query({ 20, -20 }).empty());
+
+    auto movedFeatures = query({ -10, 10 });
+    ASSERT_EQ(movedFeatures.size(), 1u);
+    EXPECT_EQ(*movedFeatures[0].id, uint64_t(moved));
+
+    auto keptFeatures = query({ -10, -10 });
+    ASSERT_EQ(keptFeatures.size(), 1u);
+    EXPECT_EQ(*keptFeatures[0].id, uint64_t(kept));
+}
+
+TEST(Annotations, ManyShapeAnnotations) {
+    AnnotationTest test;
+
+    auto viewSize = test.frontend.getSize();
+    auto box = ScreenBox { {}, { double(viewSize.width), double(viewSize.height) } };
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+    test.map.setLatLngZoom({ 0, 0 }, 1);
+
+    // More shapes than fit into a single group of the shared shape index.
+    std::vector<AnnotationID> ids;
+    for (int x = 0; x < 20; ++x) {
+        for (int y = 0; y < 20; ++y) {
+            const double west = -40 + x * 4;
+            const double south = -40 + y * 4;
+            Polygon<double> square = { {{ { west, south }, { west + 2, south }, { west + 2, south + 2 }, { west, south + 2 } }} };
+            ids.push_back(test.map.addAnnotation(FillAnnotation { square }));
+        }
+    }
+
+    auto uniqueIDs = [&] {
+        std::set<uint64_t> result;
+        for (const auto& feature : test.frontend.getRenderer()->queryRenderedFeatures(box)) {
+            result.insert(feature.id->get<uint64_t>());
+        }
+        return result;
+    };
+
+    test.frontend.render(test.map);
+    EXPECT_EQ(uniqueIDs().size(), ids.size());
+
+    for (std::size_t i = 0; i < ids.size(); i += 2) {
+        test.map.removeAnnotation(ids[i]);
+    }
+    test.frontend.render(test.map);
+
+    const std::set<uint64_t> remaining = uniqueIDs();
+    EXPECT_EQ(remaining.size(), ids.size() / 2);
+    EXPECT_EQ(remaining.count(ids[0]), 0u);
+    EXPECT_EQ(remaining.count(ids[1]), 1u);
+}
+
 TEST(Annotations, QueryFractionalZoomLevels) {
     AnnotationTest test;
 
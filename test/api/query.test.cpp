@@ -83,6 +83,103 @@ TEST(Query, QueryRenderedFeaturesFilter) {
     EXPECT_EQ(features3.size(), 1u);
 }
 
+TEST(Query, QueryRenderedFeaturesParallel) {
+    QueryTest test;
+
+    // The features lie on the corner of four tiles.
+    test.map.setZoom(3);
+    test.frontend.render(test.map);
+
+    const ScreenBox box { { 0, 0 }, { double(test.frontend.getSize().width), double(test.frontend.getSize().height) } };
+    auto serial = test.frontend.getRenderer()->queryRenderedFeatures(box);
+    ASSERT_FALSE(serial.empty());
+
+    // Querying the tiles in parallel returns the same features in the same order.
+    test.frontend.getRenderer()->setParallelFeatureQueries(true);
+    auto parallel = test.frontend.getRenderer()->queryRenderedFeatures(box);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_EQ(serial[i].id, parallel[i].id);
+        EXPECT_EQ(serial[i].properties, parallel[i].properties);
+    }
+}
+
+TEST(Query, QueryRenderedFeaturesBatch) {
+    QueryTest test;
+    auto renderer = test.frontend.getRenderer();
+
+    const std::vector<ScreenCoordinate> points {
+        test.map.pixelForLatLng({ 0, 0 }),
+        test.map.pixelForLatLng({ 9, 9 }),
+        test.map.pixelForLatLng({ 0, 0 }),
+    };
+    const std::vector<ScreenBox> boxes {
+        { { 0, 0 }, { double(test.frontend.getSize().width), double(test.frontend.getSize().height) } },
+        { points[0] - ScreenCoordinate { 10, 10 }, points[0] + ScreenCoordinate { 10, 10 } },
+    };
+
+    // Each query of a batch hits the same features in the same order as when queried alone.
+    auto checkBatch = [&] (const RenderedQueryBatchResult& batch, const auto& queries, const RenderedQueryOptions& options) {
+        ASSERT_EQ(queries.size() + 1, batch.offsets.size());
+        EXPECT_EQ(batch.featureIndices.size(), batch.offsets.back());
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            auto single = renderer->queryRenderedFeatures(queries[i], options);
+            ASSERT_EQ(single.size(), batch.offsets[i + 1] - batch.offsets[i]);
+            for (std::size_t j = 0; j < single.size(); ++j) {
+                const QueriedFeature& feature = batch.features.at(batch.featureIndices[batch.offsets[i] + j]);
+                EXPECT_EQ(single[j].id, feature.getID());
+                EXPECT_EQ(single[j].properties, feature.getProperties());
+            }
+        }
+    };
+
+    auto pointResult = renderer->queryRenderedFeaturesBatch(points);
+    checkBatch(pointResult, points, {});
+    EXPECT_EQ(4u, pointResult.offsets[1] - pointResult.offsets[0]);
+    EXPECT_EQ(0u, pointResult.offsets[2] - pointResult.offsets[1]);
+
+    // Features that several queries hit are only stored once.
+    EXPECT_EQ(4u, pointResult.features.size());
+
+    checkBatch(renderer->queryRenderedFeaturesBatch(boxes), boxes, {});
+
+    const RenderedQueryOptions options {{{ "layer1", "layer2" }}, {}};
+    checkBatch(renderer->queryRenderedFeaturesBatch(points, options), points, options);
+}
+
+TEST(Query, QueryRenderedFeatureHandles) {
+    QueryTest test;
+    auto renderer = test.frontend.getRenderer();
+
+    const ScreenCoordinate point = test.map.pixelForLatLng({ 0, 0 });
+    auto features = renderer->queryRenderedFeatures(point);
+    auto handles = renderer->queryRenderedFeatureHandles(point);
+    ASSERT_EQ(4u, handles.size());
+    ASSERT_EQ(features.size(), handles.size());
+
+    // The handles decode the same features, even once their tiles are gone.
+    test.map.getStyle().loadJSON(R"STYLE({ "version": 8, "sources": {}, "layers": [] })STYLE");
+    test.frontend.render(test.map);
+    ASSERT_TRUE(renderer->queryRenderedFeatures(point).empty());
+
+    for (std::size_t i = 0; i < features.size(); ++i) {
+        EXPECT_EQ(features[i].id, handles[i].getID());
+        EXPECT_EQ(features[i].properties, handles[i].getProperties());
+        EXPECT_EQ(features[i].geometry, handles[i].getGeometry());
+        EXPECT_EQ(FeatureType::Point, handles[i].getType());
+
+        const Feature feature = handles[i].toFeature();
+        EXPECT_EQ(features[i].id, feature.id);
+        EXPECT_EQ(features[i].properties, feature.properties);
+    }
+
+    auto withKey = std::find_if(handles.begin(), handles.end(), [] (const QueriedFeature& handle) {
+        return bool(handle.getValue("key1"));
+    });
+    ASSERT_NE(handles.end(), withKey);
+    EXPECT_EQ(Value(std::string("value1")), *withKey->getValue("key1"));
+}
+
 TEST(Query, QuerySourceFeatures) {
     QueryTest test;
 
@@ -122,3 +219,31 @@ TEST(Query, QuerySourceFeaturesFilter) {
     EXPECT_EQ(features3.size(), 1u);
 }
 
+TEST(Query, QuerySourceFeaturesBounds) {
+    QueryTest test;
+    auto renderer = test.frontend.getRenderer();
+
+    auto features1 = renderer->querySourceFeatures("source4", {{}, {}, LatLngBounds::hull({ -1, -1 }, { 1, 1 })});
+    EXPECT_EQ(features1.size(), 1u);
+
+    auto features2 = renderer->querySourceFeatures("source4", {{}, {}, LatLngBounds::hull({ 10, 10 }, { 20, 20 })});
+    EXPECT_EQ(features2.size(), 0u);
+
+    const EqualsFilter eqFilter = { "key1", std::string("value2") };
+    auto features3 = renderer->querySourceFeatures("source4", {{}, { eqFilter }, LatLngBounds::hull({ -1, -1 }, { 1, 1 })});
+    EXPECT_EQ(features3.size(), 0u);
+}
+
+TEST(Query, QuerySourceFeaturesSpanningTiles) {
+    QueryTest test;
+
+    // The feature lies on the corner of four tiles, but is returned once.
+    test.map.setZoom(3);
+    test.frontend.render(test.map);
+
+    auto features1 = test.frontend.getRenderer()->querySourceFeatures("source4");
+    EXPECT_EQ(features1.size(), 1u);
+
+    auto features2 = test.frontend.getRenderer()->querySourceFeatures("source4", {{}, {}, LatLngBounds::hull({ -1, -1 }, { 1, 1 })});
+    EXPECT_EQ(features2.size(), 1u);
+}
@@ -0,0 +1,36 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/layout/symbol_projection.hpp>
+#include <mbgl/map/transform.hpp>
+#include <mbgl/util/constants.hpp>
+
+using namespace mbgl;
+
+TEST(SymbolProjection, ProjectPoints) {
+    Transform transform;
+    transform.resize({ 512, 512 });
+    transform.setLatLngZoom({ 40.726989, -73.992857 }, 20);
+    transform.setAngle(0.5);
+    transform.setPitch(60 * util::DEG2RAD);
+
+    // At zoom level 20, the translation of the tile matrix is too large for float precision.
+    mat4 matrix;
+    mat4 projMatrix;
+    transform.getState().matrixFor(matrix, UnwrappedTileID(20, 308784, 394107));
+    transform.getState().getProjMatrix(projMatrix);
+    matrix::multiply(matrix, projMatrix, matrix);
+
+    // An odd number of points, to cover both batched and remaining points.
+    const std::vector<float> x { 0, util::EXTENT, 1234.5f, -300, 4096, 8000, 17 };
+    const std::vector<float> y { 0, util::EXTENT, 4321.5f, 5000, -200, 100, 8191 };
+    std::vector<float> projectedX(x.size()), projectedY(x.size()), cameraDistance(x.size());
+    projectPoints(matrix, x.size(), x.data(), y.data(), projectedX.data(), projectedY.data(), cameraDistance.data());
+
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        vec4 pos = {{ x[i], y[i], 0, 1 }};
+        matrix::transformMat4(pos, pos, matrix);
+        EXPECT_FLOAT_EQ(float(pos[0] / pos[3]), projectedX[i]);
+        EXPECT_FLOAT_EQ(float(pos[1] / pos[3]), projectedY[i]);
+        EXPECT_FLOAT_EQ(float(pos[3]), cameraDistance[i]);
+    }
+}
@@ -0,0 +1,151 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/renderer/shared_image_atlas.hpp>
+#include <mbgl/renderer/backend_scope.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/context.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+Immutable<style::Image::Impl> makeImage(const std::string& id, Size size, uint8_t value = 255) {
+    PremultipliedImage image(size);
+    image.fill(value);
+    return makeMutable<style::Image::Impl>(id, std::move(image), 1);
+}
+
+ImageMap makeImageMap(std::initializer_list<Immutable<style::Image::Impl>> images) {
+    ImageMap imageMap;
+    for (const auto& image : images) {
+        imageMap.emplace(image->id, image);
+    }
+    return imageMap;
+}
+
+} // namespace
+
+TEST(SharedImageAtlas, Basic) {
+    auto atlas = std::make_shared<SharedImageAtlas>();
+
+    auto one = makeImage("one", { 16, 12 });
+    auto two = makeImage("two", { 8, 8 });
+
+    ImagePositions positionsA;
+    auto referenceA = atlas->addImages(makeImageMap({ one, two }), positionsA);
+    ASSERT_EQ(2u, positionsA.size());
+
+    const ImagePosition& a = positionsA.at("one");
+    EXPECT_EQ(16, a.textureRect.w);
+    EXPECT_EQ(12, a.textureRect.h);
+
+    // Images that are used by several tiles are only copied once.
+    ImagePositions positionsB;
+    auto referenceB = atlas->addImages(makeImageMap({ one }), positionsB);
+    EXPECT_EQ(positionsA.at("one").textureRect, positionsB.at("one").textureRect);
+    EXPECT_EQ(2u, atlas->getStats().images);
+
+    // An updated image with the same ID gets its own region, since tiles may still use the
+    // previous one.
+    ImagePositions positionsC;
+    auto referenceC = atlas->addImages(makeImageMap({ makeImage("one", { 16, 12 }, 128) }), positionsC);
+    EXPECT_FALSE(positionsA.at("one").textureRect == positionsC.at("one").textureRect);
+    EXPECT_EQ(3u, atlas->getStats().images);
+    EXPECT_EQ(3u, atlas->getStats().referencedImages);
+
+    referenceA.reset();
+    EXPECT_EQ(2u, atlas->getStats().referencedImages);
+    EXPECT_EQ(3u, atlas->getStats().images);
+
+    EXPECT_EQ(0u, atlas->getGeneration());
+    EXPECT_EQ(128u * 128u * 4u, atlas->getStats().memoryBytes);
+}
+
+TEST(SharedImageAtlas, Evict) {
+    auto atlas = std::make_shared<SharedImageAtlas>(Size { 32, 16 }, Size { 32, 16 });
+
+    ImagePositions positionsA;
+    auto referenceA = atlas->addImages(makeImageMap({ makeImage("a", { 14, 14 }), makeImage("b", { 14, 14 }) }), positionsA);
+    ASSERT_EQ(2u, positionsA.size());
+
+    referenceA.reset();
+
+    ImagePositions positionsB;
+    auto referenceB = atlas->addImages(makeImageMap({ makeImage("c", { 14, 14 }) }), positionsB);
+    ASSERT_EQ(1u, positionsB.size());
+    EXPECT_EQ(1u, atlas->getStats().evictedImages);
+    EXPECT_EQ(2u, atlas->getStats().images);
+}
+
+TEST(SharedImageAtlas, Repack) {
+    HeadlessBackend backend { { 256, 256 } };
+    BackendScope scope { backend };
+    gl::Context context;
+
+    auto atlas = std::make_shared<SharedImageAtlas>(Size { 64, 32 }, Size { 64, 32 });
+
+    // Fill the atlas with eight square icons, each used by another tile.
+    std::vector<std::unique_ptr<SharedImageAtlas::Reference>> references;
+    for (char id = 'a'; id < 'i'; ++id) {
+        ImagePositions positions;
+        references.push_back(atlas->addImages(makeImageMap({ makeImage({ id }, { 14, 14 }) }), positions));
+        ASSERT_EQ(1u, positions.size());
+    }
+    atlas->upload(context, 0);
+
+    references[0].reset();
+    references[2].reset();
+    references[5].reset();
+    references[7].reset();
+
+    // Half of the atlas is free, but there's no room for a wide icon.
+    auto wide = makeImage("wide", { 30, 14 });
+    ImagePositions positionsA;
+    auto referenceA = atlas->addImages(makeImageMap({ wide }), positionsA);
+    EXPECT_EQ(0u, positionsA.size());
+    EXPECT_TRUE(referenceA->isAffectedByRepack());
+    EXPECT_EQ(4u, atlas->getStats().evictedImages);
+
+    // The next upload repacks the atlas. Tiles that were laid out before keep using the texture
+    // of the previous generation.
+    atlas->upload(context, 0);
+    EXPECT_EQ(1u, atlas->getGeneration());
+    EXPECT_EQ(1u, atlas->getStats().repacks);
+    EXPECT_TRUE(atlas->hasTexture(0));
+    EXPECT_TRUE(atlas->hasTexture(1));
+    EXPECT_EQ(4u, atlas->getStats().images);
+
+    ImagePositions positionsB;
+    auto referenceB = atlas->addImages(makeImageMap({ wide }), positionsB);
+    EXPECT_EQ(1u, positionsB.size());
+    EXPECT_EQ(1u, referenceB->getGeneration());
+
+    // Once all tiles of the previous generation were laid out again, its texture is released.
+    references.clear();
+    referenceA.reset();
+    atlas->upload(context, 0);
+    EXPECT_FALSE(atlas->hasTexture(0));
+    EXPECT_TRUE(atlas->hasTexture(1));
+}
+
+TEST(SharedImageAtlas, Upload) {
+    HeadlessBackend backend { { 256, 256 } };
+    BackendScope scope { backend };
+    gl::Context context;
+
+    auto atlas = std::make_shared<SharedImageAtlas>();
+
+    ImagePositions positionsA;
+    auto referenceA = atlas->addImages(makeImageMap({ makeImage("a", { 14, 14 }) }), positionsA);
+
+    // The first upload transfers the entire texture.
+    atlas->upload(context, 0);
+    EXPECT_EQ(128u * 128u * 4u, atlas->getStats().uploadedBytes);
+    EXPECT_EQ((Size { 128, 128 }), atlas->bind(context, 0, gl::TextureFilter::Linear, 0));
+
+    // Only the regions of new icons are uploaded afterwards.
+    ImagePositions positionsB;
+    auto referenceB = atlas->addImages(makeImageMap({ makeImage("b", { 14, 14 }), makeImage("c", { 14, 14 }) }), positionsB);
+    atlas->upload(context, 0);
+    EXPECT_EQ(128u * 128u * 4u + 32u * 16u * 4u, atlas->getStats().uploadedBytes);
+}
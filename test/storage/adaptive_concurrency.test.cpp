@@ -0,0 +1,65 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/storage/adaptive_concurrency.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Completes `count` requests with the given latency, each taking `interval` longer than the
+// previous one, and returns the completion time of the last request.
+TimePoint complete(AdaptiveConcurrency& concurrency, TimePoint time, uint32_t count,
+                   Milliseconds latency, Milliseconds interval, bool saturated = true) {
+    for (uint32_t i = 0; i < count; i++) {
+        time += interval;
+        concurrency.addSample(latency, 1000, time, saturated);
+    }
+    return time;
+}
+
+} // namespace
+
+TEST(AdaptiveConcurrency, Clamped) {
+    EXPECT_EQ(4u, AdaptiveConcurrency(1, 4, 8).getLimit());
+    EXPECT_EQ(8u, AdaptiveConcurrency(20, 4, 8).getLimit());
+}
+
+TEST(AdaptiveConcurrency, GrowsWhileThroughputIncreases) {
+    AdaptiveConcurrency concurrency(8, 4, 64);
+    TimePoint time;
+
+    time = complete(concurrency, time, 8, Milliseconds(50), Milliseconds(10));
+    EXPECT_EQ(10u, concurrency.getLimit());
+
+    // Completing requests faster means a higher throughput.
+    time = complete(concurrency, time, 10, Milliseconds(50), Milliseconds(5));
+    EXPECT_EQ(12u, concurrency.getLimit());
+
+    // The throughput didn't increase, so there's no reason to raise the limit any further.
+    time = complete(concurrency, time, 12, Milliseconds(50), Milliseconds(6));
+    EXPECT_EQ(12u, concurrency.getLimit());
+
+    // The limit isn't raised when it isn't being reached.
+    complete(concurrency, time, 12, Milliseconds(50), Milliseconds(1), false);
+    EXPECT_EQ(12u, concurrency.getLimit());
+}
+
+TEST(AdaptiveConcurrency, ShrinksWhenLatencyIncreases) {
+    AdaptiveConcurrency concurrency(16, 4, 64);
+    TimePoint time;
+
+    time = complete(concurrency, time, 16, Milliseconds(50), Milliseconds(10));
+    EXPECT_EQ(20u, concurrency.getLimit());
+
+    time = complete(concurrency, time, 20, Milliseconds(150), Milliseconds(10));
+    EXPECT_EQ(15u, concurrency.getLimit());
+
+    time = complete(concurrency, time, 15, Milliseconds(150), Milliseconds(10));
+    EXPECT_EQ(11u, concurrency.getLimit());
+
+    // Never drops below the minimum.
+    for (int i = 0; i < 10; i++) {
+        time = complete(concurrency, time, 16, Milliseconds(500), Milliseconds(10));
+    }
+    EXPECT_EQ(4u, concurrency.getLimit());
+}
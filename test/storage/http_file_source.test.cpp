@@ -4,6 +4,8 @@
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <unordered_map>
+
 using namespace mbgl;
 
 TEST(HTTPFileSource, TEST_REQUIRES_SERVER(Cancel)) {
@@ -23,8 +25,8 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(HTTP200)) {
 
     auto req = fs.request({ Resource::Unknown, "http://127.0.0.1:3000/test" }, [&](Response res) {
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
-        EXPECT_EQ("Hello World!", *res.data);
+        ASSERT_TRUE(bool(res.data));
+        EXPECT_EQ("Hello World!", res.data.string());
         EXPECT_FALSE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
         EXPECT_FALSE(bool(res.modified));
@@ -79,7 +81,7 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(HTTP200EmptyData)) {
     auto req = fs.request({ Resource::Unknown, "http://127.0.0.1:3000/empty-data" }, [&](Response res) {
         EXPECT_FALSE(res.noContent);
         EXPECT_FALSE(bool(res.error));
-        EXPECT_EQ(*res.data, std::string());
+        EXPECT_EQ(res.data.string(), std::string());
         EXPECT_FALSE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
         EXPECT_FALSE(bool(res.modified));
@@ -134,8 +136,8 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(ExpiresParsing)) {
     auto req = fs.request({ Resource::Unknown,
                  "http://127.0.0.1:3000/test?modified=1420794326&expires=1420797926&etag=foo" }, [&](Response res) {
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
-        EXPECT_EQ("Hello World!", *res.data);
+        ASSERT_TRUE(bool(res.data));
+        EXPECT_EQ("Hello World!", res.data.string());
         EXPECT_EQ(Timestamp{ Seconds(1420797926) }, res.expires);
         EXPECT_FALSE(res.mustRevalidate);
         EXPECT_EQ(Timestamp{ Seconds(1420794326) }, res.modified);
@@ -152,8 +154,8 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(CacheControlParsing)) {
 
     auto req = fs.request({ Resource::Unknown, "http://127.0.0.1:3000/test?cachecontrol=max-age=120" }, [&](Response res) {
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
-        EXPECT_EQ("Hello World!", *res.data);
+        ASSERT_TRUE(bool(res.data));
+        EXPECT_EQ("Hello World!", res.data.string());
         EXPECT_GT(Seconds(2), util::abs(*res.expires - util::now() - Seconds(120))) << "Expiration date isn't about 120 seconds in the future";
         EXPECT_FALSE(res.mustRevalidate);
         EXPECT_FALSE(bool(res.modified));
@@ -181,8 +183,8 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(Load)) {
                    [&, i, current](Response res) {
             reqs[i].reset();
             EXPECT_EQ(nullptr, res.error);
-            ASSERT_TRUE(res.data.get());
-            EXPECT_EQ(std::string("Request ") +  std::to_string(current), *res.data);
+            ASSERT_TRUE(bool(res.data));
+            EXPECT_EQ(std::string("Request ") +  std::to_string(current), res.data.string());
             EXPECT_FALSE(bool(res.expires));
             EXPECT_FALSE(res.mustRevalidate);
             EXPECT_FALSE(bool(res.modified));
@@ -202,3 +204,71 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(Load)) {
 
     loop.run();
 }
+
+TEST(HTTPFileSource, TEST_REQUIRES_SERVER(MultiplexedLoad)) {
+    util::RunLoop loop;
+    HTTPFileSource fs;
+
+    // The server on this port speaks HTTP/2 to clients that send the HTTP/2 preface if its
+    // Node.js version supports HTTP/2, and HTTP/1.1 to all others.
+    bool serverSupportsHTTP2 = false;
+    std::unique_ptr<AsyncRequest> check = fs.request({ Resource::Unknown, "http://127.0.0.1:3001/supports-http2" },
+                                                     [&](Response res) {
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(bool(res.data));
+        serverSupportsHTTP2 = res.data.string() == "true";
+        loop.stop();
+    });
+    loop.run();
+
+    // Without HTTP/2, the multiplexed mode still adapts the concurrency of HTTP/1.1 requests.
+    fs.setConnectionMode(serverSupportsHTTP2 ? HTTPConnectionMode::MultiplexedPriorKnowledge
+                                             : HTTPConnectionMode::Multiplexed);
+
+    // Make sure that requests actually use HTTP/2 where both the platform and the server can.
+    if (serverSupportsHTTP2 && HTTPFileSource::supportsConnectionModes()) {
+        std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Unknown, "http://127.0.0.1:3001/http-version" },
+                                                       [&](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(bool(res.data));
+            EXPECT_EQ("2.0", res.data.string());
+            loop.stop();
+        });
+        loop.run();
+    }
+
+    const int max = 2000;
+    int number = 1;
+    int active = 0;
+
+    std::unordered_map<int, std::unique_ptr<AsyncRequest>> reqs;
+
+    std::function<void()> fill = [&] {
+        while (number <= max && active < int(fs.getConcurrencyLimit())) {
+            const auto current = number++;
+            active++;
+            reqs[current] = fs.request({ Resource::Unknown,
+                     std::string("http://127.0.0.1:3001/load/") + std::to_string(current) },
+                   [&, current](Response res) {
+                reqs.erase(current);
+                active--;
+                EXPECT_EQ(nullptr, res.error);
+                ASSERT_TRUE(bool(res.data));
+                EXPECT_EQ(std::string("Request ") + std::to_string(current), res.data.string());
+
+                EXPECT_LE(1u, fs.getConcurrencyLimit());
+                EXPECT_GE(64u, fs.getConcurrencyLimit());
+
+                if (number <= max) {
+                    fill();
+                } else if (active == 0) {
+                    loop.stop();
+                }
+            });
+        }
+    };
+
+    fill();
+
+    loop.run();
+}
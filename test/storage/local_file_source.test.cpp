@@ -1,4 +1,5 @@
 #include <mbgl/storage/local_file_source.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/run_loop.hpp>
 
@@ -8,10 +9,10 @@
 
 namespace {
 
-std::string toAbsoluteURL(const std::string& fileName) {
+std::string toAbsoluteURL(const std::string& fileName, const std::string& directory = "test/fixtures/storage/assets/") {
     char buff[PATH_MAX + 1];
     char* cwd = getcwd( buff, PATH_MAX + 1 );
-    std::string url = { "file://" + std::string(cwd) + "/test/fixtures/storage/assets/" + fileName };
+    std::string url = { "file://" + std::string(cwd) + "/" + directory + fileName };
     assert(url.size() <= PATH_MAX);
     return url;
 }
@@ -28,8 +29,8 @@ TEST(LocalFileSource, EmptyFile) {
     std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Unknown, toAbsoluteURL("empty") }, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
-        EXPECT_EQ("", *res.data);
+        ASSERT_TRUE(bool(res.data));
+        EXPECT_EQ("", res.data.string());
         loop.stop();
     });
 
@@ -44,8 +45,8 @@ TEST(LocalFileSource, NonEmptyFile) {
     std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Unknown, toAbsoluteURL("nonempty") }, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
-        EXPECT_EQ("content is here\n", *res.data);
+        ASSERT_TRUE(bool(res.data));
+        EXPECT_EQ("content is here\n", res.data.string());
         loop.stop();
     });
 
@@ -61,7 +62,7 @@ TEST(LocalFileSource, NonExistentFile) {
         req.reset();
         ASSERT_NE(nullptr, res.error);
         EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
-        ASSERT_FALSE(res.data.get());
+        ASSERT_FALSE(bool(res.data));
         // Do not assert on platform-specific error message.
         loop.stop();
     });
@@ -78,7 +79,7 @@ TEST(LocalFileSource, ReadDirectory) {
         req.reset();
         ASSERT_NE(nullptr, res.error);
         EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
-        ASSERT_FALSE(res.data.get());
+        ASSERT_FALSE(bool(res.data));
         // Do not assert on platform-specific error message.
         loop.stop();
     });
@@ -94,8 +95,8 @@ TEST(LocalFileSource, URLEncoding) {
     std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Unknown, toAbsoluteURL("%6eonempty") }, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
-        EXPECT_EQ("content is here\n", *res.data);
+        ASSERT_TRUE(bool(res.data));
+        EXPECT_EQ("content is here\n", res.data.string());
         loop.stop();
     });
 
@@ -116,9 +117,56 @@ TEST(LocalFileSource, URLLimit) {
         req.reset();
         ASSERT_NE(nullptr, res.error);
         EXPECT_EQ(Response::Error::Reason::Other, res.error->reason);
-        ASSERT_FALSE(res.data.get());
+        ASSERT_FALSE(bool(res.data));
         loop.stop();
     });
 
     loop.run();
 }
+
+TEST(LocalFileSource, LargeFile) {
+    util::RunLoop loop;
+
+    LocalFileSource fs;
+
+    const std::string path = "test/fixtures/resources/style_vector.json";
+    const std::string content = util::read_file(path);
+    const auto before = LocalFileSource::getMemoryUsage();
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Unknown, toAbsoluteURL("style_vector.json", "test/fixtures/resources/") }, [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(bool(res.data));
+        EXPECT_EQ(content, res.data.string());
+
+        // Large files are mapped rather than copied.
+        EXPECT_EQ(before.mapped + content.size(), LocalFileSource::getMemoryUsage().mapped);
+        EXPECT_EQ(before.allocated, LocalFileSource::getMemoryUsage().allocated);
+        loop.stop();
+    });
+
+    loop.run();
+
+    // The mapping is released along with the last reference to the data.
+    EXPECT_EQ(before.mapped, LocalFileSource::getMemoryUsage().mapped);
+}
+
+TEST(LocalFileSource, MemoryUsage) {
+    util::RunLoop loop;
+
+    LocalFileSource fs;
+
+    const auto before = LocalFileSource::getMemoryUsage();
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Unknown, toAbsoluteURL("nonempty") }, [&](Response res) {
+        req.reset();
+        ASSERT_TRUE(bool(res.data));
+        EXPECT_EQ(before.allocated + res.data.size(), LocalFileSource::getMemoryUsage().allocated);
+        EXPECT_EQ(before.mapped, LocalFileSource::getMemoryUsage().mapped);
+        loop.stop();
+    });
+
+    loop.run();
+
+    EXPECT_EQ(before.allocated, LocalFileSource::getMemoryUsage().allocated);
+}
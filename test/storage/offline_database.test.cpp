@@ -173,7 +173,7 @@ TEST(OfflineDatabase, PutResource) {
 
     auto insertGetResult = db.get(resource);
     EXPECT_EQ(nullptr, insertGetResult->error.get());
-    EXPECT_EQ("first", *insertGetResult->data);
+    EXPECT_EQ("first", insertGetResult->data.string());
 
     response.data = std::make_shared<std::string>("second");
     auto updatePutResult = db.put(resource, response);
@@ -182,7 +182,7 @@ TEST(OfflineDatabase, PutResource) {
 
     auto updateGetResult = db.get(resource);
     EXPECT_EQ(nullptr, updateGetResult->error.get());
-    EXPECT_EQ("second", *updateGetResult->data);
+    EXPECT_EQ("second", updateGetResult->data.string());
 }
 
 TEST(OfflineDatabase, PutTile) {
@@ -207,7 +207,7 @@ TEST(OfflineDatabase, PutTile) {
 
     auto insertGetResult = db.get(resource);
     EXPECT_EQ(nullptr, insertGetResult->error.get());
-    EXPECT_EQ("first", *insertGetResult->data);
+    EXPECT_EQ("first", insertGetResult->data.string());
 
     response.data = std::make_shared<std::string>("second");
     auto updatePutResult = db.put(resource, response);
@@ -216,7 +216,7 @@ TEST(OfflineDatabase, PutTile) {
 
     auto updateGetResult = db.get(resource);
     EXPECT_EQ(nullptr, updateGetResult->error.get());
-    EXPECT_EQ("second", *updateGetResult->data);
+    EXPECT_EQ("second", updateGetResult->data.string());
 }
 
 TEST(OfflineDatabase, PutResourceNoContent) {
@@ -232,7 +232,7 @@ TEST(OfflineDatabase, PutResourceNoContent) {
     auto res = db.get(resource);
     EXPECT_EQ(nullptr, res->error);
     EXPECT_TRUE(res->noContent);
-    EXPECT_FALSE(res->data.get());
+    EXPECT_FALSE(bool(res->data));
 }
 
 TEST(OfflineDatabase, PutTileNotFound) {
@@ -255,7 +255,7 @@ TEST(OfflineDatabase, PutTileNotFound) {
     auto res = db.get(resource);
     EXPECT_EQ(nullptr, res->error);
     EXPECT_TRUE(res->noContent);
-    EXPECT_FALSE(res->data.get());
+    EXPECT_FALSE(bool(res->data));
 }
 
 TEST(OfflineDatabase, CreateRegion) {
@@ -51,8 +51,8 @@ public:
     Response response(const std::string& path) {
         Response result;
         result.data = std::make_shared<std::string>(util::read_file("test/fixtures/offline_download/"s + path));
-        size_t uncompressed = result.data->size();
-        size_t compressed = util::compress(*result.data).size();
+        size_t uncompressed = result.data.size();
+        size_t compressed = util::compress(result.data.string()).size();
         size += std::min(uncompressed, compressed);
         return result;
     }
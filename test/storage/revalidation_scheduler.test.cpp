@@ -0,0 +1,155 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_file_source.hpp>
+
+#include <mbgl/storage/revalidation_scheduler.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/timer.hpp>
+
+#include <set>
+
+using namespace mbgl;
+
+namespace {
+
+RevalidationPolicy stalePolicy(uint32_t maximumConcurrentRevalidations = 4) {
+    RevalidationPolicy policy;
+    policy.maximumStaleness = Seconds(3600);
+    policy.maximumConcurrentRevalidations = maximumConcurrentRevalidations;
+    return policy;
+}
+
+} // namespace
+
+TEST(RevalidationScheduler, AcceptsStale) {
+    util::RunLoop loop;
+    StubFileSource fileSource;
+    RevalidationScheduler scheduler(fileSource);
+
+    const Timestamp now = util::now();
+
+    // Disabled by default.
+    EXPECT_FALSE(scheduler.acceptsStale(now - Seconds(10)));
+
+    scheduler.setPolicy(stalePolicy());
+    EXPECT_TRUE(scheduler.acceptsStale(now - Seconds(10)));
+    EXPECT_FALSE(scheduler.acceptsStale(now - Seconds(7200)));
+    EXPECT_FALSE(scheduler.acceptsStale(now + Seconds(10)));
+    EXPECT_FALSE(scheduler.acceptsStale({}));
+}
+
+TEST(RevalidationScheduler, BoundedConcurrency) {
+    util::RunLoop loop;
+    StubFileSource fileSource;
+    RevalidationScheduler scheduler(fileSource);
+    scheduler.setPolicy(stalePolicy(2));
+
+    std::set<std::string> requested;
+    bool respond = false;
+    fileSource.response = [&] (const Resource& resource) -> optional<Response> {
+        requested.insert(resource.url);
+        if (!respond) {
+            return {};
+        }
+        Response response;
+        response.data = std::make_shared<std::string>(resource.url);
+        return response;
+    };
+
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    size_t completed = 0;
+    for (int i = 0; i < 5; i++) {
+        requests.push_back(scheduler.revalidate({ Resource::Unknown, "resource" + util::toString(i) }, [&] (Response) {
+            if (++completed == 5) {
+                loop.stop();
+            }
+        }));
+    }
+
+    util::Timer timer;
+    timer.start(Milliseconds(10), Duration::zero(), [&] {
+        // Only the first two revalidations were passed on.
+        EXPECT_EQ((std::set<std::string>{ "resource0", "resource1" }), requested);
+        respond = true;
+    });
+
+    loop.run();
+
+    EXPECT_EQ(5u, requested.size());
+}
+
+TEST(RevalidationScheduler, CancelStartsQueued) {
+    util::RunLoop loop;
+    StubFileSource fileSource;
+    RevalidationScheduler scheduler(fileSource);
+    scheduler.setPolicy(stalePolicy(1));
+
+    std::set<std::string> requested;
+    fileSource.response = [&] (const Resource& resource) -> optional<Response> {
+        requested.insert(resource.url);
+        if (resource.url == "resource1") {
+            loop.stop();
+        }
+        return {};
+    };
+
+    auto first = scheduler.revalidate({ Resource::Unknown, "resource0" }, [] (Response) {});
+    auto second = scheduler.revalidate({ Resource::Unknown, "resource1" }, [] (Response) {});
+
+    util::Timer timer;
+    timer.start(Milliseconds(10), Duration::zero(), [&] {
+        EXPECT_EQ((std::set<std::string>{ "resource0" }), requested);
+        // Cancelling the active revalidation makes room for the queued one.
+        first.reset();
+    });
+
+    loop.run();
+
+    EXPECT_EQ((std::set<std::string>{ "resource0", "resource1" }), requested);
+}
+
+TEST(RevalidationScheduler, CoalesceZoomLevels) {
+    util::RunLoop loop;
+    StubFileSource fileSource;
+    RevalidationScheduler scheduler(fileSource);
+    scheduler.setPolicy(stalePolicy(1));
+
+    const Timestamp expires = util::now() + Seconds(3600);
+
+    std::set<std::string> revalidated;
+    fileSource.tileResponse = [&] (const Resource& resource) -> optional<Response> {
+        if (resource.priorExpires && *resource.priorExpires > util::now()) {
+            // Not expired; a network request wouldn't be made before it expires.
+            return {};
+        }
+        revalidated.insert(resource.url);
+        Response response;
+        response.notModified = true;
+        response.expires = expires;
+        return response;
+    };
+
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    size_t completed = 0;
+    auto revalidate = [&] (int32_t x, int8_t z) {
+        Resource resource = Resource::tile("http://example.com/{z}/{x}/{y}.pbf", 1.0, x, 0, z, Tileset::Scheme::XYZ);
+        resource.priorExpires = util::now() - Seconds(10);
+        requests.push_back(scheduler.revalidate(resource, [&] (Response res) {
+            EXPECT_TRUE(res.notModified);
+            EXPECT_EQ(expires, res.expires);
+            if (++completed == 4) {
+                loop.stop();
+            }
+        }));
+    };
+
+    revalidate(0, 2);
+    revalidate(1, 2);
+    revalidate(2, 2);
+    revalidate(0, 3);
+
+    loop.run();
+
+    // Only one tile per zoom level was revalidated over the network.
+    EXPECT_EQ((std::set<std::string>{ "http://example.com/2/0/0.pbf", "http://example.com/3/0/0.pbf" }), revalidated);
+}
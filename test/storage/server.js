@@ -169,7 +169,60 @@ app.get('/load/:number(\\d+)', function(req, res) {
     res.send('Request ' + req.params.number);
 });
 
-var server = app.listen(3000, function () {
-    // Tell parent that we're now listening.
-    process.stdout.write("OK");
+// Serves the multiplexing tests on a separate port. Connections that start with the HTTP/2
+// connection preface are forwarded to an HTTP/2 server, all others to an HTTP/1.1 server, so that
+// clients can talk HTTP/2 without negotiating it first. Without an HTTP/2 server, all connections
+// are served over HTTP/1.1; /supports-http2 tells clients which is the case.
+function multiplexedHandler(req, res) {
+    var load = req.url.match(/^\/load\/(\d+)$/);
+    if (load) {
+        res.end('Request ' + load[1]);
+    } else if (req.url === '/http-version') {
+        res.end(req.httpVersion);
+    } else if (req.url === '/supports-http2') {
+        res.end(http2Server ? 'true' : 'false');
+    } else {
+        res.statusCode = 404;
+        res.end('Not Found!');
+    }
+}
+
+var net = require('net');
+var http1Server = require('http').createServer(multiplexedHandler);
+var http2Server;
+try {
+    http2Server = require('http2').createServer(multiplexedHandler);
+} catch (e) {
+    // HTTP/2 requires Node.js 8.4 or later.
+}
+
+var preface = 'PRI * HTTP/2.0';
+var multiplexedServer = net.createServer(function(socket) {
+    socket.once('data', function(chunk) {
+        var isHTTP2 = http2Server && chunk.toString('latin1', 0, preface.length) === preface;
+        var upstream = net.connect((isHTTP2 ? http2Server : http1Server).address().port, '127.0.0.1');
+        upstream.write(chunk);
+        socket.pipe(upstream).pipe(socket);
+        socket.on('error', function() { upstream.destroy(); });
+        upstream.on('error', function() { socket.destroy(); });
+    });
+});
+
+var servers = [
+    [ app, 3000 ],
+    [ multiplexedServer, 3001 ],
+    [ http1Server, 0 ],
+];
+if (http2Server) {
+    servers.push([ http2Server, 0 ]);
+}
+
+var listening = 0;
+servers.forEach(function(server) {
+    server[0].listen(server[1], function() {
+        if (++listening === servers.length) {
+            // Tell parent that we're now listening.
+            process.stdout.write("OK");
+        }
+    });
 });
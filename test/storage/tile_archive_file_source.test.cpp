@@ -0,0 +1,135 @@
+#include <mbgl/storage/tile_archive_file_source.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <unistd.h>
+#include <climits>
+#include <gtest/gtest.h>
+
+namespace {
+
+std::string toAbsoluteURL(const std::string& fileName) {
+    char buff[PATH_MAX + 1];
+    char* cwd = getcwd( buff, PATH_MAX + 1 );
+    return { "pmtiles://" + std::string(cwd) + "/test/fixtures/storage/" + fileName };
+}
+
+mbgl::Resource tile(const std::string& fileName, int8_t z, int32_t x, int32_t y) {
+    return mbgl::Resource::tile(toAbsoluteURL(fileName), 1.0, x, y, z, mbgl::Tileset::Scheme::XYZ);
+}
+
+} // namespace
+
+using namespace mbgl;
+
+TEST(TileArchiveFileSource, AcceptsURL) {
+    EXPECT_TRUE(TileArchiveFileSource::acceptsURL("pmtiles:///data/archive.pmtiles"));
+    EXPECT_FALSE(TileArchiveFileSource::acceptsURL("file:///data/archive.pmtiles"));
+    EXPECT_FALSE(TileArchiveFileSource::acceptsURL("http://example.com/archive.pmtiles"));
+}
+
+TEST(TileArchiveFileSource, Tile) {
+    util::RunLoop loop;
+
+    TileArchiveFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request(tile("archive.pmtiles", 0, 0, 0), [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(bool(res.data));
+        EXPECT_EQ("tile 0/0/0", res.data.string());
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(TileArchiveFileSource, LeafDirectory) {
+    util::RunLoop loop;
+
+    TileArchiveFileSource fs;
+
+    // Tiles 1/0/0 and 1/0/1 share a single run-length encoded entry in a leaf directory.
+    std::unique_ptr<AsyncRequest> req1 = fs.request(tile("archive.pmtiles", 1, 0, 1), [&](Response res) {
+        req1.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(bool(res.data));
+        EXPECT_EQ("tile 1/run", res.data.string());
+    });
+
+    std::unique_ptr<AsyncRequest> req2 = fs.request(tile("archive.pmtiles", 1, 1, 1), [&](Response res) {
+        req2.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(bool(res.data));
+        EXPECT_EQ("tile 1/1/1", res.data.string());
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(TileArchiveFileSource, MissingTile) {
+    util::RunLoop loop;
+
+    TileArchiveFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request(tile("archive.pmtiles", 1, 1, 0), [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        EXPECT_TRUE(res.noContent);
+        EXPECT_FALSE(bool(res.data));
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(TileArchiveFileSource, TileJSON) {
+    util::RunLoop loop;
+
+    TileArchiveFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request(Resource::source(toAbsoluteURL("archive.pmtiles")), [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(bool(res.data));
+        const std::string json = res.data.string();
+        EXPECT_NE(std::string::npos, json.find("\"tiles\":[\"" + toAbsoluteURL("archive.pmtiles") + "\"]"));
+        EXPECT_NE(std::string::npos, json.find("\"minzoom\":0"));
+        EXPECT_NE(std::string::npos, json.find("\"maxzoom\":1"));
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(TileArchiveFileSource, NonExistentArchive) {
+    util::RunLoop loop;
+
+    TileArchiveFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request(tile("does_not_exist.pmtiles", 0, 0, 0), [&](Response res) {
+        req.reset();
+        ASSERT_NE(nullptr, res.error);
+        EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
+        ASSERT_FALSE(bool(res.data));
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(TileArchiveFileSource, InvalidArchive) {
+    util::RunLoop loop;
+
+    TileArchiveFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request(tile("assets/nonempty", 0, 0, 0), [&](Response res) {
+        req.reset();
+        ASSERT_NE(nullptr, res.error);
+        EXPECT_EQ(Response::Error::Reason::Other, res.error->reason);
+        ASSERT_FALSE(bool(res.data));
+        loop.stop();
+    });
+
+    loop.run();
+}
@@ -14,6 +14,15 @@ TEST(GeoJSONOptions, Basic) {
     ASSERT_TRUE((bool) converted);
 }
 
+TEST(GeoJSONOptions, BufferWithLength) {
+    // Only the given number of bytes is parsed, so the buffer doesn't need to end after the JSON.
+    const std::string json = R"JSON({ "maxzoom": 5 }, "trailing": true)JSON";
+    Error error;
+    mbgl::optional<GeoJSONOptions> converted = convertJSON<GeoJSONOptions>(json.data(), 16, error);
+    ASSERT_TRUE((bool) converted);
+    EXPECT_EQ(5, converted->maxzoom);
+}
+
 TEST(GeoJSONOptions, ErrorHandling) {
     Error error;
     mbgl::optional<GeoJSONOptions> converted = convertJSON<GeoJSONOptions>(R"JSON({
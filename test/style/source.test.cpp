@@ -8,9 +8,11 @@
 #include <mbgl/style/sources/raster_source.hpp>
 #include <mbgl/style/sources/vector_source.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/style/sources/image_source.hpp>
 #include <mbgl/style/layers/raster_layer.cpp>
 #include <mbgl/style/layers/line_layer.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
 
 #include <mbgl/renderer/sources/render_raster_source.hpp>
 #include <mbgl/renderer/sources/render_vector_source.hpp>
@@ -52,7 +54,7 @@ public:
     Style style { loop, fileSource, 1 };
     AnnotationManager annotationManager { style };
     ImageManager imageManager;
-    GlyphManager glyphManager { fileSource };
+    GlyphManager glyphManager { fileSource, threadPool };
 
     TileParameters tileParameters {
         1.0,
@@ -513,6 +515,138 @@ TEST(Source, GeoJSonSourceUrlUpdate) {
     test.run();
 }
 
+TEST(Source, GeoJSONSourceIndexesInBackground) {
+    SourceTest test;
+
+    CircleLayer layer("id", "source");
+    std::vector<Immutable<Layer::Impl>> layers {{ layer.baseImpl }};
+
+    GeoJSONSource source("source");
+    source.setGeoJSON({ Point<double> { 1.1, 1.1 } });
+
+    test.renderSourceObserver.tileChanged = [&] (RenderSource& source_, const OverscaledTileID& tileID) {
+        EXPECT_EQ("source", source_.baseImpl->id);
+        EXPECT_EQ(OverscaledTileID(0, 0, 0), tileID);
+        test.end();
+    };
+
+    auto renderSource = RenderSource::create(source.baseImpl);
+    renderSource->setObserver(&test.renderSourceObserver);
+    renderSource->update(source.baseImpl, layers, true, true, test.tileParameters);
+
+    // The data is indexed and the tile is sliced on a worker thread.
+    EXPECT_FALSE(renderSource->isLoaded());
+    EXPECT_TRUE(renderSource->getRenderTiles().empty());
+    test.run();
+
+    source.setGeoJSON({ Point<double> { -1.1, -1.1 } });
+    renderSource->update(source.baseImpl, layers, true, true, test.tileParameters);
+
+    // Until the features of the new data arrive, the tile keeps rendering the previous ones.
+    EXPECT_FALSE(renderSource->isLoaded());
+    EXPECT_EQ(1u, renderSource->getRenderTiles().size());
+    auto features = renderSource->querySourceFeatures({});
+    ASSERT_EQ(1u, features.size());
+    EXPECT_GT(features[0].geometry.get<Point<double>>().x, 1);
+    test.run();
+
+    features = renderSource->querySourceFeatures({});
+    ASSERT_EQ(1u, features.size());
+    EXPECT_LT(features[0].geometry.get<Point<double>>().x, -1);
+}
+
+TEST(Source, GeoJSONSourceUpdateFeatures) {
+    SourceTest test;
+
+    CircleLayer layer("id", "source");
+    std::vector<Immutable<Layer::Impl>> layers {{ layer.baseImpl }};
+
+    Feature first { Point<double> { 1.1, 1.1 } };
+    first.id = uint64_t(1);
+    Feature second { Point<double> { 100, 40 } };
+    second.id = uint64_t(2);
+
+    GeoJSONSource source("source");
+    source.setGeoJSON(FeatureCollection { first, second });
+
+    test.renderSourceObserver.tileChanged = [&] (RenderSource&, const OverscaledTileID&) {
+        test.end();
+    };
+
+    auto renderSource = RenderSource::create(source.baseImpl);
+    renderSource->setObserver(&test.renderSourceObserver);
+    renderSource->update(source.baseImpl, layers, true, true, test.tileParameters);
+    test.run();
+    EXPECT_EQ(2u, renderSource->querySourceFeatures({}).size());
+
+    Feature moved { Point<double> { -120, -30 } };
+    moved.id = uint64_t(1);
+    source.updateFeatures({ moved });
+
+    // Only tiles that contain the previous or the new version of the feature are affected.
+    auto changes = source.impl().getChanges();
+    ASSERT_TRUE(bool(changes));
+    EXPECT_TRUE(changes->affects(CanonicalTileID(2, 2, 1), 0));
+    EXPECT_TRUE(changes->affects(CanonicalTileID(2, 0, 2), 0));
+    EXPECT_FALSE(changes->affects(CanonicalTileID(2, 3, 1), 0));
+
+    renderSource->update(source.baseImpl, layers, true, true, test.tileParameters);
+    test.run();
+
+    auto features = renderSource->querySourceFeatures({});
+    ASSERT_EQ(2u, features.size());
+    for (const auto& feature : features) {
+        if (feature.id == FeatureIdentifier(uint64_t(1))) {
+            EXPECT_LT(feature.geometry.get<Point<double>>().x, -119);
+        }
+    }
+
+    source.removeFeatures({ uint64_t(2) });
+    renderSource->update(source.baseImpl, layers, true, true, test.tileParameters);
+    test.run();
+
+    features = renderSource->querySourceFeatures({});
+    ASSERT_EQ(1u, features.size());
+    EXPECT_EQ(FeatureIdentifier(uint64_t(1)), features[0].id);
+}
+
+TEST(Source, GeoJSONSourceUpdateClusteredFeatures) {
+    SourceTest test;
+
+    CircleLayer layer("id", "source");
+    std::vector<Immutable<Layer::Impl>> layers {{ layer.baseImpl }};
+
+    Feature first { Point<double> { 1.1, 1.1 } };
+    first.id = uint64_t(1);
+    Feature second { Point<double> { 100, 40 } };
+    second.id = uint64_t(2);
+
+    GeoJSONOptions options;
+    options.cluster = true;
+    GeoJSONSource source("source", options);
+    source.setGeoJSON(FeatureCollection { first, second });
+
+    test.renderSourceObserver.tileChanged = [&] (RenderSource&, const OverscaledTileID&) {
+        test.end();
+    };
+
+    auto renderSource = RenderSource::create(source.baseImpl);
+    renderSource->setObserver(&test.renderSourceObserver);
+    renderSource->update(source.baseImpl, layers, true, true, test.tileParameters);
+    test.run();
+    EXPECT_EQ(2u, renderSource->querySourceFeatures({}).size());
+
+    // The changes are merged into the data on the worker thread, not when they are made.
+    auto geoJSON = source.impl().getGeoJSON();
+    source.removeFeatures({ uint64_t(2) });
+    EXPECT_EQ(geoJSON, source.impl().getGeoJSON());
+    EXPECT_TRUE(bool(source.impl().getChanges()));
+
+    renderSource->update(source.baseImpl, layers, true, true, test.tileParameters);
+    test.run();
+    EXPECT_EQ(1u, renderSource->querySourceFeatures({}).size());
+}
+
 TEST(Source, ImageSourceImageUpdate) {
     SourceTest test;
 
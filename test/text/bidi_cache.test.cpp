@@ -0,0 +1,59 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/bidi_cache.hpp>
+#include <mbgl/util/utf.hpp>
+
+using namespace mbgl;
+
+TEST(BiDiCache, ArabicShaping) {
+    BiDiCache cache;
+    const std::u16string text = util::utf8_to_utf16::convert("شارع الملك فيصل");
+
+    EXPECT_EQ(applyArabicShaping(text), cache.applyArabicShaping(text));
+    EXPECT_EQ(applyArabicShaping(text), cache.applyArabicShaping(text));
+
+    const BiDiCache::Stats stats = cache.getStats();
+    EXPECT_EQ(1u, stats.entries);
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+}
+
+TEST(BiDiCache, ProcessText) {
+    BiDiCache cache;
+    BiDi bidi;
+    const std::u16string text = applyArabicShaping(util::utf8_to_utf16::convert("Main St רחוב הרצל"));
+
+    const std::vector<std::u16string> expected = bidi.processText(text, { 8 });
+    EXPECT_EQ(expected, cache.processText(bidi, text, { 8 }));
+    EXPECT_EQ(expected, cache.processText(bidi, text, { 8 }));
+
+    // The same text with other line breaks, and the Arabic shaping of the same text, are cached
+    // separately.
+    EXPECT_EQ(bidi.processText(text, {}), cache.processText(bidi, text, {}));
+    cache.applyArabicShaping(text);
+
+    const BiDiCache::Stats stats = cache.getStats();
+    EXPECT_EQ(3u, stats.entries);
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(3u, stats.misses);
+}
+
+TEST(BiDiCache, Eviction) {
+    BiDiCache cache(2);
+
+    cache.applyArabicShaping(u"a");
+    cache.applyArabicShaping(u"b");
+    cache.applyArabicShaping(u"a");
+    cache.applyArabicShaping(u"c");
+
+    // "b" was the least recently used result.
+    cache.applyArabicShaping(u"a");
+    cache.applyArabicShaping(u"b");
+
+    const BiDiCache::Stats stats = cache.getStats();
+    EXPECT_EQ(2u, stats.entries);
+    EXPECT_EQ(2u, stats.hits);
+    EXPECT_EQ(4u, stats.misses);
+    EXPECT_EQ(2u, stats.evictions);
+}
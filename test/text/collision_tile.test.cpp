@@ -0,0 +1,103 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+struct Label {
+    float x;
+    float y;
+    float width;
+    float height;
+    bool allowOverlap;
+    bool ignorePlacement;
+};
+
+std::vector<Label> randomLabels(std::size_t count) {
+    std::minstd_rand random(7);
+    std::uniform_real_distribution<float> position(-256.0f, util::EXTENT + 256.0f);
+    std::uniform_real_distribution<float> size(50.0f, 800.0f);
+    std::bernoulli_distribution rarely(0.05);
+
+    std::vector<Label> labels;
+    for (std::size_t i = 0; i < count; ++i) {
+        labels.push_back({ position(random), position(random), size(random), size(random) / 4,
+                           rarely(random), rarely(random) });
+    }
+    return labels;
+}
+
+std::vector<float> place(CollisionTile& collisionTile, const std::vector<Label>& labels) {
+    std::vector<float> scales;
+    for (std::size_t i = 0; i < labels.size(); ++i) {
+        const Label& label = labels[i];
+        const Anchor anchor(label.x, label.y, 0, 0.5f);
+        CollisionFeature feature({}, anchor, -label.height / 2, label.height / 2,
+                                 -label.width / 2, label.width / 2, 1, 0,
+                                 style::SymbolPlacementType::Point,
+                                 IndexedSubfeature { i, "layer", "bucket", i },
+                                 CollisionFeature::AlignmentType::Straight);
+
+        const float scale = collisionTile.placeFeature(feature, label.allowOverlap, false);
+        scales.push_back(scale < collisionTile.maxScale ? scale : collisionTile.maxScale);
+        collisionTile.insertFeature(feature, scale, label.ignorePlacement);
+    }
+    return scales;
+}
+
+} // namespace
+
+TEST(CollisionTile, GridMatchesRTree) {
+    const std::vector<Label> labels = randomLabels(1000);
+
+    for (const float angle : { 0.0f, 0.3f, float(M_PI) / 2, 2.5f }) {
+        CollisionTile rtree(PlacementConfig(angle, 0, 0, 0, false, CollisionIndexType::RTree));
+        CollisionTile grid(PlacementConfig(angle, 0, 0, 0, false, CollisionIndexType::Grid));
+
+        // Both indexes find the same collisions, so labels are placed at the same scales.
+        EXPECT_EQ(place(rtree, labels), place(grid, labels));
+
+        const GeometryCoordinates query {
+            { 1000, 1000 }, { 5000, 1000 }, { 5000, 3000 }, { 1000, 3000 }, { 1000, 1000 }
+        };
+        auto byIndex = [] (const IndexedSubfeature& a, const IndexedSubfeature& b) {
+            return a.index < b.index;
+        };
+
+        // Boxes grow and shrink around their anchors as the scale changes, so the grid must find
+        // the same symbols at every scale, not only at the one they were indexed at.
+        for (const float scale : { 1.0f, 1.5f, 1.9f }) {
+            std::vector<IndexedSubfeature> rtreeResult = rtree.queryRenderedSymbols(query, scale);
+            std::vector<IndexedSubfeature> gridResult = grid.queryRenderedSymbols(query, scale);
+            std::sort(rtreeResult.begin(), rtreeResult.end(), byIndex);
+            std::sort(gridResult.begin(), gridResult.end(), byIndex);
+
+            ASSERT_FALSE(gridResult.empty());
+            ASSERT_EQ(rtreeResult.size(), gridResult.size());
+            for (std::size_t i = 0; i < rtreeResult.size(); ++i) {
+                EXPECT_EQ(rtreeResult[i].index, gridResult[i].index);
+            }
+        }
+    }
+}
+
+TEST(CollisionTile, GridOutsideBounds) {
+    CollisionTile collisionTile(PlacementConfig(0, 0, 0, 0, false, CollisionIndexType::Grid));
+
+    // Labels far outside of the grid bounds are kept in its border cells, and only collide with
+    // labels they actually overlap.
+    const std::vector<Label> labels {
+        { -20000, -20000, 100, 100, false, false },
+        { -20050, -20050, 100, 100, false, false },
+        { -30000, -20000, 100, 100, false, false },
+    };
+    const std::vector<float> scales = place(collisionTile, labels);
+    EXPECT_FLOAT_EQ(collisionTile.minScale, scales[0]);
+    EXPECT_FLOAT_EQ(collisionTile.maxScale, scales[1]);
+    EXPECT_FLOAT_EQ(collisionTile.minScale, scales[2]);
+}
@@ -2,8 +2,12 @@
 #include <mbgl/test/stub_file_source.hpp>
 
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/text/local_glyph_rasterizer.hpp>
+#include <mbgl/util/i18n.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/string.hpp>
+#include <mbgl/util/timer.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -38,7 +42,8 @@ public:
     StubFileSource fileSource;
     StubGlyphManagerObserver observer;
     StubGlyphRequestor requestor;
-    GlyphManager glyphManager { fileSource };
+    ThreadPool threadPool { 1 };
+    GlyphManager glyphManager { fileSource, threadPool };
 
     void run(const std::string& url, GlyphDependencies dependencies) {
         // Squelch logging.
@@ -222,7 +227,8 @@ TEST(GlyphManager, ImmediateFileSource) {
         StubFileSource fileSource = { StubFileSource::ResponseType::Synchronous };
         StubGlyphManagerObserver observer;
         StubGlyphRequestor requestor;
-        GlyphManager glyphManager { fileSource };
+        ThreadPool threadPool { 1 };
+        GlyphManager glyphManager { fileSource, threadPool };
 
         void run(const std::string& url, GlyphDependencies dependencies) {
             // Squelch logging.
@@ -263,3 +269,174 @@ TEST(GlyphManager, ImmediateFileSource) {
             {{{"Test Stack"}}, {u'a', u'å', u' '}}
         });
 }
+
+TEST(GlyphManager, ParsesOnWorker) {
+    util::RunLoop loop;
+    StubFileSource fileSource = { StubFileSource::ResponseType::Synchronous };
+    ThreadPool threadPool { 1 };
+    GlyphManager glyphManager { fileSource, threadPool };
+    StubGlyphRequestor first;
+    StubGlyphRequestor second;
+
+    fileSource.glyphsResponse = [&] (const Resource&) {
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    std::size_t notified = 0;
+    first.glyphsAvailable = [&] (GlyphMap glyphs) {
+        EXPECT_EQ(2u, glyphs.at({{"Test Stack"}}).size());
+        if (++notified == 2) {
+            loop.stop();
+        }
+    };
+
+    second.glyphsAvailable = [&] (GlyphMap glyphs) {
+        EXPECT_EQ(1u, glyphs.at({{"Test Stack"}}).size());
+        if (++notified == 2) {
+            loop.stop();
+        }
+    };
+
+    glyphManager.setURL("test/fixtures/resources/glyphs.pbf");
+
+    // The response arrives synchronously, but the range is parsed on the worker, so the requestor
+    // is notified asynchronously.
+    glyphManager.getGlyphs(first, GlyphDependencies { {{{"Test Stack"}}, {u'a', u'å'}} });
+    EXPECT_EQ(0u, notified);
+
+    // A requestor for a range that is still being parsed waits for it.
+    glyphManager.getGlyphs(second, GlyphDependencies { {{{"Test Stack"}}, {u' '}} });
+
+    loop.run();
+}
+
+class StubLocalGlyphRasterizer : public LocalGlyphRasterizer {
+public:
+    bool canRasterizeGlyph(const FontStack&, GlyphID glyphID) const override {
+        return util::i18n::isIdeograph(glyphID);
+    }
+
+    // Draws every glyph as a filled square.
+    Glyph rasterizeGlyph(const FontStack&, GlyphID) override {
+        Glyph glyph;
+        glyph.bitmap = AlphaImage({ 20, 20 });
+        glyph.bitmap.fill(255);
+        glyph.metrics = { 20, 20, 0, -8, 24 };
+        return glyph;
+    }
+};
+
+TEST(GlyphManager, LocalGlyphRasterizer) {
+    util::RunLoop loop;
+    StubFileSource fileSource;
+    ThreadPool threadPool { 1 };
+    GlyphManager glyphManager { fileSource, threadPool };
+    StubGlyphRequestor requestor;
+
+    glyphManager.setLocalGlyphRasterizer(std::make_shared<StubLocalGlyphRasterizer>());
+    glyphManager.setURL("test/fixtures/resources/glyphs.pbf");
+
+    std::size_t requests = 0;
+    fileSource.glyphsResponse = [&] (const Resource&) {
+        requests++;
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    requestor.glyphsAvailable = [&] (GlyphMap glyphs) {
+        const auto& stack = glyphs.at({{"Test Stack"}});
+        ASSERT_EQ(3u, stack.size());
+
+        // Ideographs are drawn locally and turned into signed distance fields with a border.
+        for (const GlyphID id : { u'中', u'文' }) {
+            ASSERT_TRUE(bool(stack.at(id)));
+            const Glyph& glyph = **stack.at(id);
+            EXPECT_EQ(id, glyph.id);
+            EXPECT_EQ(Size(20 + 2 * Glyph::borderSize, 20 + 2 * Glyph::borderSize), glyph.bitmap.size);
+            EXPECT_EQ(20u, glyph.metrics.width);
+            EXPECT_EQ(24u, glyph.metrics.advance);
+        }
+
+        // Other glyphs are still downloaded.
+        ASSERT_TRUE(bool(stack.at(u'a')));
+
+        loop.stop();
+    };
+
+    glyphManager.getGlyphs(requestor, GlyphDependencies { {{{"Test Stack"}}, {u'a', u'中', u'文'}} });
+
+    loop.run();
+
+    // Only the range of the Latin glyph was requested.
+    EXPECT_EQ(1u, requests);
+}
+
+TEST(GlyphManager, Prefetch) {
+    GlyphManagerTest test;
+
+    std::size_t requests = 0;
+    test.fileSource.glyphsResponse = [&] (const Resource&) {
+        requests++;
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    test.requestor.glyphsAvailable = [&] (GlyphMap glyphs) {
+        ASSERT_TRUE(bool(glyphs.at({{"Test Stack"}}).at(u'a')));
+        test.end();
+    };
+
+    test.glyphManager.setURL("test/fixtures/resources/glyphs.pbf");
+    test.glyphManager.prefetchGlyphs({ { {{"Test Stack"}}, { { 0, 255 } } } });
+
+    // Requestors for a prefetched range wait for the outstanding request.
+    test.run("test/fixtures/resources/glyphs.pbf", GlyphDependencies { {{{"Test Stack"}}, {u'a'}} });
+
+    EXPECT_EQ(1u, requests);
+}
+
+TEST(GlyphManager, PrefetchFail) {
+    GlyphManagerTest test;
+
+    std::size_t requests = 0;
+    test.fileSource.glyphsResponse = [&] (const Resource&) {
+        Response response;
+        if (requests++ == 0) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other,
+                "Failed by the test case");
+        } else {
+            response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        }
+        return response;
+    };
+
+    test.observer.glyphsError = [&] (const FontStack&, const GlyphRange&, std::exception_ptr) {
+        FAIL();
+        test.end();
+    };
+
+    test.requestor.glyphsAvailable = [&] (GlyphMap glyphs) {
+        ASSERT_TRUE(bool(glyphs.at({{"Test Stack"}}).at(u'a')));
+        test.end();
+    };
+
+    test.glyphManager.setURL("test/fixtures/resources/glyphs.pbf");
+    test.glyphManager.setObserver(&test.observer);
+    test.glyphManager.prefetchGlyphs({ { {{"Test Stack"}}, { { 0, 255 } } } });
+
+    // The failed prefetch isn't reported, and the range is requested again once it is needed.
+    util::Timer timer;
+    timer.start(Milliseconds(10), Duration::zero(), [&] {
+        EXPECT_EQ(1u, requests);
+        test.glyphManager.getGlyphs(test.requestor, GlyphDependencies { {{{"Test Stack"}}, {u'a'}} });
+    });
+
+    test.loop.run();
+
+    EXPECT_EQ(2u, requests);
+}
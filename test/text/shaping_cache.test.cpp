@@ -0,0 +1,125 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/text/bidi.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+Glyphs makeGlyphs(const std::u16string& ids) {
+    Glyphs glyphs;
+    for (char16_t id : ids) {
+        auto glyph = makeMutable<Glyph>();
+        glyph->id = id;
+        glyph->metrics.width = 10;
+        glyph->metrics.height = 12;
+        glyph->metrics.advance = 12;
+        glyphs.emplace(id, Immutable<Glyph>(std::move(glyph)));
+    }
+    return glyphs;
+}
+
+ShapingCache::Key makeKey(const std::u16string& text) {
+    return ShapingCache::Key {
+        text,
+        { "Open Sans Regular" },
+        240.0f,
+        28.8f,
+        style::SymbolAnchorType::Center,
+        style::TextJustifyType::Center,
+        0.0f,
+        { 0.0f, 0.0f },
+        24.0f,
+        WritingModeType::Horizontal
+    };
+}
+
+} // namespace
+
+TEST(ShapingCache, Hit) {
+    ShapingCache cache;
+    BiDi bidi;
+    const Glyphs glyphs = makeGlyphs(u"abc ");
+
+    const Shaping first = cache.getShaping(makeKey(u"abc cab"), bidi, glyphs);
+    const Shaping second = cache.getShaping(makeKey(u"abc cab"), bidi, glyphs);
+
+    ASSERT_EQ(7u, first.positionedGlyphs.size());
+    ASSERT_EQ(first.positionedGlyphs.size(), second.positionedGlyphs.size());
+    for (std::size_t i = 0; i < first.positionedGlyphs.size(); ++i) {
+        EXPECT_EQ(first.positionedGlyphs[i].glyph, second.positionedGlyphs[i].glyph);
+        EXPECT_EQ(first.positionedGlyphs[i].x, second.positionedGlyphs[i].x);
+        EXPECT_EQ(first.positionedGlyphs[i].y, second.positionedGlyphs[i].y);
+    }
+    EXPECT_EQ(first.left, second.left);
+    EXPECT_EQ(first.right, second.right);
+
+    const ShapingCache::Stats stats = cache.getStats();
+    EXPECT_EQ(1u, stats.entries);
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_DOUBLE_EQ(0.5, stats.hitRate());
+}
+
+TEST(ShapingCache, LayoutParameters) {
+    ShapingCache cache;
+    BiDi bidi;
+    const Glyphs glyphs = makeGlyphs(u"abc");
+
+    ShapingCache::Key key = makeKey(u"abc");
+    const Shaping centered = cache.getShaping(key, bidi, glyphs);
+
+    // Labels that differ in any of the layout parameters are shaped separately.
+    key.textAnchor = style::SymbolAnchorType::Left;
+    const Shaping left = cache.getShaping(key, bidi, glyphs);
+    EXPECT_NE(centered.left, left.left);
+
+    key.fontStack = { "Open Sans Bold" };
+    cache.getShaping(key, bidi, glyphs);
+
+    key.writingMode = WritingModeType::Vertical;
+    cache.getShaping(key, bidi, glyphs);
+
+    const ShapingCache::Stats stats = cache.getStats();
+    EXPECT_EQ(4u, stats.entries);
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(4u, stats.misses);
+}
+
+TEST(ShapingCache, Evict) {
+    ShapingCache cache(2);
+    BiDi bidi;
+    const Glyphs glyphs = makeGlyphs(u"abc");
+
+    cache.getShaping(makeKey(u"a"), bidi, glyphs);
+    cache.getShaping(makeKey(u"b"), bidi, glyphs);
+    cache.getShaping(makeKey(u"a"), bidi, glyphs);
+
+    // "b" is the least recently used shaping.
+    cache.getShaping(makeKey(u"c"), bidi, glyphs);
+    EXPECT_EQ(2u, cache.getStats().entries);
+    EXPECT_EQ(1u, cache.getStats().evictions);
+
+    cache.getShaping(makeKey(u"a"), bidi, glyphs);
+    EXPECT_EQ(2u, cache.getStats().hits);
+    cache.getShaping(makeKey(u"b"), bidi, glyphs);
+    EXPECT_EQ(2u, cache.getStats().hits);
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.getStats().entries);
+}
+
+TEST(ShapingCache, MissingGlyphs) {
+    ShapingCache cache;
+    BiDi bidi;
+
+    // "c" hasn't been loaded yet, so the shaping is incomplete and isn't cached.
+    const Shaping partial = cache.getShaping(makeKey(u"abc"), bidi, makeGlyphs(u"ab"));
+    EXPECT_EQ(2u, partial.positionedGlyphs.size());
+    EXPECT_EQ(0u, cache.getStats().entries);
+
+    const Shaping complete = cache.getShaping(makeKey(u"abc"), bidi, makeGlyphs(u"abc"));
+    EXPECT_EQ(3u, complete.positionedGlyphs.size());
+    EXPECT_EQ(1u, cache.getStats().entries);
+}
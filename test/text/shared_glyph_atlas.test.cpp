@@ -0,0 +1,159 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/shared_glyph_atlas.hpp>
+#include <mbgl/renderer/backend_scope.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/context.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+Immutable<Glyph> makeGlyph(GlyphID id, Size size = { 20, 24 }) {
+    auto glyph = makeMutable<Glyph>();
+    glyph->id = id;
+    glyph->bitmap = AlphaImage(size);
+    glyph->bitmap.fill(uint8_t(id));
+    glyph->metrics.width = size.width - 2 * Glyph::borderSize;
+    glyph->metrics.height = size.height - 2 * Glyph::borderSize;
+    glyph->metrics.advance = glyph->metrics.width;
+    return std::move(glyph);
+}
+
+GlyphMap makeGlyphMap(const FontStack& fontStack, std::initializer_list<GlyphID> ids, Size size = { 20, 24 }) {
+    GlyphMap glyphMap;
+    for (GlyphID id : ids) {
+        glyphMap[fontStack].emplace(id, makeGlyph(id, size));
+    }
+    return glyphMap;
+}
+
+const FontStack regular { "Open Sans Regular" };
+const FontStack bold { "Open Sans Bold" };
+
+} // namespace
+
+TEST(SharedGlyphAtlas, Basic) {
+    auto atlas = std::make_shared<SharedGlyphAtlas>();
+
+    GlyphMap glyphMap = makeGlyphMap(regular, { u'a', u'b' });
+    glyphMap[regular].emplace(u' ', optional<Immutable<Glyph>>());
+
+    GlyphPositions positions;
+    auto reference = atlas->addGlyphs(glyphMap, positions);
+
+    ASSERT_EQ(1u, positions.size());
+    ASSERT_EQ(2u, positions[regular].size());
+    EXPECT_EQ(0u, positions[regular].count(u' '));
+
+    const GlyphPosition& a = positions[regular].at(u'a');
+    EXPECT_EQ(0, a.rect.x);
+    EXPECT_EQ(0, a.rect.y);
+    EXPECT_EQ(22, a.rect.w);
+    EXPECT_EQ(26, a.rect.h);
+    EXPECT_EQ(14u, a.metrics.width);
+
+    // The glyph bitmap is surrounded by one pixel of transparent padding.
+    const AlphaImage image = atlas->getAtlasImage();
+    EXPECT_EQ(0, image.data[0]);
+    EXPECT_EQ(uint8_t(u'a'), image.data[image.stride() + 1]);
+
+    const SharedGlyphAtlas::Stats stats = atlas->getStats();
+    EXPECT_EQ(2u, stats.glyphs);
+    EXPECT_EQ(2u, stats.referencedGlyphs);
+    EXPECT_EQ(256u * 256u, stats.memoryBytes);
+}
+
+TEST(SharedGlyphAtlas, SharedAcrossTiles) {
+    auto atlas = std::make_shared<SharedGlyphAtlas>();
+
+    GlyphPositions positionsA;
+    auto referenceA = atlas->addGlyphs(makeGlyphMap(regular, { u'a', u'b' }), positionsA);
+
+    GlyphPositions positionsB;
+    auto referenceB = atlas->addGlyphs(makeGlyphMap(regular, { u'b', u'c' }), positionsB);
+
+    // Glyphs that are used by both tiles are only packed once.
+    EXPECT_EQ(positionsA[regular].at(u'b').rect, positionsB[regular].at(u'b').rect);
+    EXPECT_EQ(3u, atlas->getStats().glyphs);
+
+    // The same glyph ID in another font stack gets its own region.
+    GlyphPositions positionsC;
+    auto referenceC = atlas->addGlyphs(makeGlyphMap(bold, { u'a' }), positionsC);
+    EXPECT_FALSE(positionsA[regular].at(u'a').rect == positionsC[bold].at(u'a').rect);
+    EXPECT_EQ(4u, atlas->getStats().glyphs);
+
+    referenceA.reset();
+    EXPECT_EQ(3u, atlas->getStats().referencedGlyphs);
+
+    // Released glyphs stay in the atlas for tiles that are loaded later.
+    EXPECT_EQ(4u, atlas->getStats().glyphs);
+    GlyphPositions positionsD;
+    auto referenceD = atlas->addGlyphs(makeGlyphMap(regular, { u'a' }), positionsD);
+    EXPECT_EQ(positionsA[regular].at(u'a').rect, positionsD[regular].at(u'a').rect);
+    EXPECT_EQ(4u, atlas->getStats().referencedGlyphs);
+}
+
+TEST(SharedGlyphAtlas, Grow) {
+    auto atlas = std::make_shared<SharedGlyphAtlas>(Size { 32, 32 }, Size { 64, 64 });
+
+    GlyphPositions positions;
+    auto reference = atlas->addGlyphs(makeGlyphMap(regular, { u'a', u'b', u'c', u'd' }), positions);
+
+    EXPECT_EQ(4u, positions[regular].size());
+    EXPECT_EQ(64u * 64u, atlas->getStats().memoryBytes);
+    EXPECT_EQ(0u, atlas->getStats().evictedGlyphs);
+}
+
+TEST(SharedGlyphAtlas, Evict) {
+    auto atlas = std::make_shared<SharedGlyphAtlas>(Size { 64, 32 }, Size { 64, 32 });
+
+    GlyphPositions positionsA;
+    auto referenceA = atlas->addGlyphs(makeGlyphMap(regular, { u'a', u'b' }), positionsA);
+    EXPECT_EQ(2u, positionsA[regular].size());
+
+    // The atlas is full, and all glyphs are in use.
+    GlyphPositions positionsB;
+    auto referenceB = atlas->addGlyphs(makeGlyphMap(regular, { u'c' }), positionsB);
+    EXPECT_EQ(0u, positionsB[regular].size());
+
+    // Once released, the least recently released glyphs make room for new ones.
+    referenceA.reset();
+    referenceB = atlas->addGlyphs(makeGlyphMap(regular, { u'c' }), positionsB);
+    ASSERT_EQ(1u, positionsB[regular].size());
+    EXPECT_EQ(positionsA[regular].at(u'a').rect, positionsB[regular].at(u'c').rect);
+
+    const SharedGlyphAtlas::Stats stats = atlas->getStats();
+    EXPECT_EQ(2u, stats.glyphs);
+    EXPECT_EQ(1u, stats.referencedGlyphs);
+    EXPECT_EQ(1u, stats.evictedGlyphs);
+
+    const AlphaImage image = atlas->getAtlasImage();
+    EXPECT_EQ(uint8_t(u'c'), image.data[image.stride() + 1]);
+}
+
+TEST(SharedGlyphAtlas, Upload) {
+    HeadlessBackend backend { { 256, 256 } };
+    BackendScope scope { backend };
+    gl::Context context;
+
+    auto atlas = std::make_shared<SharedGlyphAtlas>();
+
+    GlyphPositions positionsA;
+    auto referenceA = atlas->addGlyphs(makeGlyphMap(regular, { u'a' }), positionsA);
+
+    // The first upload transfers the entire texture.
+    atlas->upload(context, 0);
+    EXPECT_EQ(256u * 256u, atlas->getStats().uploadedBytes);
+    EXPECT_EQ((Size { 256, 256 }), atlas->bind(context, 0));
+
+    // Nothing changed.
+    atlas->upload(context, 0);
+    EXPECT_EQ(256u * 256u, atlas->getStats().uploadedBytes);
+
+    // Only the regions of new glyphs are uploaded afterwards.
+    GlyphPositions positionsB;
+    auto referenceB = atlas->addGlyphs(makeGlyphMap(regular, { u'a', u'b', u'c' }), positionsB);
+    atlas->upload(context, 0);
+    EXPECT_EQ(256u * 256u + 2u * 22u * 26u, atlas->getStats().uploadedBytes);
+}
@@ -0,0 +1,44 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/tiny_sdf.hpp>
+
+using namespace mbgl;
+
+TEST(TinySDF, Square) {
+    AlphaImage raster({ 32, 32 });
+    for (uint32_t y = 8; y < 24; y++) {
+        for (uint32_t x = 8; x < 24; x++) {
+            raster.data[y * 32 + x] = 255;
+        }
+    }
+
+    const AlphaImage sdf = util::transformRasterToSDF(raster, 8, 0.25);
+    ASSERT_EQ(raster.size, sdf.size);
+
+    auto at = [&] (uint32_t x, uint32_t y) {
+        return sdf.data[y * 32 + x];
+    };
+
+    // Deep inside the shape, the field saturates.
+    EXPECT_EQ(255u, at(16, 16));
+
+    // Pixels just inside of the edge encode a distance of one pixel.
+    EXPECT_EQ(223u, at(8, 16));
+    EXPECT_EQ(223u, at(16, 23));
+
+    // Pixels just outside of the edge stay above the value that glyphs are drawn with.
+    EXPECT_EQ(159u, at(7, 16));
+    EXPECT_GT(at(7, 16), 255 * 0.5);
+
+    // Far from the shape, the field saturates again.
+    EXPECT_EQ(0u, at(0, 0));
+
+    // The field decreases monotonically away from the shape.
+    for (uint32_t x = 1; x <= 16; x++) {
+        EXPECT_LE(at(x - 1, 16), at(x, 16));
+    }
+}
+
+TEST(TinySDF, Empty) {
+    EXPECT_FALSE(util::transformRasterToSDF(AlphaImage(), 8, 0.25).valid());
+}
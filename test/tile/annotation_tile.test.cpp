@@ -31,7 +31,7 @@ public:
     HeadlessBackend backend;
     BackendScope scope { backend };
     ImageManager imageManager;
-    GlyphManager glyphManager { fileSource };
+    GlyphManager glyphManager { fileSource, threadPool };
 
     TileParameters tileParameters {
         1.0,
@@ -74,6 +74,8 @@ TEST(AnnotationTile, Issue8289) {
         std::move(collisionTile),
         {},
         {},
+        {},
+        {},
     }, 0);
 
     // Simulate a second layout with empty data.
@@ -93,3 +95,54 @@ TEST(AnnotationTile, Issue8289) {
     EXPECT_TRUE(result.empty());
 }
 
+// Simulates placement of the data that a tile was given when it was added.
+static void placeInitialData(AnnotationTile& tile) {
+    tile.onPlacement(GeometryTile::PlacementResult {
+        std::unordered_map<std::string, std::shared_ptr<Bucket>>(),
+        nullptr,
+        {},
+        {},
+        {},
+        {},
+    }, 1);
+}
+
+TEST(AnnotationTile, UpdateRegeneratesOnlyAffectedTiles) {
+    AnnotationTileTest test;
+    AnnotationTile northwest(OverscaledTileID(1, 0, 0), test.tileParameters);
+    AnnotationTile southeast(OverscaledTileID(1, 1, 1), test.tileParameters);
+
+    placeInitialData(northwest);
+    placeInitialData(southeast);
+    ASSERT_TRUE(northwest.isComplete());
+    ASSERT_TRUE(southeast.isComplete());
+
+    // A tile is only marked as pending again if it was given new data.
+    test.annotationManager.addAnnotation(SymbolAnnotation { Point<double> { -90, 45 }, "default_marker" }, 16);
+    test.annotationManager.updateData();
+    EXPECT_FALSE(northwest.isComplete());
+    EXPECT_TRUE(southeast.isComplete());
+}
+
+TEST(AnnotationTile, BatchRegeneratesOnlyAffectedTiles) {
+    AnnotationTileTest test;
+    AnnotationTile northwest(OverscaledTileID(2, 0, 0), test.tileParameters);
+    AnnotationTile northeast(OverscaledTileID(2, 3, 0), test.tileParameters);
+    AnnotationTile southeast(OverscaledTileID(2, 3, 3), test.tileParameters);
+    placeInitialData(northwest);
+    placeInitialData(northeast);
+    placeInitialData(southeast);
+    ASSERT_TRUE(northwest.isComplete());
+    ASSERT_TRUE(northeast.isComplete());
+    ASSERT_TRUE(southeast.isComplete());
+
+    // A box around both symbols would cover the northeast tile as well.
+    test.annotationManager.addAnnotations({
+        SymbolAnnotation { Point<double> { -160, 80 }, "default_marker" },
+        SymbolAnnotation { Point<double> { 160, -80 }, "default_marker" },
+    }, 16);
+    test.annotationManager.updateData();
+    EXPECT_FALSE(northwest.isComplete());
+    EXPECT_TRUE(northeast.isComplete());
+    EXPECT_FALSE(southeast.isComplete());
+}
@@ -28,7 +28,7 @@ public:
     style::Style style { loop, fileSource, 1 };
     AnnotationManager annotationManager { style };
     ImageManager imageManager;
-    GlyphManager glyphManager { fileSource };
+    GlyphManager glyphManager { fileSource, threadPool };
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     TileParameters tileParameters {
@@ -115,3 +115,54 @@ TEST(GeoJSONTile, Issue9927) {
     ASSERT_TRUE(tile.isRenderable());
     ASSERT_NE(nullptr, tile.getBucket(*layer.baseImpl));
  }
+
+TEST(GeoJSONTile, PlacementWhileCameraIsChanging) {
+    GeoJSONTileTest test;
+
+    CircleLayer layer("circle", "source");
+
+    mapbox::geometry::feature_collection<int16_t> features;
+    features.push_back(mapbox::geometry::feature<int16_t> {
+        mapbox::geometry::point<int16_t>(0, 0)
+    });
+
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, features);
+
+    tile.setLayers({{ layer.baseImpl }});
+    tile.setPlacementConfig({});
+
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    // The current placement is kept for small rotations while the camera is changing.
+    tile.setPlacementConfig(PlacementConfig(0.5 * util::DEG2RAD), true);
+    EXPECT_TRUE(tile.isComplete());
+
+    // Larger rotations are placed again, but only once the previous placement is done.
+    tile.setPlacementConfig(PlacementConfig(10 * util::DEG2RAD), true);
+    EXPECT_FALSE(tile.isComplete());
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    tile.setPlacementConfig(PlacementConfig(20 * util::DEG2RAD), true);
+    tile.setPlacementConfig(PlacementConfig(30 * util::DEG2RAD), true);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    // Still at 20°, so the next frame places again.
+    tile.setPlacementConfig(PlacementConfig(30 * util::DEG2RAD), true);
+    EXPECT_FALSE(tile.isComplete());
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    // Once the camera stops, symbols are placed for the exact config.
+    tile.setPlacementConfig(PlacementConfig(30.5 * util::DEG2RAD), false);
+    EXPECT_FALSE(tile.isComplete());
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+}
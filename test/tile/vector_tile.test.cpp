@@ -30,7 +30,7 @@ public:
     style::Style style { loop, fileSource, 1 };
     AnnotationManager annotationManager { style };
     ImageManager imageManager;
-    GlyphManager glyphManager { fileSource };
+    GlyphManager glyphManager { fileSource, threadPool };
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     TileParameters tileParameters {
@@ -87,6 +87,8 @@ TEST(VectorTile, Issue7615) {
         nullptr,
         {},
         {},
+        {},
+        {},
     }, 0);
 
     // Subsequent onLayout should not cause the existing symbol bucket to be discarded.
@@ -0,0 +1,113 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/util/grid_index.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+using BBox = GridIndex<IndexedSubfeature>::BBox;
+
+bool intersects(const BBox& a, const BBox& b) {
+    return a.min.x <= b.max.x && a.min.y <= b.max.y && a.max.x >= b.min.x && a.max.y >= b.min.y;
+}
+
+BBox randomBox(std::minstd_rand& random) {
+    std::uniform_int_distribution<int16_t> position(-1000, 9000);
+    std::uniform_int_distribution<int16_t> size(0, 2000);
+    const int16_t x = position(random);
+    const int16_t y = position(random);
+    return { { x, y }, { int16_t(x + size(random)), int16_t(y + size(random)) } };
+}
+
+} // namespace
+
+TEST(GridIndex, QueryMatchesBruteForce) {
+    std::minstd_rand random(3);
+
+    GridIndex<IndexedSubfeature> grid(8192, 16, 0);
+    std::vector<BBox> boxes;
+    for (std::size_t i = 0; i < 500; ++i) {
+        boxes.push_back(randomBox(random));
+        grid.insert(IndexedSubfeature { i, "layer", "bucket", i }, boxes.back());
+    }
+    grid.finish();
+
+    for (std::size_t q = 0; q < 100; ++q) {
+        const BBox query = randomBox(random);
+
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            if (intersects(query, boxes[i])) {
+                expected.push_back(i);
+            }
+        }
+
+        // Each intersecting element is reported exactly once.
+        std::vector<std::size_t> actual;
+        EXPECT_TRUE(grid.query(query, [&] (const IndexedSubfeature& feature) {
+            actual.push_back(feature.index);
+            return true;
+        }));
+        std::sort(actual.begin(), actual.end());
+
+        EXPECT_EQ(expected, actual);
+    }
+}
+
+TEST(GridIndex, QueryStopsEarly) {
+    GridIndex<IndexedSubfeature> grid(8192, 16, 0);
+    for (std::size_t i = 0; i < 10; ++i) {
+        grid.insert(IndexedSubfeature { i, "layer", "bucket", i }, { { 100, 100 }, { 200, 200 } });
+    }
+    grid.finish();
+
+    std::size_t visited = 0;
+    EXPECT_FALSE(grid.query({ { 0, 0 }, { 8192, 8192 } }, [&] (const IndexedSubfeature&) {
+        return ++visited < 3;
+    }));
+    EXPECT_EQ(3u, visited);
+}
+
+TEST(GridIndex, UnfinishedGridIsEmpty) {
+    GridIndex<IndexedSubfeature> grid(8192, 16, 0);
+    const BBox query { { 0, 0 }, { 8192, 8192 } };
+
+    std::size_t count = 0;
+    auto visitor = [&] (const IndexedSubfeature&) { ++count; return true; };
+
+    EXPECT_TRUE(grid.query(query, visitor));
+    EXPECT_EQ(0u, count);
+
+    grid.insert(IndexedSubfeature { 0, "layer", "bucket", 0 }, { { 10, 10 }, { 20, 20 } });
+    EXPECT_TRUE(grid.query(query, visitor));
+    EXPECT_EQ(0u, count);
+
+    grid.finish();
+    EXPECT_TRUE(grid.query(query, visitor));
+    EXPECT_EQ(1u, count);
+}
+
+TEST(GridIndex, QueryWithBoxes) {
+    GridIndex<IndexedSubfeature> grid(8192, 16, 0);
+    grid.insert(IndexedSubfeature { 0, "layer", "bucket", 0 }, { { 10, 10 }, { 20, 20 } });
+    grid.insert(IndexedSubfeature { 1, "layer", "bucket", 1 }, { { 1000, 1000 }, { 3000, 3000 } });
+    grid.finish();
+
+    std::vector<std::pair<std::size_t, BBox>> result;
+    EXPECT_TRUE(grid.queryWithBoxes({ { 0, 0 }, { 1500, 1500 } }, [&] (const IndexedSubfeature& feature, const BBox& box) {
+        result.emplace_back(feature.index, box);
+        return true;
+    }));
+
+    ASSERT_EQ(2u, result.size());
+    std::sort(result.begin(), result.end(), [] (const auto& a, const auto& b) { return a.first < b.first; });
+    EXPECT_EQ(0u, result[0].first);
+    EXPECT_EQ(BBox({ { 10, 10 }, { 20, 20 } }), result[0].second);
+    EXPECT_EQ(1u, result[1].first);
+    EXPECT_EQ(BBox({ { 1000, 1000 }, { 3000, 3000 } }), result[1].second);
+}
@@ -0,0 +1,72 @@
+#include <mbgl/util/parallel.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/actor/actor.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace mbgl;
+
+namespace {
+
+std::vector<std::function<void()>> countingJobs(std::vector<std::atomic<int>>& counts) {
+    std::vector<std::function<void()>> jobs;
+    for (auto& count : counts) {
+        jobs.push_back([&count] {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            count++;
+        });
+    }
+    return jobs;
+}
+
+class Blocker {
+public:
+    void block(std::shared_future<void> unblocked) {
+        unblocked.wait();
+    }
+};
+
+} // namespace
+
+TEST(Parallel, RunsEveryJobOnce) {
+    ThreadPool threadPool(4);
+
+    for (const std::size_t helpers : { 0, 1, 3, 8 }) {
+        std::vector<std::atomic<int>> counts(200);
+        auto jobs = countingJobs(counts);
+        util::runInParallel(threadPool, jobs, helpers);
+
+        for (const auto& count : counts) {
+            EXPECT_EQ(1, count);
+        }
+    }
+}
+
+TEST(Parallel, BusyScheduler) {
+    ThreadPool threadPool(1);
+
+    // The only worker thread is blocked, so the calling thread runs all jobs by itself.
+    std::promise<void> unblock;
+    Actor<Blocker> blocker(threadPool);
+    blocker.invoke(&Blocker::block, unblock.get_future().share());
+
+    std::vector<std::atomic<int>> counts(20);
+    auto jobs = countingJobs(counts);
+    util::runInParallel(threadPool, jobs, 3);
+    for (const auto& count : counts) {
+        EXPECT_EQ(1, count);
+    }
+
+    unblock.set_value();
+}
+
+TEST(Parallel, NoJobs) {
+    ThreadPool threadPool(1);
+    std::vector<std::function<void()>> jobs;
+    util::runInParallel(threadPool, jobs, 3);
+}
@@ -0,0 +1,60 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/shared_buffer.hpp>
+
+using namespace mbgl;
+
+TEST(SharedBuffer, Null) {
+    SharedBuffer buffer;
+    EXPECT_FALSE(bool(buffer));
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ("", buffer.string());
+
+    SharedBuffer empty(std::make_shared<std::string>());
+    EXPECT_TRUE(bool(empty));
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST(SharedBuffer, AdoptsString) {
+    auto string = std::make_shared<const std::string>("hello world");
+    SharedBuffer buffer(string);
+
+    // The buffer refers to the string's storage instead of copying it.
+    EXPECT_EQ(string->data(), buffer.data());
+    EXPECT_EQ(11u, buffer.size());
+    EXPECT_EQ(2, string.use_count());
+
+    SharedBuffer copy = buffer;
+    EXPECT_EQ(buffer, copy);
+    EXPECT_EQ(3, string.use_count());
+}
+
+TEST(SharedBuffer, Slice) {
+    SharedBuffer buffer(std::make_shared<std::string>("hello world"));
+
+    SharedBuffer world = buffer.slice(6);
+    EXPECT_EQ(buffer.data() + 6, world.data());
+    EXPECT_EQ("world", world.string());
+    EXPECT_EQ("lo", buffer.slice(3, 2).string());
+
+    // Out of range slices are clamped.
+    EXPECT_EQ("world", buffer.slice(6, 100).string());
+    EXPECT_TRUE(buffer.slice(100).empty());
+    EXPECT_TRUE(bool(buffer.slice(100)));
+}
+
+TEST(SharedBuffer, Deleter) {
+    static const char bytes[] = "external";
+    bool deleted = false;
+    {
+        SharedBuffer buffer(bytes, 8, [&](const char* data) {
+            EXPECT_EQ(bytes, data);
+            deleted = true;
+        });
+        SharedBuffer slice = buffer.slice(1);
+        buffer = {};
+        EXPECT_FALSE(deleted);
+        EXPECT_EQ("xternal", slice.string());
+    }
+    EXPECT_TRUE(deleted);
+}